@@ -318,6 +318,50 @@ int ml_train_model_insert_layer(ml_train_model_h model, ml_train_layer_h layer,
                                 const char *input_layer_names[],
                                 const char *output_layer_names[]);
 
+/**
+ * @brief Start an inference session of the neural network model.
+ * @details Use this function to keep the memory for the inference allocated
+ * across the calls of ml_train_model_run_inference(). The memory is planned
+ * once for a batch size and re-planned only when the batch size changes.
+ * @since_tizen 6.x
+ * @param[in] model The NNTrainer model handler, which must be compiled.
+ * @return @c 0 on success. Otherwise a negative error value.
+ * @retval #ML_ERROR_NONE Successful.
+ * @retval #ML_ERROR_INVALID_PARAMETER Invalid Parameter.
+ */
+int ml_train_model_start_inference_session(ml_train_model_h model);
+
+/**
+ * @brief Run the inference of the neural network model.
+ * @details Without a started inference session, the memory for the inference
+ * is planned and allocated on every call.
+ * @since_tizen 6.x
+ * @param[in] model The NNTrainer model handler, which must be compiled.
+ * @param[in] batch_size Batch size of the given input.
+ * @param[in] input List of input data, one for each input of the model.
+ * @param[out] output List to be filled with the output data, one for each
+ * output of the model. The output must not be freed by the caller and stays
+ * valid until the next inference or until the session is stopped.
+ * @return @c 0 on success. Otherwise a negative error value.
+ * @retval #ML_ERROR_NONE Successful.
+ * @retval #ML_ERROR_INVALID_PARAMETER Invalid Parameter.
+ */
+int ml_train_model_run_inference(ml_train_model_h model,
+                                 unsigned int batch_size, float *input[],
+                                 float *output[]);
+
+/**
+ * @brief Stop the inference session of the neural network model.
+ * @details Use this function to release the memory kept for the inference.
+ * The weights of the model are not released.
+ * @since_tizen 6.x
+ * @param[in] model The NNTrainer model handler.
+ * @return @c 0 on success. Otherwise a negative error value.
+ * @retval #ML_ERROR_NONE Successful.
+ * @retval #ML_ERROR_INVALID_PARAMETER Invalid Parameter.
+ */
+int ml_train_model_stop_inference_session(ml_train_model_h model);
+
 #if defined(__TIZEN__)
 /**
  * @brief Checks whether machine_learning.training feature is enabled or not.
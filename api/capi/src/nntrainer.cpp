@@ -22,6 +22,7 @@
  * @bug No known bugs except for NYI items
  */
 
+#include <algorithm>
 #include <array>
 #include <cstdarg>
 #include <cstring>
@@ -1170,6 +1171,81 @@ int ml_train_model_load(ml_train_model_h model, const char *file_path,
   return status;
 }
 
+int ml_train_model_start_inference_session(ml_train_model_h model) {
+  int status = ML_ERROR_NONE;
+  ml_train_model *nnmodel;
+  std::shared_ptr<ml::train::Model> m;
+
+  check_feature_state();
+
+  {
+    ML_TRAIN_GET_VALID_MODEL_LOCKED(nnmodel, model);
+    ML_TRAIN_ADOPT_LOCK(nnmodel, model_lock);
+
+    m = nnmodel->model;
+  }
+
+  returnable f = [&]() { return m->startInferenceSession(); };
+
+  status = nntrainer_exception_boundary(f);
+  return status;
+}
+
+int ml_train_model_run_inference(ml_train_model_h model,
+                                 unsigned int batch_size, float *input[],
+                                 float *output[]) {
+  int status = ML_ERROR_NONE;
+  ml_train_model *nnmodel;
+  std::shared_ptr<ml::train::Model> m;
+
+  check_feature_state();
+
+  if (batch_size == 0 || !input || !output) {
+    ml_loge("Error: invalid parameter, batch size must be positive and input "
+            "and output must not be null");
+    return ML_ERROR_INVALID_PARAMETER;
+  }
+
+  {
+    ML_TRAIN_GET_VALID_MODEL_LOCKED(nnmodel, model);
+    ML_TRAIN_ADOPT_LOCK(nnmodel, model_lock);
+
+    m = nnmodel->model;
+  }
+
+  returnable f = [&]() {
+    std::vector<float *> inputs(input, input + m->getInputDimension().size());
+    std::vector<float *> labels;
+
+    auto outputs = m->inference(batch_size, inputs, labels);
+    std::copy(outputs.begin(), outputs.end(), output);
+    return ML_ERROR_NONE;
+  };
+
+  status = nntrainer_exception_boundary(f);
+  return status;
+}
+
+int ml_train_model_stop_inference_session(ml_train_model_h model) {
+  int status = ML_ERROR_NONE;
+  ml_train_model *nnmodel;
+  std::shared_ptr<ml::train::Model> m;
+
+  check_feature_state();
+
+  {
+    ML_TRAIN_GET_VALID_MODEL_LOCKED(nnmodel, model);
+    ML_TRAIN_ADOPT_LOCK(nnmodel, model_lock);
+
+    m = nnmodel->model;
+  }
+
+  returnable f = [&]() { return m->stopInferenceSession(); };
+
+  status = nntrainer_exception_boundary(f);
+  return status;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -62,6 +62,10 @@ for inference and training without any configurations*/
   MODEL_FORMAT_INI_WITH_BIN =
     ML_TRAIN_MODEL_FORMAT_INI_WITH_BIN, /**< ini file with save_path defined
                                            where the binaray will be saved */
+  MODEL_FORMAT_MMAP =
+    ML_TRAIN_MODEL_FORMAT_MMAP, /**< aligned bin file with an offset table of
+                                   the weights, mapped to the memory without
+                                   copying when loaded */
 };
 
 /**
@@ -232,6 +236,56 @@ public:
                                          std::vector<float *> &input,
                                          std::vector<float *> &label) = 0;
 
+  /**
+   * @brief     Start an inference session. Within a session, the memory for
+   * the inference is planned and allocated once for the given batch size and
+   * reused across the calls of @a inference(). The memory is re-planned only
+   * when the batch size changes.
+   * @retval #ML_ERROR_NONE Successful.
+   * @retval #ML_ERROR_INVALID_PARAMETER model is not initialized.
+   * @note The output of @a inference() stays valid until the next call of
+   * @a inference() or @a stopInferenceSession().
+   */
+  virtual int startInferenceSession() = 0;
+
+  /**
+   * @brief     Stop the inference session and release the memory kept for the
+   * inference. The weights of the model are not released.
+   * @retval #ML_ERROR_NONE Successful.
+   */
+  virtual int stopInferenceSession() = 0;
+
+  /**
+   * @brief     Create an execution context to run the inference of this model.
+   * The context shares the weights of this model but has its own memory for
+   * the activations, so that each context can run the inference concurrently
+   * on a different thread.
+   * @retval    Model to run the inference with
+   * @throw     std::invalid_argument if the model is not initialized
+   * @note      The weights are shared without a copy. This model must outlive
+   * the contexts and must not deallocate or update its weights while the
+   * contexts run the inference.
+   */
+  virtual std::unique_ptr<Model> createInferenceContext() = 0;
+
+  /**
+   * @brief     Quantize the weights of the layers supporting int8 to run the
+   * inference in int8. The scale of the input of each of those layers is
+   * calibrated by running the inference over the given dataset.
+   * @param[in] calibration_set dataset to calibrate the range of the inputs
+   * @retval #ML_ERROR_NONE Successful.
+   * @retval #ML_ERROR_INVALID_PARAMETER model is not initialized or the
+   * dataset is not given.
+   * @note      Layers not supporting int8 keep running in fp32, so the
+   * quantized layers take and give fp32 at their boundaries. The int8 weights
+   * replace the fp32 weights in place, so the quantized model can not be
+   * trained any more, and it is saved and loaded with the int8 weights. The
+   * quantized layers get the property quantized=true, which a model loading
+   * the saved weights must have as well. Inference contexts must be created
+   * after quantizing.
+   */
+  virtual int quantize(std::shared_ptr<Dataset> calibration_set) = 0;
+
   /**
    * @brief     Summarize the model
    * @param out std::ostream to get the model summary
@@ -220,8 +220,12 @@ typedef enum {
   ML_TRAIN_MODEL_FORMAT_INI =
     1, /**< Ini format file saves model configurations. */
   ML_TRAIN_MODEL_FORMAT_INI_WITH_BIN =
-    2 /**< Ini with bin format file saves configurations with parameters
+    2, /**< Ini with bin format file saves configurations with parameters
          required for inference and training. */
+  ML_TRAIN_MODEL_FORMAT_MMAP =
+    3 /**< Aligned bin file with an offset table of the model weights. Loading
+         maps the file to the memory and uses it for the weights without
+         copying. */
 } ml_train_model_format_e;
 
 /**
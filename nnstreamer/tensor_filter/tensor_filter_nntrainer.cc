@@ -92,6 +92,8 @@ NNTrainerInference::NNTrainerInference(const std::string &model_config_) :
   loadModel();
   model->compile();
   model->initialize();
+  /** keep the memory for inference across the frames */
+  model->startInferenceSession();
 }
 
 const char *NNTrainerInference::getModelConfig() {
@@ -53,6 +53,11 @@ ActivationRealizer::realize(const GraphRepresentation &reference) {
         createLayerNode("activation", {"name=" + layer_name,
                                        "activation=" + to_string(act_prop)});
       act_node->setProperty({"input_layers=" + node->getName()});
+      /// the activated output is the one to be kept as a checkpoint
+      if (node->getCheckpoint()) {
+        node->setProperty({"checkpoint=false"});
+        act_node->setProperty({"checkpoint=true"});
+      }
       processed.push_back(std::move(act_node));
     }
   }
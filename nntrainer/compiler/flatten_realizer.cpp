@@ -34,6 +34,10 @@ FlattenRealizer::realize(const GraphRepresentation &reference) {
       node->setProperty({"flatten=false"});
       node->setProperty({"name=" + layer_name + "/flatten_realized"});
       flatten_node->setProperty({"input_layers=" + node->getName()});
+      if (node->getCheckpoint()) {
+        node->setProperty({"checkpoint=false"});
+        flatten_node->setProperty({"checkpoint=true"});
+      }
       processed.push_back(std::move(flatten_node));
     }
   }
@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file fusion_realizer.cpp
+ * @date 17 October 2026
+ * @brief NNTrainer graph realizer which fuses batch normalization and
+ * activation into the preceding conv2d and fully connected layer for inference
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @bug No known bugs except for NYI items
+ */
+#include <fusion_realizer.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <activation_layer.h>
+#include <bn_layer.h>
+#include <conv2d_layer.h>
+#include <fc_layer.h>
+#include <fusion_kernels.h>
+#include <layer_node.h>
+#include <node_exporter.h>
+
+namespace nntrainer {
+
+namespace {
+
+/**
+ * @brief get a property of the node as string
+ *
+ * @param node node to get the property from
+ * @param key key of the property
+ * @return std::string value of the property, empty if not set
+ */
+std::string getProperty(const LayerNode &node, const std::string &key) {
+  Exporter e;
+  node.exportTo(e, ExportMethods::METHOD_STRINGVECTOR);
+  auto props = e.getResult<ExportMethods::METHOD_STRINGVECTOR>();
+  for (auto &[k, v] : *props) {
+    if (k == key) {
+      return v;
+    }
+  }
+  return "";
+}
+
+/**
+ * @brief check if the batch normalization normalizes the output channels of
+ * the node so that it can be folded
+ *
+ * @param node conv2d or fully connected node
+ * @param bn batch normalization node taking the output of the node
+ * @retval true if the batch normalization can be folded
+ */
+bool canFoldBatchNorm(const LayerNode &node, const LayerNode &bn) {
+  /// batch normalization must come before the activation of the node
+  if (node.getActivationToBeRealized() != ActivationType::ACT_NONE) {
+    return false;
+  }
+
+  std::string axis = getProperty(bn, "axis");
+  if (node.getType() == Conv2DLayer::type) {
+    /// a single filter leaves the channel 1, normalized along the width then
+    return axis.empty() ? getProperty(node, "filters") != "1" : axis == "1";
+  }
+
+  return axis.empty() || axis == "3";
+}
+
+} // namespace
+
+FusionRealizer::~FusionRealizer() {}
+
+GraphRepresentation
+FusionRealizer::realize(const GraphRepresentation &reference) {
+  std::unordered_map<std::string, unsigned int> num_consumers;
+  std::unordered_map<std::string, std::shared_ptr<LayerNode>> consumers;
+  for (auto &node : reference) {
+    for (auto &name : node->getInputLayers()) {
+      num_consumers[name]++;
+      consumers[name] = node;
+    }
+  }
+
+  /// returns the node taking the output of the given node if it is the only
+  /// one and takes nothing else
+  auto sole_consumer = [&num_consumers, &consumers](const LayerNode &node) {
+    std::shared_ptr<LayerNode> consumer;
+    auto name = node.getName();
+    if (num_consumers[name] == 1 &&
+        consumers[name]->getNumInputConnections() == 1) {
+      consumer = consumers[name];
+    }
+    return consumer;
+  };
+
+  std::unordered_map<std::string, std::string> fused_to;
+  std::unordered_set<const LayerNode *> fused;
+
+  auto fuse = [&fused_to, &fused](LayerNode &node, const LayerNode &other) {
+    fused_to[other.getName()] = node.getName();
+    fused.insert(&other);
+    /// the output of the fused node is the one to be kept as a checkpoint
+    if (other.getCheckpoint()) {
+      node.setProperty({"checkpoint=true"});
+    }
+  };
+
+  for (auto &node : reference) {
+    auto type = node->getType();
+    if (fused.count(node.get()) ||
+        (type != Conv2DLayer::type && type != FullyConnectedLayer::type)) {
+      continue;
+    }
+
+    auto next = sole_consumer(*node);
+    if (next && next->getType() == BatchNormalizationLayer::type &&
+        canFoldBatchNorm(*node, *next)) {
+      node->setProperty({"fused_batch_norm=true"});
+      if (auto epsilon = getProperty(*next, "epsilon"); !epsilon.empty()) {
+        node->setProperty({"epsilon=" + epsilon});
+      }
+
+      /// the activation of the batch normalization now follows the node
+      if (auto act = next->getActivationToBeRealized();
+          act != ActivationType::ACT_NONE) {
+        props::Activation act_prop;
+        act_prop.set(act);
+        node->setProperty({"activation=" + to_string(act_prop)});
+      }
+
+      fuse(*node, *next);
+      next = sole_consumer(*next);
+    }
+
+    auto act = node->getActivationToBeRealized();
+    if (act == ActivationType::ACT_NONE && next &&
+        next->getType() == ActivationLayer::type &&
+        isFusableActivation(next->getActivationType())) {
+      act = next->getActivationType();
+      fuse(*node, *next);
+    }
+
+    if (isFusableActivation(act)) {
+      props::FusedActivation act_prop;
+      act_prop.set(act);
+      node->setProperty(
+        {"activation=none", "fused_activation=" + to_string(act_prop)});
+    }
+  }
+
+  GraphRepresentation processed;
+  processed.reserve(reference.size() - fused.size());
+
+  for (auto &node : reference) {
+    if (fused.count(node.get())) {
+      continue;
+    }
+
+    node->remapConnections([&fused_to](std::string &name, unsigned &) {
+      if (auto iter = fused_to.find(name); iter != fused_to.end()) {
+        name = iter->second;
+      }
+    });
+    processed.push_back(node);
+  }
+
+  return processed;
+}
+
+} // namespace nntrainer
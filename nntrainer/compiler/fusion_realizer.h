@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file fusion_realizer.h
+ * @date 17 October 2026
+ * @brief NNTrainer graph realizer which fuses batch normalization and
+ * activation into the preceding conv2d and fully connected layer for inference
+ * @see	https://github.com/nnstreamer/nntrainer
+ * @bug No known bugs except for NYI items
+ */
+#ifndef __FUSION_REALIZER_H__
+#define __FUSION_REALIZER_H__
+
+#include <memory>
+#include <vector>
+
+#include <realizer.h>
+
+namespace nntrainer {
+
+/**
+ * @brief Graph realizer which fuses layers for inference
+ * @details a batch normalization layer taking the sole output of a conv2d or
+ * fully connected layer is removed and folded into that layer. An element-wise
+ * activation of the layer, or an activation layer taking its sole output, is
+ * applied together with the bias instead of being realized to a separate node.
+ * @note this must come before the ActivationRealizer
+ *
+ */
+class FusionRealizer final : public GraphRealizer {
+public:
+  /**
+   * @brief Destroy the Graph Realizer object
+   *
+   */
+  ~FusionRealizer();
+
+  /**
+   * @brief graph realizer creates a new graph based on the reference
+   *
+   */
+  GraphRepresentation realize(const GraphRepresentation &reference) override;
+};
+
+} // namespace nntrainer
+
+#endif // __FUSION_REALIZER_H__
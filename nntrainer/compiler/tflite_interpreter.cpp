@@ -12,6 +12,8 @@
 #include <tflite_interpreter.h>
 
 #include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <fstream>
 #include <memory>
 #include <string>
@@ -23,6 +25,8 @@
 
 #include <fc_layer.h>
 #include <layer_node.h>
+#include <manager.h>
+#include <network_graph.h>
 #include <nntrainer_error.h>
 #include <node_exporter.h>
 #include <tensor.h>
@@ -426,6 +430,129 @@ buildSubGraphs(const TfOpNodes &nodes, const TfOpIdxMap &map,
   return fbb.CreateVector(subgraphs);
 }
 
+/**
+ * @brief get the builtin operator of an operator code
+ * @note files from older converters only fill deprecated_builtin_code
+ *
+ * @param code operator code
+ * @return tflite::BuiltinOperator builtin operator
+ */
+tflite::BuiltinOperator getBuiltinCode(const tflite::OperatorCode *code) {
+  return std::max(
+    code->builtin_code(),
+    static_cast<tflite::BuiltinOperator>(code->deprecated_builtin_code()));
+}
+
+/**
+ * @brief convert tflite (NHWC) shape to nntrainer dimension string (C:H:W)
+ *
+ * @param shape tflite shape including batch
+ * @return std::string dimension string without batch
+ */
+std::string toDimString(const std::vector<int> &shape) {
+  NNTR_THROW_IF(shape.empty() || shape.size() > 4, std::invalid_argument)
+    << FUNC_TAG << "unsupported rank of a tensor: " << shape.size();
+
+  int c = 1, h = 1, w = 1;
+  switch (shape.size()) {
+  case 4:
+    c = shape[3];
+    h = shape[1];
+    w = shape[2];
+    break;
+  case 3:
+    h = shape[1];
+    w = shape[2];
+    break;
+  case 2:
+    w = shape[1];
+    break;
+  default:
+    w = shape[0];
+    break;
+  }
+
+  return std::to_string(c) + ":" + std::to_string(h) + ":" + std::to_string(w);
+}
+
+/**
+ * @brief convert tflite axis to nntrainer axis
+ *
+ * @param axis axis of tflite, can be negative
+ * @param rank rank of the tensor
+ * @return unsigned int axis of nntrainer
+ */
+unsigned int toAxis(int axis, size_t rank) {
+  if (axis < 0) {
+    axis += rank;
+  }
+
+  NNTR_THROW_IF(axis <= 0 || axis >= static_cast<int>(rank) || rank > 4,
+                std::invalid_argument)
+    << FUNC_TAG << "unsupported axis: " << axis << " for rank: " << rank;
+
+  if (rank == 4) {
+    /// N, H, W, C -> N, C, H, W
+    static constexpr unsigned int nhwc2nchw[] = {0, 2, 3, 1};
+    return nhwc2nchw[axis];
+  }
+
+  return axis + 4 - rank;
+}
+
+/**
+ * @brief convert fused activation to nntrainer activation
+ *
+ * @param type fused activation
+ * @return std::string activation, empty if there is none
+ */
+std::string toActivation(tflite::ActivationFunctionType type) {
+  switch (type) {
+  case tflite::ActivationFunctionType_NONE:
+    return "";
+  case tflite::ActivationFunctionType_RELU:
+    return "relu";
+  case tflite::ActivationFunctionType_TANH:
+    return "tanh";
+  default:
+    throw std::invalid_argument(
+      std::string(FUNC_TAG) + "unsupported fused activation: " +
+      tflite::EnumNameActivationFunctionType(type));
+  }
+}
+
+/**
+ * @brief convert tflite padding to nntrainer padding
+ *
+ * @param padding tflite padding
+ * @return std::string padding of nntrainer
+ */
+std::string toPadding(tflite::Padding padding) {
+  return padding == tflite::Padding_SAME ? "same" : "valid";
+}
+
+/**
+ * @brief make a layer name out of a tensor name
+ *
+ * @param tensor_name name of the tensor
+ * @return std::string name that can be used as a layer name, empty if nothing
+ * is left
+ */
+std::string toLayerName(const std::string &tensor_name) {
+  std::string name;
+  name.reserve(tensor_name.size());
+
+  for (char c : tensor_name) {
+    if (std::isalnum(static_cast<unsigned char>(c))) {
+      name.push_back(std::tolower(static_cast<unsigned char>(c)));
+    } else if (!name.empty()) {
+      name.push_back(c == '-' || c == '.' || c == '/' ? c : '_');
+    }
+  }
+
+  return name;
+}
+
 } // namespace
 
 void TfliteInterpreter::serialize(const GraphRepresentation &representation,
@@ -456,12 +583,349 @@ void TfliteInterpreter::serialize(const GraphRepresentation &representation,
 }
 
 GraphRepresentation TfliteInterpreter::deserialize(const std::string &in) {
-  /// ======== list of things to consider ========
-  /// we need to reconstruct some properties from the shape
-  /// eg) units are not saved as a property
+  /// the file is kept mapped so that weights can be read in place when they
+  /// are loaded to the graph
+  model_file = std::make_shared<MMapedMemory>(in);
+  weights.clear();
+
+  const uint8_t *buf = model_file->typedBuffer<uint8_t>();
+  flatbuffers::Verifier v(buf, model_file->size());
+  NNTR_THROW_IF(!tflite::VerifyModelBuffer(v), std::invalid_argument)
+    << FUNC_TAG << "Verifying model failed, file: " << in;
+
+  const tflite::Model *model = tflite::GetModel(buf);
+  auto opcodes = model->operator_codes();
+  auto buffers = model->buffers();
+  auto subgraphs = model->subgraphs();
+  NNTR_THROW_IF(!opcodes || !buffers || !subgraphs || subgraphs->size() != 1,
+                std::invalid_argument)
+    << FUNC_TAG << "only a model with a single subgraph is supported";
+
+  const tflite::SubGraph *subgraph = subgraphs->Get(0);
+  auto tensors = subgraph->tensors();
+  auto operators = subgraph->operators();
+  auto inputs = subgraph->inputs();
+  NNTR_THROW_IF(!tensors || !operators || !inputs, std::invalid_argument)
+    << FUNC_TAG << "subgraph is missing tensors, operators or inputs";
+
+  auto get_tensor = [tensors](int idx) {
+    NNTR_THROW_IF(idx < 0 || static_cast<unsigned int>(idx) >= tensors->size(),
+                  std::invalid_argument)
+      << FUNC_TAG << "invalid tensor index: " << idx;
+    return tensors->Get(idx);
+  };
+
+  auto get_shape = [&get_tensor](int idx) {
+    auto shape = get_tensor(idx)->shape();
+    return shape ? std::vector<int>(shape->begin(), shape->end())
+                 : std::vector<int>();
+  };
+
+  /// returns weight which points to the buffer inside the mapped file
+  auto get_weight = [&get_tensor, &get_shape, buffers](int idx,
+                                                       WeightLayout layout) {
+    const tflite::Tensor *tensor = get_tensor(idx);
+    NNTR_THROW_IF(tensor->type() != tflite::TensorType_FLOAT32,
+                  std::invalid_argument)
+      << FUNC_TAG << "only float32 weights are supported, tensor index: "
+      << idx;
+    NNTR_THROW_IF(tensor->buffer() >= buffers->size(), std::invalid_argument)
+      << FUNC_TAG << "invalid buffer index: " << tensor->buffer();
+
+    auto data = buffers->Get(tensor->buffer())->data();
+    NNTR_THROW_IF(!data || data->size() % sizeof(float) != 0,
+                  std::invalid_argument)
+      << FUNC_TAG << "weight does not have a valid buffer, tensor index: "
+      << idx;
+
+    return ImportedWeight{layout,
+                          reinterpret_cast<const float *>(data->data()),
+                          data->size() / sizeof(float), get_shape(idx), {}};
+  };
+
+  GraphRepresentation graph;
+  std::unordered_map<int, std::string> producers; /**< tensor -> layer */
+  std::unordered_map<int, std::vector<int>>
+    flattened; /**< tensor -> NHWC shape before flatten */
+
+  auto get_producer = [&producers](int idx) {
+    auto iter = producers.find(idx);
+    NNTR_THROW_IF(iter == producers.end(), std::invalid_argument)
+      << FUNC_TAG << "tensor is not produced by any layer, tensor index: "
+      << idx;
+    return iter->second;
+  };
+
+  auto make_name = [&graph, &producers, &get_tensor](int idx) {
+    auto tensor_name = get_tensor(idx)->name();
+    std::string name = tensor_name ? toLayerName(tensor_name->str()) : "";
+
+    auto exist = [&producers](const std::string &n) {
+      return std::any_of(producers.begin(), producers.end(),
+                         [&n](const auto &p) { return p.second == n; });
+    };
 
-  /** NYI! */
-  return {};
+    unsigned int count = graph.size();
+    while (name.empty() || exist(name)) {
+      name = "layer" + std::to_string(count++);
+    }
+
+    return name;
+  };
+
+  auto add_layer = [this, &graph](const std::string &type,
+                                  std::vector<std::string> props,
+                                  const std::string &name) {
+    props.push_back("name=" + name);
+    graph.push_back(
+      createLayerNode(app_context.createObject<Layer>(type), props));
+  };
+
+  for (auto idx : *inputs) {
+    std::string name = make_name(idx);
+    add_layer("input", {"input_shape=" + toDimString(get_shape(idx))}, name);
+    producers[idx] = name;
+  }
+
+  for (auto op : *operators) {
+    NNTR_THROW_IF(op->opcode_index() >= opcodes->size(), std::invalid_argument)
+      << FUNC_TAG << "invalid opcode index: " << op->opcode_index();
+    auto op_inputs = op->inputs();
+    auto op_outputs = op->outputs();
+    NNTR_THROW_IF(!op_inputs || op_inputs->size() == 0 || !op_outputs ||
+                    op_outputs->size() != 1,
+                  std::invalid_argument)
+      << FUNC_TAG << "operator must have inputs and a single output";
+
+    tflite::BuiltinOperator code =
+      getBuiltinCode(opcodes->Get(op->opcode_index()));
+    int in_idx = op_inputs->Get(0);
+    int out_idx = op_outputs->Get(0);
+    std::vector<int> in_shape = get_shape(in_idx);
+    std::vector<int> out_shape = get_shape(out_idx);
+    std::string input_layer = get_producer(in_idx);
+    std::string name = make_name(out_idx);
+
+    std::string type;
+    std::vector<std::string> props;
+    std::string activation;
+
+    switch (code) {
+    case tflite::BuiltinOperator_FULLY_CONNECTED: {
+      NNTR_THROW_IF(op_inputs->size() < 2 || out_shape.empty(),
+                    std::invalid_argument)
+        << FUNC_TAG << "fully connected requires a weight, layer: " << name;
+      if (auto options = op->builtin_options_as_FullyConnectedOptions()) {
+        activation = toActivation(options->fused_activation_function());
+      }
+
+      auto weight = get_weight(op_inputs->Get(1), WeightLayout::FC);
+      if (flattened.count(in_idx)) {
+        weight.nhwc_src = flattened[in_idx];
+      }
+
+      /// tflite flattens the input implicitly while nntrainer computes on the
+      /// width only
+      if (in_shape.size() == 4 && (in_shape[1] != 1 || in_shape[3] != 1)) {
+        std::string flatten_name = name + "/flatten";
+        add_layer("flatten", {"input_layers=" + input_layer}, flatten_name);
+        input_layer = flatten_name;
+        if (in_shape[3] != 1 && in_shape[1] * in_shape[2] != 1) {
+          weight.nhwc_src = in_shape;
+        }
+      }
+
+      type = "fully_connected";
+      props = {"unit=" + std::to_string(out_shape.back()),
+               "bias_initializer=zeros"};
+      weights[name].push_back(weight);
+      if (op_inputs->size() > 2 && op_inputs->Get(2) >= 0) {
+        weights[name].push_back(
+          get_weight(op_inputs->Get(2), WeightLayout::PLAIN));
+      }
+      break;
+    }
+    case tflite::BuiltinOperator_CONV_2D: {
+      auto options = op->builtin_options_as_Conv2DOptions();
+      NNTR_THROW_IF(!options || op_inputs->size() < 2, std::invalid_argument)
+        << FUNC_TAG << "conv2d requires options and a filter, layer: " << name;
+      NNTR_THROW_IF(options->dilation_w_factor() != 1 ||
+                      options->dilation_h_factor() != 1,
+                    std::invalid_argument)
+        << FUNC_TAG << "dilated conv2d is not supported, layer: " << name;
+      activation = toActivation(options->fused_activation_function());
+
+      auto filter = get_weight(op_inputs->Get(1), WeightLayout::CONV);
+      NNTR_THROW_IF(filter.shape.size() != 4, std::invalid_argument)
+        << FUNC_TAG << "conv2d filter must be 4D, layer: " << name;
+
+      type = "conv2d";
+      props = {"filters=" + std::to_string(filter.shape[0]),
+               "kernel_size=" + std::to_string(filter.shape[1]) + "," +
+                 std::to_string(filter.shape[2]),
+               "stride=" + std::to_string(options->stride_h()) + "," +
+                 std::to_string(options->stride_w()),
+               "padding=" + toPadding(options->padding()),
+               "bias_initializer=zeros"};
+      weights[name].push_back(filter);
+      if (op_inputs->size() > 2 && op_inputs->Get(2) >= 0) {
+        weights[name].push_back(
+          get_weight(op_inputs->Get(2), WeightLayout::PLAIN));
+      }
+      break;
+    }
+    case tflite::BuiltinOperator_MAX_POOL_2D:
+    case tflite::BuiltinOperator_AVERAGE_POOL_2D: {
+      auto options = op->builtin_options_as_Pool2DOptions();
+      NNTR_THROW_IF(!options, std::invalid_argument)
+        << FUNC_TAG << "pooling requires options, layer: " << name;
+      activation = toActivation(options->fused_activation_function());
+
+      type = "pooling2d";
+      props = {std::string("pooling=") +
+                 (code == tflite::BuiltinOperator_MAX_POOL_2D ? "max"
+                                                              : "average"),
+               "pool_size=" + std::to_string(options->filter_height()) + "," +
+                 std::to_string(options->filter_width()),
+               "stride=" + std::to_string(options->stride_h()) + "," +
+                 std::to_string(options->stride_w()),
+               "padding=" + toPadding(options->padding())};
+      break;
+    }
+    case tflite::BuiltinOperator_RESHAPE: {
+      if (in_shape.size() == 4 && out_shape.size() == 2) {
+        type = "flatten";
+        if (in_shape[3] != 1 && in_shape[1] * in_shape[2] != 1) {
+          flattened[out_idx] = in_shape;
+        }
+        break;
+      }
+
+      /// NHWC and NCHW orders only agree when there is a single channel
+      auto single_channel = [](const std::vector<int> &shape) {
+        return shape.size() < 4 || shape[3] == 1;
+      };
+      NNTR_THROW_IF(!single_channel(in_shape) || !single_channel(out_shape),
+                    std::invalid_argument)
+        << FUNC_TAG
+        << "reshape which reorders channels is not supported, layer: " << name;
+
+      type = "reshape";
+      props = {"target_shape=" + toDimString(out_shape)};
+      break;
+    }
+    case tflite::BuiltinOperator_RELU:
+      type = "activation";
+      props = {"activation=relu"};
+      break;
+    case tflite::BuiltinOperator_LOGISTIC:
+      type = "activation";
+      props = {"activation=sigmoid"};
+      break;
+    case tflite::BuiltinOperator_TANH:
+      type = "activation";
+      props = {"activation=tanh"};
+      break;
+    case tflite::BuiltinOperator_SOFTMAX: {
+      auto options = op->builtin_options_as_SoftmaxOptions();
+      NNTR_THROW_IF(options && options->beta() != 1.0f, std::invalid_argument)
+        << FUNC_TAG << "softmax only supports beta 1, layer: " << name;
+
+      type = "activation";
+      props = {"activation=softmax"};
+      break;
+    }
+    case tflite::BuiltinOperator_CONCATENATION: {
+      auto options = op->builtin_options_as_ConcatenationOptions();
+      NNTR_THROW_IF(!options, std::invalid_argument)
+        << FUNC_TAG << "concat requires options, layer: " << name;
+      activation = toActivation(options->fused_activation_function());
+
+      for (unsigned int i = 1; i < op_inputs->size(); ++i) {
+        input_layer += "," + get_producer(op_inputs->Get(i));
+      }
+
+      type = "concat";
+      props = {"axis=" + std::to_string(
+                           toAxis(options->axis(), out_shape.size()))};
+      break;
+    }
+    default:
+      throw std::invalid_argument(std::string(FUNC_TAG) +
+                                  "unsupported operator: " +
+                                  tflite::EnumNameBuiltinOperator(code));
+    }
+
+    props.push_back("input_layers=" + input_layer);
+    if (!activation.empty()) {
+      props.push_back("activation=" + activation);
+    }
+
+    add_layer(type, props, name);
+    producers[out_idx] = name;
+  }
+
+  return graph;
+}
+
+void TfliteInterpreter::loadWeights(NetworkGraph &graph) const {
+  for (auto const &[name, layer_weights] : weights) {
+    auto node = graph.getLayerNode(name);
+    NNTR_THROW_IF(node == nullptr ||
+                    node->getNumWeights() < layer_weights.size(),
+                  std::invalid_argument)
+      << FUNC_TAG << "cannot find weights of the layer: " << name;
+
+    for (unsigned int i = 0; i < layer_weights.size(); ++i) {
+      const ImportedWeight &src = layer_weights[i];
+      Tensor &w = node->getWeight(i);
+      NNTR_THROW_IF(w.size() != src.len, std::invalid_argument)
+        << FUNC_TAG << "weight size mismatch, layer: " << name
+        << " weight: " << w.getName() << " expected: " << w.size()
+        << " given: " << src.len;
+
+      float *dst = w.getData();
+      switch (src.layout) {
+      case WeightLayout::FC: {
+        /// [out, in] -> [in, out], where in is reordered from NHWC to NCHW if
+        /// it is from a flattened feature map
+        size_t out = w.width();
+        size_t in = src.len / out;
+        size_t hw = 1, c = 1;
+        if (!src.nhwc_src.empty()) {
+          hw = src.nhwc_src[1] * src.nhwc_src[2];
+          c = src.nhwc_src[3];
+        }
+        for (size_t o = 0; o < out; ++o) {
+          for (size_t k = 0; k < in; ++k) {
+            size_t k_nchw = (k % c) * hw + k / c;
+            dst[k_nchw * out + o] = src.data[o * in + k];
+          }
+        }
+        break;
+      }
+      case WeightLayout::CONV: {
+        /// [out, kh, kw, in] -> [out, in, kh, kw]
+        size_t out = src.shape[0], kh = src.shape[1], kw = src.shape[2],
+               in = src.shape[3];
+        for (size_t o = 0; o < out; ++o) {
+          for (size_t y = 0; y < kh; ++y) {
+            for (size_t x = 0; x < kw; ++x) {
+              for (size_t ch = 0; ch < in; ++ch) {
+                dst[((o * in + ch) * kh + y) * kw + x] =
+                  src.data[((o * kh + y) * kw + x) * in + ch];
+              }
+            }
+          }
+        }
+        break;
+      }
+      default:
+        std::memcpy(dst, src.data, src.len * sizeof(float));
+        break;
+      }
+    }
+  }
 }
 
 } // namespace nntrainer
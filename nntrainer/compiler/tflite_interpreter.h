@@ -14,9 +14,17 @@
 
 #include <interpreter.h>
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <app_context.h>
 namespace nntrainer {
 
+class MMapedMemory;
+class NetworkGraph;
+
 /**
  * @brief tflite graph interpreter class
  *
@@ -48,8 +56,44 @@ public:
    */
   GraphRepresentation deserialize(const std::string &in) override;
 
+  /**
+   * @brief load weights of the last deserialized file into the graph
+   *
+   * @param graph graph built from the last deserialized representation, its
+   * tensors must be allocated
+   * @throws std::invalid_argument if a layer is missing or a weight size does
+   * not match
+   * @note weights are read in place from the mapped tflite file and converted
+   * to the nntrainer layout while being written to the graph
+   */
+  void loadWeights(NetworkGraph &graph) const;
+
 private:
+  /**
+   * @brief layout of a weight stored in the tflite file
+   */
+  enum class WeightLayout {
+    PLAIN, /**< same layout as nntrainer, eg) bias */
+    FC,    /**< fully connected weight, [out, in] */
+    CONV,  /**< conv2d filter, [out, kernel_h, kernel_w, in] */
+  };
+
+  /**
+   * @brief weight buffer found in the tflite file
+   */
+  struct ImportedWeight {
+    WeightLayout layout;       /**< layout of the buffer */
+    const float *data;         /**< buffer inside the mapped file */
+    size_t len;                /**< number of elements */
+    std::vector<int> shape;    /**< tflite shape of the buffer */
+    std::vector<int> nhwc_src; /**< NHWC shape of the flattened input of a fc
+                                  weight, empty if no reorder is needed */
+  };
+
   AppContext app_context;
+  std::shared_ptr<MMapedMemory> model_file; /**< last deserialized file */
+  std::unordered_map<std::string, std::vector<ImportedWeight>>
+    weights; /**< layer name -> weights in the order of the layer */
 };
 
 } // namespace nntrainer
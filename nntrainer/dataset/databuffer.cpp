@@ -21,6 +21,8 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
 #include <base_properties.h>
 #include <cassert>
 #include <climits>
@@ -59,6 +61,23 @@ public:
   using prop_tag = uint_prop_tag;                   /**< property type */
 };
 
+/**
+ * @brief Props containing number of fetch workers
+ *
+ */
+class PropsNumWorkers : public Property<unsigned int> {
+public:
+  /**
+   * @brief Construct a new props num workers object with a default value
+   *
+   * @param value default value
+   */
+  PropsNumWorkers(unsigned int value = 1) { set(value); }
+  bool isValid(const unsigned int &v) const override { return v > 0; }
+  static constexpr const char *key = "num_workers"; /**< unique key to access */
+  using prop_tag = uint_prop_tag;                   /**< property type */
+};
+
 constexpr char USER_DATA[] = "user_data";
 
 DataBuffer::DataBuffer(std::unique_ptr<DataProducer> &&producer_) :
@@ -132,24 +151,69 @@ DataBuffer::startFetchWorker(const std::vector<TensorDim> &input_dims,
     std::shuffle(idxes_.begin(), idxes_.end(), rng);
   }
 
-  return std::async(std::launch::async, [iq, generator, size,
+  /// a generator which is not thread safe is only called from a single worker
+  unsigned int num_workers = producer->isMultiThreadSafe()
+                               ? std::get<PropsNumWorkers>(*db_props).get()
+                               : 1;
+  num_workers = std::min(num_workers, std::max(size, 1u));
+
+  return std::async(std::launch::async, [iq, generator, size, num_workers,
                                          idxes = std::move(idxes_), shuffle] {
     auto notifier = NotifyOnDestruct(iq.get());
-    for (unsigned int i = 0; i < size; ++i) {
-      /// below loop can be parallelized
-      auto sample_view = iq->requestEmptySlot();
-      NNTR_THROW_IF(sample_view.isEmpty(), std::runtime_error)
-        << "[Databuffer] Cannot fill empty buffer";
-      auto &sample = sample_view.get();
+
+    /**
+     * a worker claims a sample first so that no more than size slots are
+     * requested, then fills the slot with the sample of the order of the slot.
+     * So the sample order of each iteration does not depend on the number of
+     * workers, and a worker waiting for an empty slot does not block others.
+     */
+    std::atomic<unsigned int> claimed(0);
+
+    auto fetch_samples = [&]() {
+      while (claimed.fetch_add(1) < size) {
+        unsigned int i;
+        auto sample_view = iq->requestEmptySlot(&i);
+        NNTR_THROW_IF(sample_view.isEmpty(), std::runtime_error)
+          << "[Databuffer] Cannot fill empty buffer";
+        auto &sample = sample_view.get();
+        try {
+          generator(shuffle ? idxes[i] : i, sample.getInputsRef(),
+                    sample.getLabelsRef());
+        } catch (std::exception &e) {
+          ml_loge("Fetching sample failed, Error: %s", e.what());
+          claimed = size;
+          throw;
+        }
+      }
+    };
+
+    std::vector<std::future<void>> workers;
+    workers.reserve(num_workers - 1);
+    for (unsigned int w = 1; w < num_workers; ++w) {
+      workers.push_back(std::async(std::launch::async, fetch_samples));
+    }
+
+    std::exception_ptr eptr;
+    try {
+      fetch_samples();
+    } catch (...) {
+      eptr = std::current_exception();
+    }
+
+    for (auto &worker : workers) {
       try {
-        generator(shuffle ? idxes[i] : i, sample.getInputsRef(),
-                  sample.getLabelsRef());
-      } catch (std::exception &e) {
-        ml_loge("Fetching sample failed, Error: %s", e.what());
-        throw;
+        worker.get();
+      } catch (...) {
+        if (!eptr) {
+          eptr = std::current_exception();
+        }
       }
     }
 
+    if (eptr) {
+      std::rethrow_exception(eptr);
+    }
+
     return iq;
   });
 }
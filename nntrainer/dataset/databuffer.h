@@ -51,6 +51,7 @@ using datagen_cb = ml::train::datagen_cb;
 using TensorDim = ml::train::TensorDim;
 
 class PropsBufferSize;
+class PropsNumWorkers;
 
 /**
  * @class   DataBuffer Data Buffers
@@ -71,8 +72,10 @@ public:
   ~DataBuffer();
 
   /**
-   * @brief prepare iteration a head of time with a dedicated worker. The
+   * @brief prepare iteration a head of time with dedicated workers. The
    * iteration prepared can be retrieved with @a fetch();
+   * @note samples are fetched by @a num_workers workers when the producer is
+   * multi thread safe, otherwise by a single worker
    * @remark the batch dimension of input_dims / label_dims must be same for
    * all.
    * @param input_dims dimension of input_dims
@@ -157,7 +160,7 @@ public:
 protected:
   std::shared_ptr<DataProducer> producer;
   std::weak_ptr<IterationQueue> iq_view;
-  using Props = std::tuple<PropsBufferSize>;
+  using Props = std::tuple<PropsBufferSize, PropsNumWorkers>;
   std::unique_ptr<Props> db_props;
   std::mt19937 rng;
 
@@ -30,9 +30,20 @@ public:
   using prop_tag = ptr_prop_tag;
 };
 
+/**
+ * @brief Number of samples given by the callback in an epoch
+ *
+ */
+class PropsFuncNumSamples final : public PositiveIntegerProperty {
+public:
+  static constexpr const char *key = "num_samples"; /**< unique key to access */
+  using prop_tag = uint_prop_tag;                   /**< property type */
+};
+
 FuncDataProducer::FuncDataProducer(datagen_cb datagen_cb, void *user_data_) :
   cb(datagen_cb),
-  user_data_prop(new PropsUserData(user_data_)) {}
+  user_data_prop(new PropsUserData(user_data_)),
+  num_samples_prop(new PropsFuncNumSamples()) {}
 
 FuncDataProducer::~FuncDataProducer() {}
 
@@ -41,7 +52,8 @@ const std::string FuncDataProducer::getType() const {
 }
 
 void FuncDataProducer::setProperty(const std::vector<std::string> &properties) {
-  auto left = loadProperties(properties, std::tie(*user_data_prop));
+  auto left =
+    loadProperties(properties, std::tie(*user_data_prop, *num_samples_prop));
   NNTR_THROW_IF(!left.empty(), std::invalid_argument)
     << "properties is not empty, size: " << properties.size();
 }
@@ -53,34 +65,46 @@ FuncDataProducer::finalize(const std::vector<TensorDim> &input_dims,
   NNTR_THROW_IF(!this->cb, std::invalid_argument)
     << "given callback is nullptr!";
 
-  auto input_data = std::shared_ptr<float *>(new float *[input_dims.size()],
-                                             std::default_delete<float *[]>());
-  auto label_data = std::shared_ptr<float *>(new float *[label_dims.size()],
-                                             std::default_delete<float *[]>());
+  unsigned int sz = size(input_dims, label_dims);
 
-  return [cb = this->cb, ud = this->user_data_prop->get(), input_data,
-          label_data](unsigned int idx, std::vector<Tensor> &inputs,
-                      std::vector<Tensor> &labels) -> bool {
-    float **input_data_raw = input_data.get();
-    float **label_data_raw = label_data.get();
+  return [cb = this->cb, ud = this->user_data_prop->get(), sz](
+           unsigned int idx, std::vector<Tensor> &inputs,
+           std::vector<Tensor> &labels) -> bool {
+    /// the pointers are kept per thread, as the callback can be called from
+    /// multiple workers
+    thread_local std::vector<float *> input_data_raw;
+    thread_local std::vector<float *> label_data_raw;
+    input_data_raw.resize(inputs.size());
+    label_data_raw.resize(labels.size());
 
     for (unsigned int i = 0; i < inputs.size(); ++i) {
-      *(input_data_raw + i) = inputs[i].getData();
+      input_data_raw[i] = inputs[i].getData();
     }
 
     for (unsigned int i = 0; i < labels.size(); ++i) {
-      *(label_data_raw + i) = labels[i].getData();
+      label_data_raw[i] = labels[i].getData();
     }
 
     bool last = false;
-    int status = cb(input_data_raw, label_data_raw, &last, ud);
+    int status = cb(input_data_raw.data(), label_data_raw.data(), &last, ud);
     NNTR_THROW_IF(status != ML_ERROR_NONE, std::invalid_argument)
       << "[DataProducer] Callback returned error: " << status << '\n';
 
-    return last;
+    /// with num_samples, an epoch ends after num_samples
+    return last || (sz != SIZE_UNDEFINED && idx == sz - 1);
   };
 }
 
+unsigned int
+FuncDataProducer::size(const std::vector<TensorDim> &input_dims,
+                       const std::vector<TensorDim> &label_dims) const {
+  return num_samples_prop->empty() ? SIZE_UNDEFINED : num_samples_prop->get();
+}
+
+bool FuncDataProducer::isMultiThreadSafe() const {
+  return !num_samples_prop->empty();
+}
+
 void FuncDataProducer::exportTo(Exporter &exporter,
                                 const ExportMethods &method) const {}
 
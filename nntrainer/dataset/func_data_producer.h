@@ -24,6 +24,7 @@
 namespace nntrainer {
 
 class PropsUserData;
+class PropsFuncNumSamples;
 class Exporter;
 enum class ExportMethods;
 
@@ -70,6 +71,21 @@ public:
                                    const std::vector<TensorDim> &label_dims,
                                    void *user_data = nullptr) override;
 
+  /**
+   * @copydoc DataProducer::size(const std::vector<TensorDim>, const
+   * std::vector<TensorDim>)
+   * @note the size is given by num_samples, undefined if it is not set
+   */
+  unsigned int size(const std::vector<TensorDim> &input_dims,
+                    const std::vector<TensorDim> &label_dims) const override;
+
+  /**
+   * @copydoc DataProducer::isMultiThreadSafe()
+   * @note the callback is called in parallel only when num_samples is set, as
+   * documented in ml_train_datagen_cb
+   */
+  bool isMultiThreadSafe() const override;
+
   /**
    * @copydoc DataProducer::exportTo(Exporter &exporter, ExportMethods method)
    */
@@ -78,6 +94,7 @@ public:
 private:
   datagen_cb cb;
   std::unique_ptr<PropsUserData> user_data_prop;
+  std::unique_ptr<PropsFuncNumSamples> num_samples_prop;
 };
 
 } // namespace nntrainer
@@ -10,6 +10,7 @@
  * @bug    No known bugs except for NYI items
  *
  */
+#include <algorithm>
 #include <chrono>
 #include <iteration_queue.h>
 
@@ -26,6 +27,7 @@ IterationQueue::IterationQueue(
   const std::vector<ml::train::TensorDim> &label_dims) :
   being_filled(nullptr),
   num_being_filled(0),
+  num_requested(0),
   flow_state(IterationQueue::FlowState::FLOW_STATE_OPEN) {
   NNTR_THROW_IF(num_slots == 0, std::invalid_argument)
     << "number of slots must be more then zero";
@@ -51,8 +53,10 @@ IterationQueue::~IterationQueue() {
   }
 }
 
-ScopedView<Sample> IterationQueue::requestEmptySlot() {
-  std::scoped_lock lg(empty_mutex);
+ScopedView<Sample> IterationQueue::requestEmptySlot(unsigned int *order) {
+  /// empty_mutex is not held while waiting for an empty iteration, as the
+  /// samples being filled by other workers need it to be marked filled
+  std::scoped_lock request_lock(request_mutex);
   auto current_flow_state = flow_state.load();
   NNTR_THROW_IF(current_flow_state != FlowState::FLOW_STATE_OPEN,
                 std::invalid_argument)
@@ -66,16 +70,27 @@ ScopedView<Sample> IterationQueue::requestEmptySlot() {
   // << " being_filled: " << num_being_filled
   // << " filled_q.size():  " << filled_q.size() << '\n';
 
+  MarkableIteration *next = nullptr;
   if (being_filled == nullptr ||
       current_iterator + 1 == being_filled->get().end()) {
-    being_filled = empty_q.waitAndPop();
+    next = empty_q.waitAndPop();
+  }
+
+  std::scoped_lock lg(empty_mutex);
+  if (next) {
+    being_filled = next;
     being_filled->reset();
+    being_filled_order.emplace_back(being_filled, false);
     num_being_filled++;
     current_iterator = being_filled->get().begin();
   } else {
     current_iterator++;
   }
 
+  if (order)
+    *order = num_requested;
+  num_requested++;
+
   auto view =
     ScopedView<Sample>(&(*current_iterator),
                        [current_being_filed = this->being_filled] {
@@ -85,6 +100,7 @@ ScopedView<Sample> IterationQueue::requestEmptySlot() {
                          std::unique_lock lg(empty_mutex);
                          this->markEmpty(current_being_filled);
                          num_being_filled--;
+                         releaseBeingFilled(current_being_filled, false);
                          notify_emptied_cv.notify_all();
                        });
   return view;
@@ -155,8 +171,7 @@ void IterationQueue::notifyEndOfRequestEmpty() {
 
 void IterationQueue::markFilled(MarkableIteration *iteration) {
   std::unique_lock lg(empty_mutex);
-  num_being_filled--;
-  filled_q.push(iteration);
+  releaseBeingFilled(iteration, true);
   lg.unlock();
   notify_emptied_cv.notify_all();
 }
@@ -165,6 +180,26 @@ void IterationQueue::markEmpty(MarkableIteration *iteration) {
   empty_q.push(iteration);
 }
 
+void IterationQueue::releaseBeingFilled(MarkableIteration *iteration,
+                                        bool filled) {
+  auto entry = std::find_if(
+    being_filled_order.begin(), being_filled_order.end(),
+    [iteration](const auto &order) { return order.first == iteration; });
+  if (entry != being_filled_order.end()) {
+    if (filled) {
+      entry->second = true;
+    } else {
+      being_filled_order.erase(entry);
+    }
+  }
+
+  while (!being_filled_order.empty() && being_filled_order.front().second) {
+    num_being_filled--;
+    filled_q.push(being_filled_order.front().first);
+    being_filled_order.pop_front();
+  }
+}
+
 IterationQueue::MarkableIteration::MarkableIteration(
   const std::vector<ml::train::TensorDim> &input_dims,
   const std::vector<ml::train::TensorDim> &label_dims, IterationQueue *iq) :
@@ -222,8 +257,7 @@ void IterationQueue::MarkableIteration::setEndSample(
          "locked.";
 #endif
     /// warning: iq has to be locked with iq->empty_mutex
-    iq->num_being_filled--;
-    iq->filled_q.push(this);
+    iq->releaseBeingFilled(this, true);
     iq->notify_emptied_cv.notify_all();
     num_observed = 0;
   }
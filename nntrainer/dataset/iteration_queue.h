@@ -15,6 +15,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <queue>
@@ -220,11 +221,13 @@ public:
    * @brief request empty sample from the queue.
    * @note User must check if ScopedView actually has a value by calling
    * copedView::isEmpty()
+   * @param[out] order if given, order of the returned slot among the slots
+   * requested from this queue, starting from 0
    * @return ScopedView<Sample> sample view. ScopedView::isEmpty() == true
    * if there is no more data coming. Destroying the returned object will
    * signal the queue that the sample is filled.
    */
-  ScopedView<Sample> requestEmptySlot();
+  ScopedView<Sample> requestEmptySlot(unsigned int *order = nullptr);
 
   /**
    * @brief request filled iteration from the queue.
@@ -360,15 +363,32 @@ private:
    */
   void markEmpty(MarkableIteration *iteration) /** noexcept */;
 
+  /**
+   * @brief release the given iteration from being filled, and push the
+   * iterations filled to filled_q in the order they were started being filled,
+   * as they can be done out of order with multiple workers
+   * @note empty_mutex must be locked
+   * @param iteration iteration released
+   * @param filled true if the iteration is filled, false if it is dropped
+   */
+  void releaseBeingFilled(MarkableIteration *iteration, bool filled);
+
   std::vector<MarkableIteration> iterations; /**< allocated iterations */
   MarkableIteration *being_filled; /**< last iteration that is being filled */
   std::vector<Sample>::iterator
     current_iterator; /**< current sample iteration of being_filled */
 
+  mutable std::mutex request_mutex; /**< mutex serializing the requests of
+                                       empty slots, held while waiting for an
+                                       empty iteration */
   mutable std::mutex empty_mutex; /**< mutex to be used when it is mutually
                                      exclusive to the requesting empty slots */
   unsigned int
     num_being_filled; /**< number of iteration that is in being_filled state */
+  unsigned int num_requested; /**< number of the empty slots requested */
+  std::deque<std::pair<MarkableIteration *, bool>>
+    being_filled_order; /**< iterations being filled in the order of start,
+                           paired with whether it is filled */
   mutable std::mutex
     filled_mutex; /**< mutex to be used when it is mutually exclusive to the
                      requesting filled slots */
@@ -14,6 +14,9 @@
 
 #include <raw_file_data_producer.h>
 
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
 #include <memory>
 #include <numeric>
 #include <random>
@@ -24,18 +27,52 @@
 #include <node_exporter.h>
 #include <util_func.h>
 
+#include <unistd.h>
+
 namespace nntrainer {
 
-RawFileDataProducer::RawFileDataProducer() : raw_file_props(new PropTypes()) {}
+/**
+ * @brief read the data of the tensor from the file at the given offset
+ *
+ * @param fd file descriptor
+ * @param t tensor to read to
+ * @param offset offset of the file in bytes
+ */
+static void readAt(int fd, Tensor &t, off_t offset) {
+  char *buf = reinterpret_cast<char *>(t.getData());
+  size_t left = t.bytes();
+  while (left > 0) {
+    ssize_t ret = pread(fd, buf, left, offset);
+    if (ret < 0 && errno == EINTR)
+      continue;
+    NNTR_THROW_IF(ret <= 0, std::runtime_error)
+      << "[RawFileDataProducer] failed to read the file, reason: "
+      << (ret < 0 ? strerror(errno) : "unexpected end of file");
+    buf += ret;
+    left -= ret;
+    offset += ret;
+  }
+}
+
+RawFileDataProducer::RawFileDataProducer() :
+  fd(-1),
+  raw_file_props(new PropTypes()) {}
 
 RawFileDataProducer::RawFileDataProducer(const std::string &path) :
+  fd(-1),
   raw_file_props(new PropTypes(props::FilePath(path))) {}
-RawFileDataProducer::~RawFileDataProducer() {}
+
+RawFileDataProducer::~RawFileDataProducer() {
+  if (fd >= 0)
+    close(fd);
+}
 
 const std::string RawFileDataProducer::getType() const {
   return RawFileDataProducer::type;
 }
 
+bool RawFileDataProducer::isMultiThreadSafe() const { return true; }
+
 void RawFileDataProducer::setProperty(
   const std::vector<std::string> &properties) {
   auto left = loadProperties(properties, *raw_file_props);
@@ -59,21 +96,31 @@ RawFileDataProducer::finalize(const std::vector<TensorDim> &input_dims,
   sample_size = std::accumulate(label_dims.begin(), label_dims.end(),
                                 sample_size, size_accumulator);
 
-  /// as we are passing the reference of file, this means created lamabda is
+  /// as we are passing the descriptor of file, this means created lamabda is
   /// tightly couple with the file, this is not desirable but working fine for
   /// now...
-  file = std::ifstream(path_prop.get(), std::ios::binary);
-  return [sample_size, sz, this](unsigned int idx, std::vector<Tensor> &inputs,
-                                 std::vector<Tensor> &labels) {
+  if (fd >= 0)
+    close(fd);
+  fd = open(path_prop.get().c_str(), O_RDONLY);
+  NNTR_THROW_IF(fd < 0, std::invalid_argument)
+    << "[RawFileDataProducer] failed to open " << path_prop.get()
+    << ", reason: " << strerror(errno);
+
+  return [sample_size, sz, fd = fd](unsigned int idx,
+                                    std::vector<Tensor> &inputs,
+                                    std::vector<Tensor> &labels) {
     NNTR_THROW_IF(idx >= sz, std::range_error)
       << "given index is out of bound, index: " << idx << " size: " << sz;
-    file.seekg(idx * sample_size * RawFileDataProducer::pixel_size,
-               std::ios_base::beg);
+    /// each read is at its own offset, so the workers can read concurrently
+    off_t offset = static_cast<off_t>(idx) * sample_size *
+                   RawFileDataProducer::pixel_size;
     for (auto &input : inputs) {
-      input.read(file);
+      readAt(fd, input, offset);
+      offset += input.bytes();
     }
     for (auto &label : labels) {
-      label.read(file);
+      readAt(fd, label, offset);
+      offset += label.bytes();
     }
 
     return idx == sz - 1;
@@ -17,7 +17,6 @@
 
 #include <dataset.h>
 
-#include <fstream>
 #include <memory>
 #include <string>
 #include <vector>
@@ -70,6 +69,11 @@ public:
    */
   void setProperty(const std::vector<std::string> &properties) override;
 
+  /**
+   * @copydoc DataProducer::isMultiThreadSafe()
+   */
+  bool isMultiThreadSafe() const override;
+
   /**
    * @copydoc DataProducer::finalize(const std::vector<TensorDim>, const
    * std::vector<TensorDim>)
@@ -91,7 +95,8 @@ public:
   void exportTo(Exporter &exporter, const ExportMethods &method) const override;
 
 private:
-  std::ifstream file;
+  int fd; /**< descriptor of the file, read at the offset of each sample so
+             that the workers do not share a file position */
   using PropTypes = std::tuple<props::FilePath>;
   std::unique_ptr<PropTypes> raw_file_props;
 };
@@ -63,9 +63,15 @@ int NetworkGraph::compile(const std::string &loss_type) {
 
   graph.topologicalSort();
 
-  setExecutionOrder();
+  try {
+    setRecomputeSegments();
+  } catch (std::exception &e) {
+    ml_loge("setting recompute segments failed, reason: %s", e.what());
+    return ML_ERROR_INVALID_PARAMETER;
+  }
 
-  inPlaceOptimize();
+  setLevels();
+  setExecutionOrder();
 
   status = checkCompiledGraph();
   NN_RETURN_STATUS();
@@ -76,17 +82,146 @@ int NetworkGraph::compile(const std::string &loss_type) {
 }
 
 void NetworkGraph::setExecutionOrder() {
-  auto max_count = graph.size() * 3;
-  /** @todo: remove backwarding count for non-trainble layers */
-  for (auto iter = cbegin(); iter != cend(); iter++) {
-    auto &node = *iter;
-    auto order_idx = iter - cbegin();
-    auto forward_order = order_idx;
-    auto calc_gradient_order = max_count - ((order_idx + 1) * 2);
-    /** calc derivative is called right after calc_gradient */
-    auto calc_derivative_order = calc_gradient_order + 1;
-    node->setExecutionOrder(
-      {forward_order, calc_gradient_order, calc_derivative_order});
+  if (!levels.empty()) {
+    /** calcGradient and calcDerivative of a level also run at the same time */
+    unsigned int num_levels = levels.size();
+    for (unsigned int level = 0; level < num_levels; ++level) {
+      unsigned int backward_order = num_levels * 2 - 1 - level;
+      for (auto idx : levels[level])
+        getSortedLayerNode(idx)->setExecutionOrder(
+          {level, backward_order, backward_order});
+    }
+    return;
+  }
+
+  if (recompute_segments.empty()) {
+    auto max_count = graph.size() * 3;
+    /** @todo: remove backwarding count for non-trainble layers */
+    for (auto iter = cbegin(); iter != cend(); iter++) {
+      auto &node = *iter;
+      auto order_idx = iter - cbegin();
+      auto forward_order = order_idx;
+      auto calc_gradient_order = max_count - ((order_idx + 1) * 2);
+      /** calc derivative is called right after calc_gradient */
+      auto calc_derivative_order = calc_gradient_order + 1;
+      node->setExecutionOrder(
+        {forward_order, calc_gradient_order, calc_derivative_order});
+    }
+    return;
+  }
+
+  /** the backwarding starts after the forwarding of all the nodes */
+  unsigned int order = graph.size();
+  auto segment = recompute_segments.rbegin();
+  for (unsigned int idx = graph.size(); idx-- > 0;) {
+    if (segment != recompute_segments.rend() && segment->second == idx) {
+      for (unsigned int i = segment->first; i < segment->second; ++i)
+        recompute_orders[i] = order++;
+      segment++;
+    }
+
+    auto const &node = getSortedLayerNode(idx);
+    node->setExecutionOrder({idx, order, order + 1});
+    order += 2;
+  }
+}
+
+void NetworkGraph::setLevels() {
+  levels.clear();
+  layer_pool.reset();
+
+#ifdef PROFILE
+  /** the profiler does not support events from multiple threads */
+  return;
+#endif
+
+  if (parallel_layers <= 1 || !recompute_segments.empty())
+    return;
+
+  std::unordered_map<std::string, unsigned int> level_of;
+  /** last level using the weights, keyed by the owner of the weights */
+  std::unordered_map<std::string, unsigned int> weight_level_of;
+  for (unsigned int idx = 0; idx < graph.size(); ++idx) {
+    auto const &node = getSortedLayerNode(idx);
+
+    unsigned int level = 0;
+    for (auto const &input : node->getInputLayers())
+      level =
+        std::max(level, level_of.at(getLayerNode(input)->getName()) + 1);
+
+    auto shared_from = node->getSharedFrom();
+    auto const &owner = shared_from.empty() ? node->getName() : shared_from;
+    auto shared = weight_level_of.find(owner);
+    if (shared != weight_level_of.end())
+      level = std::max(level, shared->second + 1);
+    weight_level_of[owner] = level;
+
+    level_of[node->getName()] = level;
+    if (levels.size() <= level)
+      levels.resize(level + 1);
+    levels[level].push_back(idx);
+  }
+
+  size_t max_width = 0;
+  for (auto const &level : levels)
+    max_width = std::max(max_width, level.size());
+
+  if (max_width <= 1) {
+    levels.clear();
+    return;
+  }
+
+  layer_pool = std::make_shared<ThreadPool>(
+    std::min(parallel_layers, static_cast<unsigned int>(max_width)));
+}
+
+void NetworkGraph::setRecomputeSegments() {
+  recompute_segments.clear();
+  recompute_orders.assign(graph.size(), 0);
+
+  unsigned int last_checkpoint = 0;
+  for (unsigned int idx = 0; idx < graph.size(); ++idx) {
+    if (getSortedLayerNode(idx)->getCheckpoint())
+      last_checkpoint = idx;
+  }
+
+  for (unsigned int idx = 0; idx < last_checkpoint; ++idx) {
+    if (getSortedLayerNode(idx)->getCheckpoint())
+      continue;
+
+    if (recompute_segments.empty() || recompute_segments.back().second != idx)
+      recompute_segments.emplace_back(idx, idx + 1);
+    else
+      recompute_segments.back().second = idx + 1;
+  }
+  recompute_rng_states.resize(recompute_segments.size());
+  recompute_stats.assign(recompute_segments.size(), {});
+
+  /** segment of each node, -1 if the node is kept */
+  std::vector<int> segment_of(graph.size(), -1);
+  for (unsigned int s = 0; s < recompute_segments.size(); ++s) {
+    for (unsigned int i = recompute_segments[s].first;
+         i < recompute_segments[s].second; ++i)
+      segment_of[i] = s;
+  }
+
+  std::unordered_map<std::string, unsigned int> sorted_idx;
+  for (unsigned int idx = 0; idx < graph.size(); ++idx)
+    sorted_idx[getSortedLayerNode(idx)->getName()] = idx;
+
+  /** a recomputed output can only be used until the checkpoint closing it */
+  for (unsigned int idx = 0; idx < graph.size(); ++idx) {
+    auto const &node = getSortedLayerNode(idx);
+    for (auto const &input : node->getInputLayers()) {
+      int segment = segment_of[sorted_idx.at(getLayerNode(input)->getName())];
+      if (segment < 0 || segment_of[idx] == segment ||
+          recompute_segments[segment].second == idx)
+        continue;
+
+      throw std::invalid_argument(
+        "recomputed output of " + input + " is used by " + node->getName() +
+        ", which is not in the same segment or its checkpoint");
+    }
   }
 }
 
@@ -240,10 +375,42 @@ void NetworkGraph::markNodesForBackwarding() {
     LNODE(graph.getNode(node_name))->needsCalcDerivative(true);
 }
 
+void NetworkGraph::keepGradients() {
+  if (gradients_kept)
+    return;
+
+  /** the tensors are planned again with the gradients extended */
+  if (tensor_manager->isAllocated())
+    deallocateTensors();
+
+  auto last_order = std::get<2>((*cbegin())->getExecutionOrder());
+  for (unsigned int idx = 0; idx < graph.size(); ++idx) {
+    auto &rc = getSortedLayerNode(idx)->getRunContext();
+    for (unsigned i = 0; i < rc.getNumWeights(); ++i) {
+      if (rc.weightHasGradient(i))
+        tensor_manager->extendTensor(rc.getWeightGrad(i).getName(),
+                                     last_order);
+    }
+  }
+  gradients_kept = true;
+}
+
 void NetworkGraph::setBatchSize(unsigned int batch_size) {
   if (batch_size == this->batch_size)
     return;
 
+  NNTR_THROW_IF(batch_size != 1 &&
+                  std::any_of(cbegin(), cend(),
+                              [](const std::shared_ptr<LayerNode> &lnode) {
+                                return lnode->isFinalized() &&
+                                       (lnode->getType() == ConcatLayer::type ||
+                                        lnode->getType() == SplitLayer::type) &&
+                                       lnode->executeInPlace() != InPlace::NONE;
+                              }),
+                std::invalid_argument)
+    << "concat or split tensors are placed without copy for the batch size 1, "
+       "set memory_optimization=false to change the batch size";
+
   this->batch_size = batch_size;
   if (!input_list.empty() && getInputDimension()[0].batch() == batch_size)
     return;
@@ -304,11 +471,39 @@ void NetworkGraph::applyGradientsOnLastAccess(
 }
 
 sharedConstTensors NetworkGraph::forwarding(bool training) const {
-  for (auto iter = cbegin(); iter != cend(); iter++) {
-    auto const &ln = *iter;
-    START_PROFILE(profile_keys.at(ln->getType()));
-    ln->forwarding(training);
-    END_PROFILE(profile_keys.at(ln->getType()));
+  if (!recompute_segments.empty())
+    tensor_manager->setRecomputing(false);
+  tensor_manager->resetSwap();
+
+  if (!levels.empty()) {
+    /** the level is the forwarding order of its nodes */
+    for (unsigned int order = 0; order < levels.size(); ++order) {
+      auto const &level = levels[order];
+      if (training)
+        tensor_manager->swap(order, order);
+      layer_pool->run(level.size(), [this, &level, training](unsigned int i) {
+        getSortedLayerNode(level[i])->forwarding(training);
+      });
+    }
+  } else {
+    auto segment = recompute_segments.begin();
+    for (auto iter = cbegin(); iter != cend(); iter++) {
+      auto const &ln = *iter;
+      /** swapped tensors are only brought back for the backwarding */
+      if (training) {
+        auto order = std::get<0>(ln->getExecutionOrder());
+        tensor_manager->swap(order, order);
+      }
+      if (training && segment != recompute_segments.end() &&
+          segment->first == static_cast<unsigned int>(iter - cbegin())) {
+        recompute_rng_states[segment - recompute_segments.begin()] =
+          Tensor::getRandomState();
+        segment++;
+      }
+      START_PROFILE(profile_keys.at(ln->getType()));
+      ln->forwarding(training);
+      END_PROFILE(profile_keys.at(ln->getType()));
+    }
   }
 
   sharedConstTensors out;
@@ -342,14 +537,108 @@ void NetworkGraph::backwarding(
     throw std::runtime_error(
       "Error: last layer does not accept label, we can't train");
 
+  if (!recompute_segments.empty())
+    tensor_manager->setRecomputing(true);
+
+  if (!levels.empty()) {
+    for (unsigned int l = levels.size(); l-- > 0;) {
+      auto const &level = levels[l];
+      auto order =
+        std::get<1>(getSortedLayerNode(level[0])->getExecutionOrder());
+      tensor_manager->swap(order, order);
+      layer_pool->run(level.size(), [&](unsigned int i) {
+        backwarding_op(getSortedLayerNode(level[i]), iteration);
+      });
+    }
+    return;
+  }
+
   for (auto iter = iter_begin; iter != iter_end; iter++) {
     auto &ln = *iter;
+    recomputeSegment(graph.size() - 1 - (iter - iter_begin));
+    tensor_manager->swap(std::get<1>(ln->getExecutionOrder()),
+                         std::get<2>(ln->getExecutionOrder()));
     START_PROFILE(profile_keys.at(ln->getType()));
     backwarding_op(ln, iteration);
     END_PROFILE(profile_keys.at(ln->getType()));
   }
 }
 
+void NetworkGraph::recomputeSegment(unsigned int idx) const {
+  auto segment = std::find_if(
+    recompute_segments.begin(), recompute_segments.end(),
+    [idx](auto const &s) { return s.second == idx; });
+  if (segment == recompute_segments.end())
+    return;
+
+  /** nothing reads the segment if none of it needs the backwarding */
+  auto needs_backwarding = [](const std::shared_ptr<LayerNode> &node) {
+    return node->needsCalcDerivative() || node->needsCalcGradient();
+  };
+  bool needed = false;
+  for (unsigned int i = segment->first; i <= segment->second; ++i)
+    needed = needed || needs_backwarding(getSortedLayerNode(i));
+  if (!needed)
+    return;
+
+  /**
+   * the recomputation must give the outputs of the forwarding without
+   * touching the model, so it draws the random values of the forwarding and
+   * the weights it updates, which have no gradient, are kept aside
+   */
+  std::vector<Tensor *> stats;
+  for (unsigned int i = segment->first; i < segment->second; ++i) {
+    auto &rc = getSortedLayerNode(i)->getRunContext();
+    for (unsigned int w = 0; w < rc.getNumWeights(); ++w) {
+      if (!rc.weightHasGradient(w))
+        stats.push_back(&rc.getWeight(w));
+    }
+  }
+  unsigned int s = segment - recompute_segments.begin();
+  auto &kept = recompute_stats[s];
+  for (unsigned int i = 0; i < stats.size(); ++i) {
+    if (i == kept.size())
+      kept.push_back(stats[i]->clone());
+    else
+      kept[i].copyData(*stats[i]);
+  }
+
+  auto rng_state = Tensor::getRandomState();
+  Tensor::setRandomState(recompute_rng_states[s]);
+
+  for (unsigned int i = segment->first; i < segment->second; ++i) {
+    auto const &ln = getSortedLayerNode(i);
+    tensor_manager->swap(recompute_orders[i], recompute_orders[i]);
+    START_PROFILE(profile_keys.at(ln->getType()));
+    ln->forwarding(true);
+    END_PROFILE(profile_keys.at(ln->getType()));
+  }
+
+  Tensor::setRandomState(rng_state);
+  for (unsigned int i = 0; i < stats.size(); ++i)
+    stats[i]->copyData(kept[i]);
+}
+
+void NetworkGraph::requestRecompute() {
+  unsigned int backward_start = graph.size();
+  for (auto const &[begin, end] : recompute_segments) {
+    for (unsigned int idx = begin; idx < end; ++idx) {
+      auto const &node = getSortedLayerNode(idx);
+      auto &rc = node->getRunContext();
+      unsigned int order = recompute_orders[idx];
+
+      for (unsigned int i = 0; i < rc.getNumInputs(); ++i)
+        tensor_manager->recompute(rc.getInput(i).getName(), order);
+      for (unsigned int i = 0; i < rc.getNumOutputs(); ++i)
+        tensor_manager->recompute(rc.getOutput(i).getName(), order,
+                                  backward_start);
+      for (unsigned int i = 0; i < rc.getNumTensors(); ++i)
+        tensor_manager->recompute(rc.getTensor(i).getName(), order,
+                                  backward_start);
+    }
+  }
+}
+
 /**
  * @brief Allocate memory for all the managed tensors
  */
@@ -361,8 +650,7 @@ void NetworkGraph::allocateTensors(ExecutionMode exec_mode_) {
      * layer and pass that as the max_exec_order ensuring that all tensors
      * with usage less than the max_exec_order are allocated.
      */
-    tensor_manager->allocateTensors(
-      std::get<0>((*(cend() - 1))->getExecutionOrder()));
+    tensor_manager->allocateTensors(getLastForwardingOrder());
   else {
     /**
      * get the order of execution/usage order for the backwarding of the first
@@ -479,6 +767,12 @@ NetworkGraph::canExecuteInPlace(const std::shared_ptr<LayerNode> &lnode) {
     return lnode->getType() == MultiOutLayer::type;
   };
 
+  /** layers which only move the data among its inputs and outputs */
+  auto data_move = [](const std::shared_ptr<LayerNode> &lnode) {
+    return lnode->getType() == ConcatLayer::type ||
+           lnode->getType() == SplitLayer::type;
+  };
+
   /**
    * layers whose backwarding is not dependent on input/output but only its
    * derivatives and weights, if any - batch normalization
@@ -525,6 +819,24 @@ NetworkGraph::canExecuteInPlace(const std::shared_ptr<LayerNode> &lnode) {
   if (no_op_shared(lnode))
     return InPlace::RESTRICTING;
 
+  /**
+   * @note Conditions to decide if this layer node can be in-place:
+   * if the layer only moves the data - concat, split, the inputs of a concat
+   * are placed in its output and the outputs of a split are placed in its
+   * input. A part is contiguous in the whole only with the batch size of 1,
+   * and a recomputed tensor has different memory in the backwarding, so this
+   * is not applied in these cases.
+   *
+   * @note Conditions to decide the type of inplace for this layer:
+   * As the memory is shared with the nodes before it, the output nodes cannot
+   * modify it, and then its restricting mode.
+   */
+  if (data_move(lnode)) {
+    if (batch_size != 1 || !recompute_segments.empty())
+      return InPlace::NONE;
+    return InPlace::RESTRICTING;
+  }
+
   /**
    * @note Conditions to decide if this layer node can be in-place:
    * This is a generic case where the layer can support in-place but will modify
@@ -540,14 +852,29 @@ NetworkGraph::canExecuteInPlace(const std::shared_ptr<LayerNode> &lnode) {
    * inplace.
    *
    * @note This logic is prone to change as more layers are allowed to
-   * work in-place such as concat layer, split layer, addition layer, dropout
-   * layer, etc.
+   * work in-place such as dropout layer, etc.
    *
    * @todo This logic sets layers to in-place one-by-one as they arrive. However
    * setting some layers to in-place can save more memory than others (like
    * multiout layer vs activaiton layer). The layers need to sorted based on the
    * memory save they provide and then make them in-place in that order.
    */
+  /**
+   * @note Conditions to decide if this layer node can be in-place:
+   * if the layer is an addition, its output overwrites one of its inputs and
+   * the other inputs are only read, so only the overwritten input is checked
+   * as in getOverwritableInputIdx().
+   *
+   * @note Conditions to decide the type of inplace for this layer:
+   * The backwarding of addition does not require its inputs/outputs, so it is
+   * a non-restricting in-place layer.
+   */
+  if (lnode->getType() == AdditionLayer::type) {
+    if (getOverwritableInputIdx(lnode) == lnode->getNumInputConnections())
+      return InPlace::NONE;
+    return InPlace::NON_RESTRICTING;
+  }
+
   if (lnode->getType() == ActivationLayer::type ||
       lnode->getType() == BatchNormalizationLayer::type) {
     auto const &input_layers = lnode->getInputLayers();
@@ -573,13 +900,73 @@ NetworkGraph::canExecuteInPlace(const std::shared_ptr<LayerNode> &lnode) {
 
 void NetworkGraph::inPlaceOptimize() {
   if (optimize_memory) {
+    /** segment recomputing the node, -1 if the node is kept */
+    auto segment_of = [this](const std::shared_ptr<LayerNode> &lnode) {
+      unsigned int idx = std::get<0>(lnode->getExecutionOrder());
+      for (unsigned int s = 0; s < recompute_segments.size(); ++s) {
+        if (recompute_segments[s].first <= idx &&
+            idx < recompute_segments[s].second)
+          return static_cast<int>(s);
+      }
+      return -1;
+    };
+
     for (unsigned int idx = 0; idx < graph.size(); ++idx) {
       auto const &lnode = getSortedLayerNode(idx);
+
+      /**
+       * the memory of a recomputed output is different between the forwarding
+       * and the backwarding, so a node can only share the memory of its input
+       * if both are recomputed in the same segment or both are kept
+       */
+      auto const &input_layers = lnode->getInputLayers();
+      if (std::any_of(input_layers.begin(), input_layers.end(),
+                      [&](const std::string &input) {
+                        return segment_of(getLayerNode(input)) !=
+                               segment_of(lnode);
+                      })) {
+        lnode->executeInPlace(InPlace::NONE);
+        continue;
+      }
+
       lnode->executeInPlace(canExecuteInPlace(lnode));
     }
   }
 }
 
+unsigned int NetworkGraph::getOverwritableInputIdx(
+  const std::shared_ptr<LayerNode> &lnode) {
+  auto const &input_layers = lnode->getInputLayers();
+  unsigned int idx = 0;
+  for (; idx < input_layers.size(); ++idx) {
+    auto const &input_node = getLayerNode(input_layers[idx]);
+    /**
+     * the input must not be restricted by the nodes before, must not be read
+     * by the backwarding of its node, and must not be an external data
+     */
+    if (input_node->executeInPlace() != InPlace::RESTRICTING &&
+        input_node->getType() != ActivationLayer::type &&
+        input_node->getType() != TimeDistLayer::type &&
+        input_node->getType() != InputLayer::type)
+      break;
+  }
+
+  return idx;
+}
+
+bool NetworkGraph::canAliasDerivative(const std::shared_ptr<LayerNode> &lnode,
+                                      unsigned int idx) {
+  auto const &input_node = getLayerNode(lnode->getInputLayers()[idx]);
+  /**
+   * an in-place node computes its derivative over the incoming derivative
+   * (except multiout), and time distributed layer transposes it, so they may
+   * overwrite the derivative still to be read by the other inputs
+   */
+  return input_node->getType() != TimeDistLayer::type &&
+         (input_node->executeInPlace() == InPlace::NONE ||
+          input_node->getType() == MultiOutLayer::type);
+}
+
 /**
  * @brief Set the Inplace Shared Memory Config By Layer object
  *
@@ -590,15 +977,18 @@ void NetworkGraph::inPlaceOptimize() {
 static void
 setInplaceSharedMemoryConfigByLayer(const std::shared_ptr<LayerNode> &lnode,
                                     bool &shared_var, bool &shared_grad) {
-  /** for multiout layer, variables are shared but gradients are not */
-  if (lnode->getType() == MultiOutLayer::type) {
+  /**
+   * for multiout layer, variables are shared but gradients are not. for
+   * addition layer, the gradients are aliased separately for all the inputs.
+   */
+  if (lnode->getType() == MultiOutLayer::type ||
+      lnode->getType() == AdditionLayer::type) {
     shared_var = true;
     shared_grad = false;
   } else {
     shared_var = true;
     shared_grad = true;
   }
-  /** @todo for addition layer, variables are not shared but gradients are */
   /**
    * @todo for layers which support in-place, both variables and gradients will
    * be be shared.
@@ -608,6 +998,41 @@ setInplaceSharedMemoryConfigByLayer(const std::shared_ptr<LayerNode> &lnode,
    */
 }
 
+/**
+ * @brief Get the offsets of the parts laid out one after another in the whole
+ * along an axis, as a concat output or a split input
+ *
+ * @param whole dimension of the whole tensor
+ * @param parts dimensions of the parts
+ * @return std::vector<unsigned int> offset of each part in the whole, empty if
+ * a part is not contiguous in the whole
+ */
+static std::vector<unsigned int>
+getContiguousOffsets(const TensorDim &whole,
+                     const std::vector<TensorDim> &parts) {
+  std::vector<unsigned int> offsets;
+  unsigned int offset = 0;
+  for (auto const &part : parts) {
+    unsigned int axis = 0;
+    while (axis < TensorDim::MAXDIM && part[axis] == whole[axis])
+      ++axis;
+
+    /** a part is contiguous if all the dimensions before the axis are 1 */
+    for (unsigned int i = 0; i < axis && axis < TensorDim::MAXDIM; ++i) {
+      if (whole[i] != 1)
+        return {};
+    }
+
+    offsets.push_back(offset);
+    offset += part.getDataLen();
+  }
+
+  if (offset != whole.getDataLen())
+    return {};
+
+  return offsets;
+}
+
 std::vector<Var_Grad *>
 NetworkGraph::finalizeContext(const std::shared_ptr<LayerNode> &lnode,
                               const std::vector<Var_Grad *> &prev_inputs) {
@@ -619,7 +1044,7 @@ NetworkGraph::finalizeContext(const std::shared_ptr<LayerNode> &lnode,
                  [](const Var_Grad *vg) { return vg->getDim(); });
 
   /** finalize the layer and get the final context */
-  auto init_context = lnode->finalize(input_dims);
+  auto init_context = lnode->finalize(input_dims, num_threads);
 
   /**
    * Request manager for either a pre-allocated output as input or a newly
@@ -637,10 +1062,16 @@ NetworkGraph::finalizeContext(const std::shared_ptr<LayerNode> &lnode,
   /** In-Place optimizations */
   std::vector<std::string> inputs_name;
   bool shared_var = false, shared_grad = false;
-  if (lnode->executeInPlace() != InPlace::NONE) {
-    std::transform(inputs.begin(), inputs.end(),
-                   std::back_inserter(inputs_name),
-                   [](const Var_Grad *val) { return val->getName(); });
+  bool data_move = lnode->getType() == ConcatLayer::type ||
+                   lnode->getType() == SplitLayer::type;
+  if (lnode->executeInPlace() != InPlace::NONE && !data_move) {
+    if (lnode->getType() == AdditionLayer::type) {
+      inputs_name.push_back(inputs[getOverwritableInputIdx(lnode)]->getName());
+    } else {
+      std::transform(inputs.begin(), inputs.end(),
+                     std::back_inserter(inputs_name),
+                     [](const Var_Grad *val) { return val->getName(); });
+    }
     setInplaceSharedMemoryConfigByLayer(lnode, shared_var, shared_grad);
   }
 
@@ -653,6 +1084,43 @@ NetworkGraph::finalizeContext(const std::shared_ptr<LayerNode> &lnode,
     tensor_manager->requestOutputs(gnode, init_context.getOutputDimensions(),
                                    inputs_name, shared_var, shared_grad);
 
+  /**
+   * The derivatives for all the inputs of an addition are the same as the
+   * incoming derivative, so they are aliased if not overwritten by the inputs.
+   */
+  if (optimize_memory && lnode->getType() == AdditionLayer::type) {
+    for (unsigned int idx = 0; idx < inputs.size(); ++idx) {
+      if (canAliasDerivative(lnode, idx))
+        tensor_manager->placeTensor(inputs[idx]->getGradientName(),
+                                    outputs[0]->getGradientName(), 0);
+    }
+  }
+
+  /**
+   * Place the inputs of a concat in its output, or the outputs of a split in
+   * its input. A part which cannot be placed, e.g. the same tensor given twice,
+   * is left to be copied by the layer.
+   */
+  if (lnode->executeInPlace() != InPlace::NONE && data_move) {
+    bool concat = lnode->getType() == ConcatLayer::type;
+    auto const &parts = concat ? inputs : outputs;
+    auto const &whole = concat ? outputs[0] : inputs[0];
+
+    std::vector<TensorDim> part_dims;
+    std::transform(parts.begin(), parts.end(), std::back_inserter(part_dims),
+                   [](const Var_Grad *vg) { return vg->getDim(); });
+    auto offsets = getContiguousOffsets(whole->getDim(), part_dims);
+    if (offsets.empty())
+      lnode->executeInPlace(InPlace::NONE);
+
+    for (unsigned int idx = 0; idx < offsets.size(); ++idx) {
+      tensor_manager->placeTensor(parts[idx]->getName(), whole->getName(),
+                                  offsets[idx]);
+      tensor_manager->placeTensor(parts[idx]->getGradientName(),
+                                  whole->getGradientName(), offsets[idx]);
+    }
+  }
+
   /** create shared weight names if requested */
   std::vector<std::string> shared_weight_names;
   std::vector<std::string> shared_tensor_names;
@@ -710,6 +1178,9 @@ int NetworkGraph::initialize(
   const std::vector<std::string> &model_input_names,
   const std::vector<std::string> &model_label_names) {
 
+  /** the in-place optimization depends on the batch size set by now */
+  inPlaceOptimize();
+
   /**
    * this contains the map from node name to its input tensor names
    * @note: these input tensors have already been allocated
@@ -771,6 +1242,8 @@ int NetworkGraph::initialize(
     }
   }
 
+  requestRecompute();
+
   for (unsigned int idx = 0; idx < graph.size(); ++idx) {
     auto const &lnode = getSortedLayerNode(idx);
     auto &rc = lnode->getRunContext();
@@ -801,6 +1274,11 @@ int NetworkGraph::initialize(
       }
     }
   }
+
+  /** the gradient is read by its update until the backwarding ends */
+  if (async_update)
+    keepGradients();
+
   /**** identify model input / output to be set externally later ****/
   auto identify_as_model_input = [this](LayerNode *node) {
     auto num_input = node->getNumInputs();
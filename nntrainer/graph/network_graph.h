@@ -25,6 +25,7 @@
 #include <graph_core.h>
 #include <layer_node.h>
 #include <manager.h>
+#include <thread_pool.h>
 
 namespace nntrainer {
 
@@ -43,6 +44,10 @@ public:
     graph(),
     compiled(false),
     batch_size(0),
+    num_threads(1),
+    parallel_layers(1),
+    async_update(false),
+    gradients_kept(false),
     optimize_memory(true),
     exec_mode(ExecutionMode::TRAIN) {}
 
@@ -273,12 +278,43 @@ public:
     tensor_manager->deallocateTensors(dealloc_weights);
   }
 
+  /**
+   * @brief Check if the managed tensors are allocated
+   *
+   * @return bool true if allocated
+   */
+  bool isAllocated() const { return tensor_manager->isAllocated(); }
+
+  /**
+   * @brief Check if the managed weights are allocated
+   *
+   * @return bool true if allocated
+   */
+  bool isWeightAllocated() const {
+    return tensor_manager->isWeightAllocated();
+  }
+
+  /**
+   * @brief Let the layers prepare what they derive from the weights, after
+   * the values of the weights are set
+   */
+  void prepareWeights() {
+    for (auto iter = cbegin(); iter != cend(); iter++)
+      (*iter)->prepareWeights();
+  }
+
+  /**
+   * @brief Get the execution mode with which the tensors are allocated
+   *
+   * @return ExecutionMode execution mode
+   */
+  ExecutionMode getExecutionMode() const { return exec_mode; }
+
   /**
    * @brief Allocate memory for all the managed weights
    */
   void allocateWeights() {
-    tensor_manager->allocateWeights(
-      std::get<0>((*(cend() - 1))->getExecutionOrder()));
+    tensor_manager->allocateWeights(getLastForwardingOrder());
   }
 
   /**
@@ -286,6 +322,28 @@ public:
    */
   void deallocateWeights() { tensor_manager->deallocateWeights(); }
 
+  /**
+   * @brief Use the allocated weights of the given graph instead of allocating
+   * the weights of this graph
+   *
+   * @param from initialized graph with the same layers
+   */
+  void borrowWeights(NetworkGraph &from) {
+    tensor_manager->borrowWeights(*from.tensor_manager);
+  }
+
+  /**
+   * @brief Use the memory mapped file for the weights instead of allocating
+   * the weights of this graph
+   *
+   * @param file mapped file holding the data of the weights
+   * @param offsets byte offset in the file of each weight by name
+   */
+  void mapWeights(std::shared_ptr<MMapedMemory> file,
+                  const std::unordered_map<std::string, size_t> &offsets) {
+    tensor_manager->mapWeights(file, offsets);
+  }
+
   /**
    * @brief     Enable the memory optimizations for the network
    *
@@ -296,15 +354,85 @@ public:
     optimize_memory = val;
   }
 
+  /**
+   * @brief     Set the memory planner used with the memory optimizations
+   *
+   * @param type type of the planner
+   */
+  void setMemoryPlanner(const std::string &type) {
+    tensor_manager->setMemoryPlanner(type);
+  }
+
+  /**
+   * @brief Set the tensors to be swapped out to a file while they are idle
+   *
+   * @param path directory to create the swap file in, empty to disable
+   * @param lookahead number of the execution orders to start swapping in a
+   * tensor ahead of its use
+   */
+  void setMemorySwap(const std::string &path, unsigned int lookahead) {
+    tensor_manager->setMemorySwap(path, lookahead);
+  }
+
+  /**
+   * @brief     Get the memory planned for the tensors other than the weights
+   *
+   * @return std::pair<size_t, size_t> planned size in bytes and the
+   * theoretical minimum of it
+   */
+  std::pair<size_t, size_t> getTensorMemoryPlan() {
+    return tensor_manager->getTensorMemoryPlan();
+  }
+
+  /**
+   * @brief     Set the number of threads the layers may use while running
+   *
+   * @param val number of threads
+   * @note this must be set before initialize() as the layers plan their
+   * per-thread memory while being finalized
+   */
+  void setNumThreads(unsigned int val) { num_threads = val; }
+
+  /**
+   * @brief     Set the number of threads running the independent layer nodes
+   * concurrently
+   *
+   * @param val number of threads, 1 to run the nodes one by one
+   * @note this must be set before compile() as the execution orders are set
+   * by the nodes running at the same time
+   */
+  void setParallelLayers(unsigned int val) { parallel_layers = val; }
+
+  /**
+   * @brief     Set the gradients to be applied in background while the
+   * backwarding goes on
+   *
+   * @param val true to keep the gradients valid until the backwarding ends
+   * @note this must be set before initialize() as the gradients are planned
+   * while the layers are being finalized
+   */
+  void setAsyncUpdate(bool val) { async_update = val; }
+
+  /**
+   * @brief     Keep the gradients of the weights valid until the backwarding
+   * ends, so that they can be applied after all of them are calculated
+   *
+   * @note the tensors are deallocated if allocated, to be planned again with
+   * the longer lifespans
+   */
+  void keepGradients();
+
   /**
    * @brief     Create optimizer variable for every weights
    *
    * @param cb  Call back function which will return vector of dimension
    * @param request_only_trainable true when only request trainable weight
+   * @param type data type to store the optimizer variables in
    */
   void requestOptimizerVariable(
     std::function<std::vector<TensorDim>(const TensorDim &)> cb,
-    bool request_only_trainable = true) {
+    bool request_only_trainable = true,
+    Tensor::DataType type = Tensor::DataType::FP32) {
     for (auto const &w : tensor_manager->getWeights()) {
       if (!w->isDependent()) {
         const TensorDim &dim = w->getDim();
@@ -312,7 +440,7 @@ public:
         w->setOptimizerVariables(
           tensor_manager->requestWeightOptimizerVariables(
             dims, w->getName(), TensorLifespan::MAX_LIFESPAN,
-            Tensor::Initializer::ZEROS));
+            Tensor::Initializer::ZEROS, type));
       }
     }
   }
@@ -350,6 +478,11 @@ private:
   GraphCore graph;         /** core graph object */
   bool compiled;           /**< if the model graph is compiled */
   unsigned int batch_size; /**< current batch_size */
+  unsigned int num_threads; /**< number of threads available to the layers */
+  unsigned int parallel_layers; /**< number of threads running the
+                                   independent nodes concurrently */
+  bool async_update; /**< gradients are applied until the backwarding ends */
+  bool gradients_kept; /**< gradients are valid until the backwarding ends */
 
   /// @note *_list and *_dims must be synced at all times. Consider put it as a
   /// structure
@@ -363,6 +496,27 @@ private:
   ExecutionMode exec_mode; /**< execution mode with which the graph has been
                               currently set or previously set */
 
+  std::vector<std::pair<unsigned int, unsigned int>>
+    recompute_segments; /**< [begin, end) of the nodes recomputed right
+                           before backwarding the checkpoint node at end */
+  std::vector<unsigned int>
+    recompute_orders; /**< execution order of the recomputation of each node,
+                         0 if the node is not recomputed */
+  mutable std::vector<Tensor::RandomState>
+    recompute_rng_states; /**< random state at the beginning of each segment
+                             in the forwarding, replayed by its recomputation
+                             to draw the same dropout masks */
+  mutable std::vector<std::vector<Tensor>>
+    recompute_stats; /**< weights without gradient of the nodes of each
+                        segment, such as the moving statistics of batch
+                        normalization, restored after the recomputation */
+
+  std::vector<std::vector<unsigned int>>
+    levels; /**< sorted index of the nodes of each level, where the nodes of a
+               level run concurrently, empty if the nodes run one by one */
+  std::shared_ptr<ThreadPool>
+    layer_pool; /**< threads running the nodes of a level */
+
   std::unordered_map<std::string, int>
     profile_keys; /**< profile keys based on the layer type */
 
@@ -439,10 +593,59 @@ private:
    * @details This sets the order of execution using the order from the
    * topological sort. The order of forwarding matches the topological sort. The
    * order for backwarding is in the exact reverse order. The calcDerivative()
-   * is expected to be called right after calcGradient().
+   * is expected to be called right after calcGradient(). The nodes of a
+   * recompute segment are given the orders of their recomputation right
+   * before the backwarding of the checkpoint node closing the segment. The
+   * nodes of a level share their orders, so that the memory planner keeps
+   * the tensors of the nodes running at the same time apart.
    */
   void setExecutionOrder();
 
+  /**
+   * @brief Set the levels of the nodes running concurrently
+   *
+   * @details The level of a node is one more than the highest level of its
+   * inputs, so the nodes of a level do not depend on each other. The nodes
+   * sharing weights accumulate the same gradient and are put on different
+   * levels. The levels are not set when the nodes are recomputed, or when no
+   * level has more than one node.
+   */
+  void setLevels();
+
+  /**
+   * @brief Get the execution order of the last forwarding
+   *
+   * @return unsigned int forwarding order of the last level or node
+   */
+  unsigned int getLastForwardingOrder() const {
+    return (levels.empty() ? graph.size() : levels.size()) - 1;
+  }
+
+  /**
+   * @brief Set the segments of the nodes recomputed in the backwarding
+   *
+   * @details All the nodes before the last node marked as checkpoint, except
+   * the checkpoint nodes, are not kept from the forwarding but recomputed.
+   * Each run of such nodes forms a segment closed by the checkpoint node after
+   * it.
+   * @throws std::invalid_argument if an output of a segment is used outside
+   * of the segment and its checkpoint node
+   */
+  void setRecomputeSegments();
+
+  /**
+   * @brief Request the tensors of the recomputed nodes to be recomputed
+   * @note this must be called after all the nodes are finalized
+   */
+  void requestRecompute();
+
+  /**
+   * @brief Recompute the forwarding of the segment closed by the given node
+   *
+   * @param idx index of the node in the sorted graph
+   */
+  void recomputeSegment(unsigned int idx) const;
+
   /**
    * @brief Set external data to the given tensors with name
    *
@@ -465,6 +668,30 @@ private:
    * @return the mode of inplace for the layer
    */
   InPlace canExecuteInPlace(const std::shared_ptr<LayerNode> &lnode);
+
+  /**
+   * @brief     Get the index of the input an addition node can overwrite with
+   * its output
+   *
+   * @param lnode addition node
+   *
+   * @return index of the input, number of the inputs if none can be
+   * overwritten
+   */
+  unsigned int
+  getOverwritableInputIdx(const std::shared_ptr<LayerNode> &lnode);
+
+  /**
+   * @brief     Check if the derivative for an input of an addition node can
+   * alias the incoming derivative of the node
+   *
+   * @param lnode addition node
+   * @param idx index of the input
+   *
+   * @return true if the derivative can be aliased
+   */
+  bool canAliasDerivative(const std::shared_ptr<LayerNode> &lnode,
+                          unsigned int idx);
 };
 
 } // namespace nntrainer
@@ -46,6 +46,13 @@ public:
    */
   void setActiFunc(ActivationType acti_type);
 
+  /**
+   * @brief get the activation type
+   *
+   * @return ActivationType type of the activation
+   */
+  ActivationType getActivationType() const { return activation_type; }
+
   /**
    * @brief run function
    *
@@ -29,27 +29,31 @@ void AdditionLayer::finalize(InitLayerContext &context) {
 void AdditionLayer::forwarding(RunLayerContext &context, bool training) {
   Tensor &hidden_ = context.getOutput(SINGLE_INOUT_IDX);
 
-  /** @todo check possibility for in-place of addition layer */
+  /** the output already holds the input it overwrites when run in-place */
+  unsigned int base_idx = 0;
+  while (base_idx < context.getNumInputs() &&
+         context.getInput(base_idx).getData() != hidden_.getData())
+    ++base_idx;
+
+  if (base_idx == context.getNumInputs()) {
+    base_idx = 0;
+    hidden_.copy(context.getInput(base_idx));
+  }
+
   for (unsigned int idx = 0; idx < context.getNumInputs(); ++idx) {
-    const Tensor &input_ = context.getInput(idx);
-    if (!idx) {
-      hidden_.copy(input_);
-    } else {
-      hidden_.add_i(input_);
-    }
+    if (idx != base_idx)
+      hidden_.add_i(context.getInput(idx));
   }
 }
 
 void AdditionLayer::calcDerivative(RunLayerContext &context) {
+  const Tensor &derivative_ = context.getIncomingDerivative(SINGLE_INOUT_IDX);
 
   for (unsigned int idx = 0; idx < context.getNumInputs(); ++idx) {
-    /**
-     * TODO: replace this with tensor assignment during optimization.
-     * Tensor assignement needs to make sure that the previous connected layers
-     * are not inplace
-     */
-    context.getOutgoingDerivative(idx).copy(
-      context.getIncomingDerivative(SINGLE_INOUT_IDX));
+    Tensor &ret_ = context.getOutgoingDerivative(idx);
+    /** the derivative is aliased with the incoming one by the optimization */
+    if (ret_.getData() != derivative_.getData())
+      ret_.copy(derivative_);
   }
 }
 
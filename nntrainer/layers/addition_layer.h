@@ -67,6 +67,12 @@ public:
    */
   bool supportBackwarding() const override { return true; };
 
+  /**
+   * @copydoc Layer::supportInPlace()
+   * @note the output can overwrite one of the inputs
+   */
+  bool supportInPlace() const override { return true; }
+
   /**
    * @copydoc Layer::exportTo(Exporter &exporter, ExportMethods method)
    */
@@ -193,9 +193,8 @@ void BatchNormalizationLayer::forwarding(RunLayerContext &context,
     invstd.pow_i(-0.5f);
   }
 
-  deviation.multiply(invstd, hidden_);
-  hidden_.multiply_i(gamma);
-  hidden_.add_i(beta);
+  deviation.chain().multiply_i(invstd).multiply_i(gamma).add_i(beta).run(
+    hidden_);
 }
 
 void BatchNormalizationLayer::calcDerivative(RunLayerContext &context) {
@@ -232,11 +231,12 @@ void BatchNormalizationLayer::calcDerivative(RunLayerContext &context) {
     deriv.average(axes_to_reduce, t_reduced);
   }
 
-  deriv.subtract(t_reduced, dx);
-  dx.subtract_i(deviation);
-
-  invstd.multiply_i(gamma);
-  dx.multiply_i(invstd);
+  deriv.chain()
+    .subtract_i(t_reduced)
+    .subtract_i(deviation)
+    .multiply_i(invstd)
+    .multiply_i(gamma)
+    .run(dx);
 }
 
 void BatchNormalizationLayer::calcGradient(RunLayerContext &context) {
@@ -116,6 +116,14 @@ PoolSize::PoolSize(unsigned int value) { set(value); }
 
 Stride::Stride(unsigned int value) { set(value); }
 
+Dilation::Dilation(unsigned int value) { set(value); }
+
+Im2ColBatch::Im2ColBatch(unsigned int value) { set(value); }
+
+FusedBatchNorm::FusedBatchNorm(bool value) { set(value); }
+
+Quantized::Quantized(bool value) { set(value); }
+
 /**
  * @brief unsigned integer property, internally used to parse padding values
  *
@@ -152,7 +160,8 @@ bool Padding2D::isValid(const std::string &v) const {
 
 std::array<unsigned int, 4>
 Padding2D::compute(const TensorDim &input, const TensorDim &kernel,
-                   const std::array<unsigned int, 2> &strides) {
+                   const std::array<unsigned int, 2> &strides,
+                   const std::array<unsigned int, 2> &dilation) {
   auto &padding_repr = get(); /// padding representation
 
   if (istrequal(padding_repr, "valid")) {
@@ -163,21 +172,20 @@ Padding2D::compute(const TensorDim &input, const TensorDim &kernel,
   /// possible. otherwise pad_all_side / 2 is allocated to top | left and rest
   /// are assigned to the other side
   if (istrequal(padding_repr, "same")) {
-    /// @note if we start to consider dilation, this calculation has to tuned
-    /// accordingly.
-
     auto calculate_padding = [](unsigned input_, unsigned kernel_,
-                                unsigned stride) {
+                                unsigned stride, unsigned dilation_) {
       /// ceil(input / stride)
       auto out = (input_ + stride - 1) / stride;
-      auto req_input = (out - 1) * stride + kernel_;
+      /// effective kernel size considering dilation
+      auto eff_kernel = (kernel_ - 1) * dilation_ + 1;
+      auto req_input = (out - 1) * stride + eff_kernel;
       return req_input >= input_ ? req_input - input_ : 0;
     };
 
-    auto pad_horizontal =
-      calculate_padding(input.width(), kernel.width(), strides[1]);
-    auto pad_vertical =
-      calculate_padding(input.height(), kernel.height(), strides[0]);
+    auto pad_horizontal = calculate_padding(input.width(), kernel.width(),
+                                            strides[1], dilation[1]);
+    auto pad_vertical = calculate_padding(input.height(), kernel.height(),
+                                          strides[0], dilation[0]);
 
     auto pad_top = pad_vertical / 2;
     auto pad_left = pad_horizontal / 2;
@@ -268,6 +276,10 @@ RecurrentActivation::RecurrentActivation(ActivationTypeInfo::Enum value) {
   set(value);
 };
 
+FusedActivation::FusedActivation(ActivationTypeInfo::Enum value) {
+  set(value);
+};
+
 WeightInitializer::WeightInitializer(Tensor::Initializer value) { set(value); }
 
 BiasInitializer::BiasInitializer(Tensor::Initializer value) { set(value); }
@@ -369,6 +369,58 @@ public:
   using prop_tag = uint_prop_tag;                   /**< property type */
 };
 
+/**
+ * @brief Im2ColBatch property, number of samples lowered to a single column
+ * matrix in the convolution. 1 lowers a sample at a time which is memory
+ * lean, while larger values issue a single bigger GEMM for multiple samples at
+ * the expense of the memory
+ *
+ */
+class Im2ColBatch : public nntrainer::PositiveIntegerProperty {
+public:
+  /**
+   * @brief Construct a new Im2ColBatch object with a default value 1
+   *
+   */
+  Im2ColBatch(unsigned int value = 1);
+  static constexpr const char *key =
+    "im2col_batch";               /**< unique key to access */
+  using prop_tag = uint_prop_tag; /**< property type */
+};
+
+/**
+ * @brief FusedBatchNorm property, batch normalization following the layer is
+ * folded into the weight and bias of the layer at inference
+ *
+ */
+class FusedBatchNorm : public nntrainer::Property<bool> {
+public:
+  /**
+   * @brief Construct a new FusedBatchNorm object with a default value false
+   *
+   */
+  FusedBatchNorm(bool value = false);
+  static constexpr const char *key =
+    "fused_batch_norm";           /**< unique key to access */
+  using prop_tag = bool_prop_tag; /**< property type */
+};
+
+/**
+ * @brief Quantized property, the weight of the layer is packed in int8 and the
+ * inference runs in int8
+ *
+ */
+class Quantized : public nntrainer::Property<bool> {
+public:
+  /**
+   * @brief Construct a new Quantized object with a default value false
+   *
+   */
+  Quantized(bool value = false);
+  static constexpr const char *key = "quantized"; /**< unique key to access */
+  using prop_tag = bool_prop_tag;                 /**< property type */
+};
+
 /**
  * @brief PoolSize property, pool size is used to measure the pooling size
  *
@@ -406,6 +458,22 @@ public:
   using prop_tag = uint_prop_tag;              /**< property type */
 };
 
+/**
+ * @brief Dilation property, dilation is the spacing between the elements of
+ * the kernel
+ *
+ */
+class Dilation : public nntrainer::PositiveIntegerProperty {
+public:
+  /**
+   * @brief Construct a new Dilation object with a default value 1
+   *
+   */
+  Dilation(unsigned int value = 1);
+  static constexpr const char *key = "dilation"; /**< unique key to access */
+  using prop_tag = uint_prop_tag;                /**< property type */
+};
+
 /**
  * @brief Padding2D property, this is used to calculate padding2D
  * @details Padding2D is saved as a string. Upon calling Padding2D::compute,
@@ -437,11 +505,13 @@ public:
    * @param input input dimension
    * @param kernel kernel dimension
    * @param stride stride
+   * @param dilation dilation of the kernel
    * @return std::array<unsigned int, 4> list of unsigned padding
    */
   std::array<unsigned int, 4>
   compute(const TensorDim &input, const TensorDim &kernel,
-          const std::array<unsigned int, 2> &strides);
+          const std::array<unsigned int, 2> &strides,
+          const std::array<unsigned int, 2> &dilation = {1, 1});
 };
 
 /**
@@ -790,6 +860,24 @@ public:
   static constexpr const char *key = "recurrent_activation";
 };
 
+/**
+ * @brief FusedActivation Enumeration Information, activation applied in the
+ * epilogue of the layer together with the bias
+ *
+ */
+class FusedActivation final : public EnumProperty<ActivationTypeInfo> {
+public:
+  /**
+   * @brief Construct a new FusedActivation object with default value
+   * ActivationTypeInfo::Enum::ACT_NONE
+   *
+   */
+  FusedActivation(
+    ActivationTypeInfo::Enum value = ActivationTypeInfo::Enum::ACT_NONE);
+  using prop_tag = enum_class_prop_tag;
+  static constexpr const char *key = "fused_activation";
+};
+
 /**
  * @brief     Enumeration of tensor initialization type
  */
@@ -111,10 +111,6 @@ void ConcatLayer::finalize(InitLayerContext &context) {
 }
 
 void ConcatLayer::forwarding(RunLayerContext &context, bool training) {
-  /**
-   * @todo avoid copy by creating input here as a shared_tensor of the output
-   * here and then this layer can be in_place as well
-   */
   Tensor &output = context.getOutput(SINGLE_INOUT_IDX);
 
   const TensorDim out_dim = output.getDim();
@@ -124,8 +120,15 @@ void ConcatLayer::forwarding(RunLayerContext &context, bool training) {
 
   for (unsigned int idx = 0; idx < context.getNumInputs(); idx++) {
     Tensor &input = context.getInput(idx);
-    const TensorDim in_dim = input.getDim();
     auto const &irh = input_reshape_helper[idx];
+    if (input.getData() ==
+        output.getAddress(0, 0, output_height_offset, 0)) {
+      /** already placed in the output by the in-place optimization */
+      output_height_offset += irh.height();
+      continue;
+    }
+
+    const TensorDim in_dim = input.getDim();
     input.reshape(irh);
 
     /** loop over the dimensions before the concat dimension */
@@ -150,10 +153,6 @@ void ConcatLayer::forwarding(RunLayerContext &context, bool training) {
 }
 
 void ConcatLayer::calcDerivative(RunLayerContext &context) {
-  /**
-   * @todo avoid copy by creating input here as a shared_tensor of the output
-   * here and then this layer can be in_place as well
-   */
   Tensor &output = context.getIncomingDerivative(SINGLE_INOUT_IDX);
 
   const TensorDim out_dim = output.getDim();
@@ -163,8 +162,15 @@ void ConcatLayer::calcDerivative(RunLayerContext &context) {
 
   for (unsigned int idx = 0; idx < context.getNumInputs(); idx++) {
     Tensor &input = context.getOutgoingDerivative(idx);
-    const TensorDim in_dim = input.getDim();
     auto const &irh = input_reshape_helper[idx];
+    if (input.getData() ==
+        output.getAddress(0, 0, output_height_offset, 0)) {
+      /** already placed in the output by the in-place optimization */
+      output_height_offset += irh.height();
+      continue;
+    }
+
+    const TensorDim in_dim = input.getDim();
     input.reshape(irh);
 
     /** loop over the dimensions before the concat dimension */
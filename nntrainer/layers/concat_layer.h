@@ -78,6 +78,12 @@ public:
    */
   bool supportBackwarding() const override { return true; }
 
+  /**
+   * @copydoc Layer::supportInPlace()
+   * @note the inputs can be placed in the output without copying
+   */
+  bool supportInPlace() const override { return true; }
+
   /**
    * @copydoc Layer::setProperty(const PropertyType type, const std::string
    * &value)
@@ -0,0 +1,258 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   conv2d_kernels.cpp
+ * @date   16 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  Convolution kernels which do not lower the input with im2col
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <conv2d_kernels.h>
+
+namespace nntrainer {
+
+/// number of output channels computed together in the direct convolution
+static constexpr unsigned int DIRECT_FILTER_BLOCK = 4;
+
+ConvAlgorithm selectConvAlgorithm(const std::array<unsigned int, 2> &kernel,
+                                  const std::array<unsigned int, 2> &stride,
+                                  const std::array<unsigned int, 2> &dilation) {
+  if (kernel[0] != 3 || kernel[1] != 3)
+    return ConvAlgorithm::IM2COL;
+
+  if (stride[0] == 1 && stride[1] == 1 && dilation[0] == 1 && dilation[1] == 1)
+    return ConvAlgorithm::WINOGRAD;
+
+  return ConvAlgorithm::DIRECT;
+}
+
+void winogradTransformFilter(const float *filter, unsigned int filters,
+                             unsigned int channels, float *u) {
+  unsigned int stride = filters * channels;
+
+  for (unsigned int k = 0; k < filters; ++k) {
+    for (unsigned int c = 0; c < channels; ++c) {
+      const float *g = filter + (k * channels + c) * 9;
+
+      /// tmp = G g, [4 x 3]
+      float tmp[4][3];
+      for (unsigned int j = 0; j < 3; ++j) {
+        tmp[0][j] = g[j];
+        tmp[1][j] = (g[j] + g[3 + j] + g[6 + j]) * 0.5f;
+        tmp[2][j] = (g[j] - g[3 + j] + g[6 + j]) * 0.5f;
+        tmp[3][j] = g[6 + j];
+      }
+
+      /// U = tmp G^T, [4 x 4]
+      float *dst = u + k * channels + c;
+      for (unsigned int i = 0; i < 4; ++i) {
+        dst[(i * 4 + 0) * stride] = tmp[i][0];
+        dst[(i * 4 + 1) * stride] = (tmp[i][0] + tmp[i][1] + tmp[i][2]) * 0.5f;
+        dst[(i * 4 + 2) * stride] = (tmp[i][0] - tmp[i][1] + tmp[i][2]) * 0.5f;
+        dst[(i * 4 + 3) * stride] = tmp[i][2];
+      }
+    }
+  }
+}
+
+void winogradTransformInput(const float *in, unsigned int channels,
+                            unsigned int height, unsigned int width,
+                            unsigned int pad_top, unsigned int pad_left,
+                            unsigned int tiles_h, unsigned int tiles_w,
+                            float *v) {
+  unsigned int num_tiles = tiles_h * tiles_w;
+  unsigned int stride = channels * num_tiles;
+  int in_height = height;
+  int in_width = width;
+
+  for (unsigned int c = 0; c < channels; ++c) {
+    const float *in_c = in + c * height * width;
+
+    for (unsigned int th = 0; th < tiles_h; ++th) {
+      int h_begin = (int)(th * WINOGRAD_OUT_TILE) - (int)pad_top;
+
+      for (unsigned int tw = 0; tw < tiles_w; ++tw) {
+        int w_begin = (int)(tw * WINOGRAD_OUT_TILE) - (int)pad_left;
+
+        /// load the 4x4 tile, zero outside of the input
+        float d[4][4];
+        if (h_begin >= 0 && w_begin >= 0 && h_begin + 4 <= in_height &&
+            w_begin + 4 <= in_width) {
+          for (unsigned int i = 0; i < 4; ++i)
+            std::memcpy(d[i], in_c + (h_begin + i) * width + w_begin,
+                        4 * sizeof(float));
+        } else {
+          for (int i = 0; i < 4; ++i) {
+            int h = h_begin + i;
+            for (int j = 0; j < 4; ++j) {
+              int w = w_begin + j;
+              d[i][j] = (h < 0 || h >= in_height || w < 0 || w >= in_width)
+                          ? 0.0f
+                          : in_c[h * width + w];
+            }
+          }
+        }
+
+        /// tmp = B^T d
+        float tmp[4][4];
+        for (unsigned int j = 0; j < 4; ++j) {
+          tmp[0][j] = d[0][j] - d[2][j];
+          tmp[1][j] = d[1][j] + d[2][j];
+          tmp[2][j] = d[2][j] - d[1][j];
+          tmp[3][j] = d[1][j] - d[3][j];
+        }
+
+        /// V = tmp B
+        float *dst = v + c * num_tiles + th * tiles_w + tw;
+        for (unsigned int i = 0; i < 4; ++i) {
+          dst[(i * 4 + 0) * stride] = tmp[i][0] - tmp[i][2];
+          dst[(i * 4 + 1) * stride] = tmp[i][1] + tmp[i][2];
+          dst[(i * 4 + 2) * stride] = tmp[i][2] - tmp[i][1];
+          dst[(i * 4 + 3) * stride] = tmp[i][1] - tmp[i][3];
+        }
+      }
+    }
+  }
+}
+
+void winogradTransformOutput(const float *m, unsigned int filters,
+                             unsigned int tiles_h, unsigned int tiles_w,
+                             unsigned int out_height, unsigned int out_width,
+                             float *out) {
+  unsigned int num_tiles = tiles_h * tiles_w;
+  unsigned int stride = filters * num_tiles;
+
+  for (unsigned int k = 0; k < filters; ++k) {
+    float *out_k = out + k * out_height * out_width;
+
+    for (unsigned int th = 0; th < tiles_h; ++th) {
+      unsigned int h = th * WINOGRAD_OUT_TILE;
+      unsigned int h_size = std::min(WINOGRAD_OUT_TILE, out_height - h);
+
+      for (unsigned int tw = 0; tw < tiles_w; ++tw) {
+        unsigned int w = tw * WINOGRAD_OUT_TILE;
+        unsigned int w_size = std::min(WINOGRAD_OUT_TILE, out_width - w);
+
+        const float *src = m + k * num_tiles + th * tiles_w + tw;
+        float s[4][4];
+        for (unsigned int i = 0; i < WINOGRAD_TILE_ELEMS; ++i)
+          s[i / 4][i % 4] = src[i * stride];
+
+        /// tmp = A^T m
+        float tmp[2][4];
+        for (unsigned int j = 0; j < 4; ++j) {
+          tmp[0][j] = s[0][j] + s[1][j] + s[2][j];
+          tmp[1][j] = s[1][j] - s[2][j] - s[3][j];
+        }
+
+        /// Y = tmp A
+        float y[2][2];
+        for (unsigned int i = 0; i < 2; ++i) {
+          y[i][0] = tmp[i][0] + tmp[i][1] + tmp[i][2];
+          y[i][1] = tmp[i][1] - tmp[i][2] - tmp[i][3];
+        }
+
+        for (unsigned int i = 0; i < h_size; ++i)
+          for (unsigned int j = 0; j < w_size; ++j)
+            out_k[(h + i) * out_width + w + j] = y[i][j];
+      }
+    }
+  }
+}
+
+/**
+ * @brief get the width of a plane of the padded row split by the stride
+ */
+static unsigned int getPlaneWidth(unsigned int width,
+                                  const std::array<unsigned int, 4> &padding,
+                                  unsigned int stride) {
+  return (width + padding[2] + padding[3] + stride - 1) / stride;
+}
+
+size_t directConv2DScratchSize(unsigned int channels, unsigned int height,
+                               unsigned int width,
+                               const std::array<unsigned int, 4> &padding,
+                               const std::array<unsigned int, 2> &stride) {
+  return static_cast<size_t>(channels) * height * stride[1] *
+         getPlaneWidth(width, padding, stride[1]);
+}
+
+void directConv2D(const float *in, unsigned int channels, unsigned int height,
+                  unsigned int width, const float *filter,
+                  unsigned int filters, unsigned int k_height,
+                  unsigned int k_width,
+                  const std::array<unsigned int, 4> &padding,
+                  const std::array<unsigned int, 2> &stride,
+                  const std::array<unsigned int, 2> &dilation,
+                  unsigned int out_height, unsigned int out_width,
+                  float *scratch, float *out) {
+  int pt = padding[0];
+  int pl = padding[2];
+  unsigned int sh = stride[0];
+  unsigned int sw = stride[1];
+  unsigned int dh = dilation[0];
+  unsigned int dw = dilation[1];
+  int in_height = height;
+  int in_width = width;
+  unsigned int plane_width = getPlaneWidth(width, padding, sw);
+  unsigned int row_len = sw * plane_width;
+  unsigned int out_len = out_height * out_width;
+  unsigned int k_len = k_height * k_width;
+
+  /// column x of the plane p holds the column x * sw + p of the padded row
+  for (unsigned int r = 0; r < channels * height; ++r) {
+    const float *in_row = in + r * width;
+    float *row = scratch + r * row_len;
+    for (unsigned int p = 0; p < sw; ++p) {
+      float *plane = row + p * plane_width;
+      for (unsigned int x = 0; x < plane_width; ++x) {
+        int w = (int)(x * sw + p) - pl;
+        plane[x] = (w < 0 || w >= in_width) ? 0.0f : in_row[w];
+      }
+    }
+  }
+
+  std::fill(out, out + filters * out_len, 0.0f);
+
+  for (unsigned int k0 = 0; k0 < filters; k0 += DIRECT_FILTER_BLOCK) {
+    unsigned int kb = std::min(DIRECT_FILTER_BLOCK, filters - k0);
+
+    for (unsigned int c = 0; c < channels; ++c) {
+      const float *in_c = scratch + c * height * row_len;
+
+      for (unsigned int i = 0; i < k_height; ++i) {
+        for (unsigned int j = 0; j < k_width; ++j) {
+          /// output column ow reads the column ow + j * dw / sw of the plane
+          unsigned int phase = (j * dw) % sw;
+          unsigned int shift = (j * dw) / sw;
+
+          for (unsigned int oh = 0; oh < out_height; ++oh) {
+            int h = (int)(oh * sh + i * dh) - pt;
+            if (h < 0 || h >= in_height)
+              continue;
+
+            const float *in_row =
+              in_c + h * row_len + phase * plane_width + shift;
+
+            for (unsigned int kk = 0; kk < kb; ++kk) {
+              float w =
+                filter[((k0 + kk) * channels + c) * k_len + i * k_width + j];
+              float *out_row = out + (k0 + kk) * out_len + oh * out_width;
+
+              for (unsigned int ow = 0; ow < out_width; ++ow)
+                out_row[ow] += w * in_row[ow];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+} // namespace nntrainer
@@ -0,0 +1,153 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   conv2d_kernels.h
+ * @date   16 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  Convolution kernels which do not lower the input with im2col
+ *
+ */
+
+#ifndef __CONV2D_KERNELS_H__
+#define __CONV2D_KERNELS_H__
+#ifdef __cplusplus
+
+#include <array>
+#include <cstddef>
+
+namespace nntrainer {
+
+/**
+ * @brief algorithm to compute the convolution in the forwarding
+ */
+enum class ConvAlgorithm {
+  IM2COL,   /**< lower the input with im2col and run a GEMM */
+  WINOGRAD, /**< winograd F(2x2, 3x3) */
+  DIRECT    /**< cache blocked direct convolution */
+};
+
+/**
+ * @brief number of elements of the transformed tile of winograd F(2x2, 3x3)
+ */
+constexpr const unsigned int WINOGRAD_TILE_ELEMS = 16;
+
+/**
+ * @brief size of the output tile of winograd F(2x2, 3x3)
+ */
+constexpr const unsigned int WINOGRAD_OUT_TILE = 2;
+
+/**
+ * @brief select the algorithm for the given convolution
+ * @details winograd is selected for 3x3 kernels with stride 1 and dilation 1,
+ * direct convolution for the rest of 3x3 kernels, and im2col otherwise.
+ *
+ * @param kernel kernel size, height and width
+ * @param stride stride, height and width
+ * @param dilation dilation, height and width
+ * @return ConvAlgorithm selected algorithm
+ */
+ConvAlgorithm selectConvAlgorithm(const std::array<unsigned int, 2> &kernel,
+                                  const std::array<unsigned int, 2> &stride,
+                                  const std::array<unsigned int, 2> &dilation);
+
+/**
+ * @brief transform 3x3 filters to the winograd domain, U = G g G^T
+ *
+ * @param[in] filter filter of [filters, channels, 3, 3]
+ * @param[in] filters number of filters
+ * @param[in] channels number of input channels
+ * @param[out] u transformed filter of [16, filters, channels]
+ */
+void winogradTransformFilter(const float *filter, unsigned int filters,
+                             unsigned int channels, float *u);
+
+/**
+ * @brief transform the 4x4 input tiles to the winograd domain, V = B^T d B
+ *
+ * @param[in] in input of [channels, height, width]
+ * @param[in] channels number of channels
+ * @param[in] height height of the input
+ * @param[in] width width of the input
+ * @param[in] pad_top padding on the top
+ * @param[in] pad_left padding on the left
+ * @param[in] tiles_h number of the tiles along the height
+ * @param[in] tiles_w number of the tiles along the width
+ * @param[out] v transformed input of [16, channels, tiles_h * tiles_w]
+ */
+void winogradTransformInput(const float *in, unsigned int channels,
+                            unsigned int height, unsigned int width,
+                            unsigned int pad_top, unsigned int pad_left,
+                            unsigned int tiles_h, unsigned int tiles_w,
+                            float *v);
+
+/**
+ * @brief transform the products back to the 2x2 output tiles, Y = A^T m A
+ *
+ * @param[in] m product of U and V of [16, filters, tiles_h * tiles_w]
+ * @param[in] filters number of filters
+ * @param[in] tiles_h number of the tiles along the height
+ * @param[in] tiles_w number of the tiles along the width
+ * @param[in] out_height height of the output
+ * @param[in] out_width width of the output
+ * @param[out] out output of [filters, out_height, out_width]
+ */
+void winogradTransformOutput(const float *m, unsigned int filters,
+                             unsigned int tiles_h, unsigned int tiles_w,
+                             unsigned int out_height, unsigned int out_width,
+                             float *out);
+
+/**
+ * @brief get the number of elements of the scratch for directConv2D
+ *
+ * @param channels number of channels
+ * @param height height of the input
+ * @param width width of the input
+ * @param padding padding of top, bottom, left, right
+ * @param stride stride, height and width
+ * @return size_t number of elements of the scratch
+ */
+size_t directConv2DScratchSize(unsigned int channels, unsigned int height,
+                               unsigned int width,
+                               const std::array<unsigned int, 4> &padding,
+                               const std::array<unsigned int, 2> &stride);
+
+/**
+ * @brief direct convolution of a single sample
+ * @details each row of the input is padded and split into a plane per phase
+ * of the stride in @a scratch, so that the columns read by a kernel element
+ * are contiguous. Output channels are processed in blocks so that a row of
+ * the input is reused for the block while it is in the cache, and the
+ * innermost loop runs over a contiguous row of the input and the output.
+ *
+ * @param[in] in input of [channels, height, width]
+ * @param[in] channels number of channels
+ * @param[in] height height of the input
+ * @param[in] width width of the input
+ * @param[in] filter filter of [filters, channels, k_height, k_width]
+ * @param[in] filters number of filters
+ * @param[in] k_height height of the kernel
+ * @param[in] k_width width of the kernel
+ * @param[in] padding padding of top, bottom, left, right
+ * @param[in] stride stride, height and width
+ * @param[in] dilation dilation, height and width
+ * @param[in] out_height height of the output
+ * @param[in] out_width width of the output
+ * @param[in] scratch scratch of directConv2DScratchSize() elements
+ * @param[out] out output of [filters, out_height, out_width]
+ */
+void directConv2D(const float *in, unsigned int channels, unsigned int height,
+                  unsigned int width, const float *filter,
+                  unsigned int filters, unsigned int k_height,
+                  unsigned int k_width,
+                  const std::array<unsigned int, 4> &padding,
+                  const std::array<unsigned int, 2> &stride,
+                  const std::array<unsigned int, 2> &dilation,
+                  unsigned int out_height, unsigned int out_width,
+                  float *scratch, float *out);
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __CONV2D_KERNELS_H__ */
@@ -18,6 +18,8 @@
 
 #include <blas_interface.h>
 #include <conv2d_layer.h>
+#include <fusion_kernels.h>
+#include <int8_kernels.h>
 #include <layer_context.h>
 #include <lazy_tensor.h>
 #include <nntrainer_error.h>
@@ -48,12 +50,14 @@ static TensorDim calcCol2ImOutputDim(const TensorDim &out,
  * @param[in] mstride stride value : x, y direction
  * @param[in] dilation kernel dilation factor : x, y each
  * @param[out] image image tensor to put
+ * @param[in] col_offset column of the col_matrix where the image starts, used
+ * when the col_matrix holds multiple images side by side
  */
 static void col2im(const Tensor &col_matrix, const TensorDim &kdim,
                    const std::array<unsigned, 4> &padding,
                    const std::array<props::Stride, CONV2D_DIM> &mstride,
                    const std::array<unsigned, CONV2D_DIM> &dilation,
-                   Tensor &image) {
+                   Tensor &image, unsigned int col_offset = 0) {
   auto [pt, pb, pl, pr] = padding;
 
   unsigned k_height = kdim.height();
@@ -82,7 +86,7 @@ static void col2im(const Tensor &col_matrix, const TensorDim &kdim,
   int h_stride_end = im_eff_height - eff_k_height - pt;
   int w_stride_end = im_eff_width - eff_k_width - pl;
 
-  unsigned col_w = 0;
+  unsigned col_w = col_offset;
   for (int hs = -pt; hs <= h_stride_end; hs += hstride) {
     for (int ws = -pl; ws <= w_stride_end; ws += wstride) {
       unsigned col_h = 0;
@@ -239,17 +243,141 @@ static void im2col(const Tensor &in, const TensorDim &kdim,
   }
 }
 
+/**
+ * @brief     get the range of the batch handled by the given worker
+ *
+ * @param[in] batch total batch size
+ * @param[in] num_workers number of workers sharing the batch
+ * @param[in] worker index of the worker
+ * @return std::pair<unsigned, unsigned> begin and end(exclusive) of the range
+ * @note the batch is split into contiguous chunks so that the order of
+ * accumulation inside a chunk does not depend on the scheduling
+ */
+static std::pair<unsigned int, unsigned int>
+getBatchRange(unsigned int batch, unsigned int num_workers,
+              unsigned int worker) {
+  unsigned int chunk = batch / num_workers;
+  unsigned int remain = batch % num_workers;
+  unsigned int begin = worker * chunk + std::min(worker, remain);
+  unsigned int end = begin + chunk + (worker < remain ? 1 : 0);
+  return {begin, end};
+}
+
+/**
+ * @brief     gather samples of a batch into a single matrix
+ *
+ * @param[in] src tensor of [batch, channel, height, width]
+ * @param[in] begin index of the first sample to gather
+ * @param[in] count number of samples to gather
+ * @param[out] matrix matrix of [channel, count * height * width]
+ */
+static void packSamples(const Tensor &src, unsigned int begin,
+                        unsigned int count, Tensor &matrix) {
+  unsigned int channel = src.channel();
+  unsigned int len = src.height() * src.width();
+  const float *src_data = src.getData() + begin * channel * len;
+  float *mat_data = matrix.getData();
+
+  for (unsigned int i = 0; i < count; ++i) {
+    for (unsigned int c = 0; c < channel; ++c) {
+      const float *from = src_data + (i * channel + c) * len;
+      std::copy(from, from + len, mat_data + (c * count + i) * len);
+    }
+  }
+}
+
+/**
+ * @brief     scatter a matrix built by packSamples back to the samples
+ *
+ * @param[in] matrix matrix of [channel, count * height * width]
+ * @param[in] begin index of the first sample to scatter
+ * @param[in] count number of samples to scatter
+ * @param[out] dst tensor of [batch, channel, height, width]
+ */
+static void unpackSamples(const Tensor &matrix, unsigned int begin,
+                          unsigned int count, Tensor &dst) {
+  unsigned int channel = dst.channel();
+  unsigned int len = dst.height() * dst.width();
+  const float *mat_data = matrix.getData();
+  float *dst_data = dst.getData() + begin * channel * len;
+
+  for (unsigned int i = 0; i < count; ++i) {
+    for (unsigned int c = 0; c < channel; ++c) {
+      const float *from = mat_data + (c * count + i) * len;
+      std::copy(from, from + len, dst_data + (i * channel + c) * len);
+    }
+  }
+}
+
+/**
+ * @brief     winograd F(2x2, 3x3) convolution of a single sample
+ *
+ * @param[in] in input of [1, channel, height, width]
+ * @param[in] filter filter transformed by winogradTransformFilter
+ * @param[in] padding padding information
+ * @param[in] in_tile scratch to hold the transformed input
+ * @param[in] out_tile scratch to hold the product in the winograd domain
+ * @param[out] out output of [1, filters, out_height, out_width]
+ */
+static void winogradConv2D(const Tensor &in, const Tensor &filter,
+                           const std::array<unsigned, 4> &padding,
+                           Tensor &in_tile, Tensor &out_tile, Tensor &out) {
+  unsigned int channel = in.channel();
+  unsigned int filters = out.channel();
+  unsigned int tiles_h = (out.height() + 1) / WINOGRAD_OUT_TILE;
+  unsigned int tiles_w = (out.width() + 1) / WINOGRAD_OUT_TILE;
+  unsigned int tiles = tiles_h * tiles_w;
+
+  winogradTransformInput(in.getData(), channel, in.height(), in.width(),
+                         padding[0], padding[2], tiles_h, tiles_w,
+                         in_tile.getData());
+
+  /// element-wise product of the tiles turns into a GEMM per tile element
+  for (unsigned int i = 0; i < WINOGRAD_TILE_ELEMS; ++i) {
+    Tensor u =
+      filter.getSharedDataTensor({filters, channel}, i * filters * channel);
+    Tensor v =
+      in_tile.getSharedDataTensor({channel, tiles}, i * channel * tiles);
+    Tensor m =
+      out_tile.getSharedDataTensor({filters, tiles}, i * filters * tiles);
+    u.dot(v, m);
+  }
+
+  winogradTransformOutput(out_tile.getData(), filters, tiles_h, tiles_w,
+                          out.height(), out.width(), out.getData());
+}
+
 } // namespace
 
-enum ConvParams { weight, bias, inter_result };
+enum ConvParams {
+  weight,
+  bias,
+  inter_result,
+  partial_grad,
+  out_matrix,
+  direct_input,
+  winograd_input,
+  winograd_output,
+  mu,
+  var,
+  gamma,
+  beta
+};
 
 Conv2DLayer::Conv2DLayer(
   const std::array<unsigned int, CONV2D_DIM * 2> &padding_) :
   LayerImpl(),
   padding(padding_),
   conv_props(props::FilterSize(), std::array<props::KernelSize, CONV2D_DIM>(),
-             std::array<props::Stride, CONV2D_DIM>(), props::Padding2D()),
-  wt_idx({0}) {}
+             std::array<props::Stride, CONV2D_DIM>(), props::Padding2D(),
+             props::Im2ColBatch(), props::FusedActivation(),
+             props::FusedBatchNorm(), props::Epsilon(),
+             std::array<props::Dilation, CONV2D_DIM>(), props::Quantized()),
+  wt_idx({0}),
+  winograd_filter_valid(false),
+  num_workers(1),
+  micro_batch(1),
+  algorithm(ConvAlgorithm::IM2COL) {}
 
 void Conv2DLayer::finalize(InitLayerContext &context) {
   if (context.getNumInputs() != 1) {
@@ -270,13 +398,16 @@ void Conv2DLayer::finalize(InitLayerContext &context) {
   auto &kernel_size =
     std::get<std::array<props::KernelSize, CONV2D_DIM>>(conv_props);
   auto &stride = std::get<std::array<props::Stride, CONV2D_DIM>>(conv_props);
+  auto &dilation =
+    std::get<std::array<props::Dilation, CONV2D_DIM>>(conv_props);
 
   TensorDim dim =
     TensorDim(filter_size, in_dim.channel(), kernel_size[0], kernel_size[1]);
   TensorDim bias_dim = TensorDim(1, filter_size, 1, 1);
 
   padding = std::get<props::Padding2D>(conv_props)
-              .compute(in_dim, dim, {stride[0], stride[1]});
+              .compute(in_dim, dim, {stride[0], stride[1]},
+                       {dilation[0], dilation[1]});
 
   wt_idx[ConvParams::weight] =
     context.requestWeight(dim, weight_initializer, weight_regularizer,
@@ -284,51 +415,183 @@ void Conv2DLayer::finalize(InitLayerContext &context) {
   wt_idx[ConvParams::bias] = context.requestWeight(
     bias_dim, bias_initializer, WeightRegularizer::NONE, 1.0f, "bias", true);
 
+  NNTR_THROW_IF(std::get<props::Quantized>(conv_props) &&
+                  !canPackInt8(filter_size, dim.getFeatureLen()),
+                std::invalid_argument)
+    << "[Conv2D] filter is too small to be packed in int8";
+
+  auto fused_act = std::get<props::FusedActivation>(conv_props).get();
+  NNTR_THROW_IF(fused_act != ActivationType::ACT_NONE &&
+                  !isFusableActivation(fused_act),
+                std::invalid_argument)
+    << "[Conv2D] only relu, sigmoid and tanh can be fused";
+
+  if (std::get<props::FusedBatchNorm>(conv_props)) {
+    /// batch normalization normalizes the channels only when there are many
+    NNTR_THROW_IF(filter_size == 1, std::invalid_argument)
+      << "[Conv2D] batch normalization can not be fused with a single filter";
+
+    /// requested in the order of the batch normalization layer so that the
+    /// weights saved from the model before fusion can be loaded
+    wt_idx[ConvParams::mu] =
+      context.requestWeight(bias_dim, Tensor::Initializer::ZEROS,
+                            WeightRegularizer::NONE, 1.0f, "moving_mean", false);
+    wt_idx[ConvParams::var] = context.requestWeight(
+      bias_dim, Tensor::Initializer::ONES, WeightRegularizer::NONE, 1.0f,
+      "moving_variance", false);
+    wt_idx[ConvParams::gamma] =
+      context.requestWeight(bias_dim, Tensor::Initializer::ONES,
+                            WeightRegularizer::NONE, 1.0f, "gamma", false);
+    wt_idx[ConvParams::beta] =
+      context.requestWeight(bias_dim, Tensor::Initializer::ZEROS,
+                            WeightRegularizer::NONE, 1.0f, "beta", false);
+  }
+
   // this output_dim must be the same with dimension of hidden
   unsigned int eff_in_height = in_dim.height() + padding[0] + padding[1];
   unsigned int eff_in_width = in_dim.width() + padding[2] + padding[3];
 
-  TensorDim out_dim;
-  out_dim.batch(in_dim.batch());
-  out_dim.channel(filter_size);
-  out_dim.height((eff_in_height - kernel_size[0]) / stride[0] + 1);
-  out_dim.width((eff_in_width - kernel_size[1]) / stride[1] + 1);
-  context.setOutputDimensions({out_dim});
+  /// span of the kernel on the input, with the gaps of the dilation
+  unsigned int eff_k_height = (kernel_size[0] - 1) * dilation[0] + 1;
+  unsigned int eff_k_width = (kernel_size[1] - 1) * dilation[1] + 1;
 
-  if (eff_in_height < kernel_size[0] || eff_in_width < kernel_size[1]) {
+  if (eff_in_height < eff_k_height || eff_in_width < eff_k_width) {
     throw std::invalid_argument(
       "Failed to initialize: in size + padding is smaller than effective "
       "kernel");
   }
 
+  TensorDim out_dim;
+  out_dim.batch(in_dim.batch());
+  out_dim.channel(filter_size);
+  out_dim.height((eff_in_height - eff_k_height) / stride[0] + 1);
+  out_dim.width((eff_in_width - eff_k_width) / stride[1] + 1);
+  context.setOutputDimensions({out_dim});
+
   unsigned int IM = std::numeric_limits<int>::max();
 
-  if (eff_in_height - padding[0] - kernel_size[0] > IM ||
-      eff_in_width - padding[2] - kernel_size[1] > IM) {
+  if (eff_in_height - padding[0] - eff_k_height > IM ||
+      eff_in_width - padding[2] - eff_k_width > IM) {
     throw std::invalid_argument(
       "Failed to initialize: Calculated patch end is over int max");
   }
 
+  /**
+   * the batch is split among the workers, there is no use of having more
+   * workers than the samples in the batch.
+   */
+  num_workers = std::max(1u, std::min(context.getNumThreads(), in_dim.batch()));
+
+  /**
+   * samples lowered together by a worker, which can not be more than the
+   * chunk of the batch given to the worker.
+   */
+  unsigned int chunk = (in_dim.batch() + num_workers - 1) / num_workers;
+  micro_batch = std::min(
+    static_cast<unsigned int>(std::get<props::Im2ColBatch>(conv_props)), chunk);
+
   /**
    * @note: although col2im and im2col dims are different, the size of their
    * memories is same. If requested separately, both im2col and col2im result
    * memories will be valid in backwarding but used mutually exclusively.
    * So, requested both commonly.
    *
+   * @note: each worker owns a batch slice of the inter_result as its scratch
+   * buffer, so that the workers do not share the column matrix. The slice
+   * holds the column matrices of micro_batch samples.
+   *
    * @todo: the request has been split to forward and backward to allow reusing
    * this memory in between. This requires another setZero() in backwarding
    * which will be expensive.
    */
-  wt_idx[ConvParams::inter_result] = context.requestTensor(
-    calcCol2ImOutputDim(out_dim, dim), "inter_result",
-    Tensor::Initializer::NONE, false, TensorLifespan::ITERATION_LIFESPAN);
+  TensorDim col_dim = calcCol2ImOutputDim(out_dim, dim);
+  col_dim.batch(num_workers);
+  col_dim.channel(micro_batch);
+  wt_idx[ConvParams::inter_result] =
+    context.requestTensor(col_dim, "inter_result", Tensor::Initializer::NONE,
+                          false, TensorLifespan::ITERATION_LIFESPAN);
+
+  /**
+   * partial filter gradients of the workers other than the first one, which
+   * accumulates directly to the filter gradient. These are reduced in the
+   * order of the workers to keep the result deterministic.
+   */
+  if (num_workers > 1) {
+    wt_idx[ConvParams::partial_grad] = context.requestTensor(
+      TensorDim(num_workers - 1, 1, filter_size, dim.getFeatureLen()),
+      "partial_grad", Tensor::Initializer::NONE, false,
+      TensorLifespan::CALC_GRAD_LIFESPAN);
+  }
+
+  /**
+   * output (or incoming derivative) of the micro batch in the matrix form of
+   * [filter_size, micro_batch * out_height * out_width], so that a single
+   * GEMM covers all the samples of the micro batch.
+   */
+  if (micro_batch > 1) {
+    wt_idx[ConvParams::out_matrix] = context.requestTensor(
+      TensorDim(num_workers, 1, filter_size,
+                micro_batch * out_dim.height() * out_dim.width()),
+      "out_matrix", Tensor::Initializer::NONE, false,
+      TensorLifespan::ITERATION_LIFESPAN);
+  }
+
+  /**
+   * forwarding skips lowering the input when a specialized kernel fits the
+   * convolution, backwarding always goes through im2col.
+   */
+  algorithm = selectConvAlgorithm({kernel_size[0], kernel_size[1]},
+                                  {stride[0], stride[1]},
+                                  {dilation[0], dilation[1]});
+  if (algorithm == ConvAlgorithm::DIRECT) {
+    /// each worker rearranges its sample into the stride phases
+    size_t scratch = directConv2DScratchSize(
+      in_dim.channel(), in_dim.height(), in_dim.width(), padding,
+      {stride[0], stride[1]});
+    wt_idx[ConvParams::direct_input] = context.requestTensor(
+      TensorDim(num_workers, 1, 1, scratch), "direct_input",
+      Tensor::Initializer::NONE, false, TensorLifespan::FORWARD_FUNC_LIFESPAN);
+  } else if (algorithm == ConvAlgorithm::WINOGRAD) {
+    unsigned int tiles =
+      ((out_dim.height() + 1) / WINOGRAD_OUT_TILE) *
+      ((out_dim.width() + 1) / WINOGRAD_OUT_TILE);
+    /**
+     * the transformed filter only changes with the filter, so it is kept by
+     * the layer rather than requested for every forwarding
+     */
+    winograd_filter =
+      Tensor(TensorDim(1, WINOGRAD_TILE_ELEMS, filter_size, in_dim.channel()));
+    winograd_filter_valid = false;
+    wt_idx[ConvParams::winograd_input] = context.requestTensor(
+      TensorDim(num_workers, WINOGRAD_TILE_ELEMS, in_dim.channel(), tiles),
+      "winograd_input", Tensor::Initializer::NONE, false,
+      TensorLifespan::FORWARD_FUNC_LIFESPAN);
+    wt_idx[ConvParams::winograd_output] = context.requestTensor(
+      TensorDim(num_workers, WINOGRAD_TILE_ELEMS, filter_size, tiles),
+      "winograd_output", Tensor::Initializer::NONE, false,
+      TensorLifespan::FORWARD_FUNC_LIFESPAN);
+  }
 }
 
 void Conv2DLayer::forwarding(RunLayerContext &context, bool training) {
   int status = ML_ERROR_NONE;
 
+  auto fused_act = std::get<props::FusedActivation>(conv_props).get();
+  bool fused_bn = std::get<props::FusedBatchNorm>(conv_props);
+  bool quantized = std::get<props::Quantized>(conv_props);
+  NNTR_THROW_IF(training && (fused_bn || quantized ||
+                             fused_act != ActivationType::ACT_NONE),
+                std::invalid_argument)
+    << "[Conv2D] fused or quantized layer only supports inference";
+
+  /// the packed filter is folded before it is quantized
+  if (fused_bn && !quantized)
+    foldBatchNormalization(context);
+
   unsigned int filter_size = std::get<props::FilterSize>(conv_props);
   auto &stride = std::get<std::array<props::Stride, CONV2D_DIM>>(conv_props);
+  auto &dilation =
+    std::get<std::array<props::Dilation, CONV2D_DIM>>(conv_props);
 
   Tensor &input_ = context.getInput(SINGLE_INOUT_IDX);
   Tensor &hidden_ = context.getOutput(SINGLE_INOUT_IDX);
@@ -391,28 +654,167 @@ void Conv2DLayer::forwarding(RunLayerContext &context, bool training) {
   /**
    * Below sets the pad area values to zero
    * it is faster to do this way than seting selective area to zero
+   * calcGradient relies on this even if forwarding does not use im2col
    */
-  im2col_result.setZero();
-  for (unsigned int b = 0; b < in_dim.batch(); ++b) {
-    Tensor out = hidden_.getBatchSlice(b, 1);
-    out.reshape({filter_size, out_dim.width() * out_dim.height()});
+  if (algorithm == ConvAlgorithm::IM2COL || training || quantized)
+    im2col_result.setZero();
+  unsigned int batch = in_dim.batch();
+  unsigned int workers = std::min(num_workers, batch);
+  unsigned int out_len = out_dim.width() * out_dim.height();
+  unsigned int col_len = filter_dim.getFeatureLen();
+
+  if (quantized) {
+    /// the lowered input is quantized in place and multiplied with the int8
+    /// filter packed in the buffer of the filter
+    auto packed =
+      getInt8PackedWeight(filter_kernel.getData(), filter_size, col_len);
+    float input_scale = *packed.input_scale;
+
+#pragma omp parallel for num_threads(workers) schedule(static)
+    for (unsigned int t = 0; t < workers; ++t) {
+      Tensor col_sub = im2col_result.getBatchSlice(t, 1);
+      Tensor col = col_sub.getSharedDataTensor({out_len, col_len}, 0);
+      int8_t *quantized_col = reinterpret_cast<int8_t *>(col.getData());
+      auto [begin, end] = getBatchRange(batch, workers, t);
+
+      for (unsigned int b = begin; b < end; ++b) {
+        Tensor in_sub = input_.getBatchSlice(b, 1);
+        Tensor out = hidden_.getBatchSlice(b, 1);
+        /// the pad area is zeroed again, as it was overwritten by the int8
+        /// column matrix of the previous sample
+        if (b != begin)
+          col.setZero();
+        im2col(in_sub, filter_dim, padding, stride, {dilation[0], dilation[1]},
+               col);
+        quantizeSymmetric(col.getData(), col.size(), input_scale,
+                          quantized_col);
+        int8GemmNT(filter_size, out_len, col_len, packed.data, quantized_col,
+                   input_scale, packed.scales, nullptr, out.getData(),
+                   out_len);
+      }
+    }
+  } else if (algorithm == ConvAlgorithm::WINOGRAD) {
+    /**
+     * the filter changes with every update while training, otherwise the
+     * transform is reused until the weights are set again
+     */
+    if (training || !winograd_filter_valid) {
+      winogradTransformFilter(filter_kernel.getData(), filter_size,
+                              in_dim.channel(), winograd_filter.getData());
+      winograd_filter_valid = !training;
+    }
 
-    Tensor in_sub = input_.getBatchSlice(b, 1);
+#pragma omp parallel for num_threads(workers) schedule(static)
+    for (unsigned int t = 0; t < workers; ++t) {
+      Tensor in_tile = context.getTensor(wt_idx[ConvParams::winograd_input])
+                         .getBatchSlice(t, 1);
+      Tensor out_tile = context.getTensor(wt_idx[ConvParams::winograd_output])
+                          .getBatchSlice(t, 1);
+      auto [begin, end] = getBatchRange(batch, workers, t);
+
+      for (unsigned int b = begin; b < end; ++b) {
+        Tensor in_sub = input_.getBatchSlice(b, 1);
+        Tensor out = hidden_.getBatchSlice(b, 1);
+        winogradConv2D(in_sub, winograd_filter, padding, in_tile, out_tile,
+                       out);
+      }
+    }
+  } else if (algorithm == ConvAlgorithm::DIRECT) {
+#pragma omp parallel for num_threads(workers) schedule(static)
+    for (unsigned int t = 0; t < workers; ++t) {
+      Tensor scratch = context.getTensor(wt_idx[ConvParams::direct_input])
+                         .getBatchSlice(t, 1);
+      auto [begin, end] = getBatchRange(batch, workers, t);
+
+      for (unsigned int b = begin; b < end; ++b) {
+        Tensor in_sub = input_.getBatchSlice(b, 1);
+        Tensor out = hidden_.getBatchSlice(b, 1);
+        directConv2D(in_sub.getData(), in_dim.channel(), in_dim.height(),
+                     in_dim.width(), filter_kernel.getData(), filter_size,
+                     filter_dim.height(), filter_dim.width(), padding,
+                     {stride[0], stride[1]}, {dilation[0], dilation[1]},
+                     out_dim.height(), out_dim.width(), scratch.getData(),
+                     out.getData());
+      }
+    }
+  } else {
+#pragma omp parallel for num_threads(workers) schedule(static)
+    for (unsigned int t = 0; t < workers; ++t) {
+      Tensor col_sub = im2col_result.getBatchSlice(t, 1);
+      Tensor out_sub;
+      if (micro_batch > 1)
+        out_sub = context.getTensor(wt_idx[ConvParams::out_matrix])
+                    .getBatchSlice(t, 1);
+      auto [begin, end] = getBatchRange(batch, workers, t);
+
+      for (unsigned int b = begin; b < end; b += micro_batch) {
+        unsigned int mb = std::min(micro_batch, end - b);
+
+        /// lower the samples of the micro batch to a single column matrix
+        for (unsigned int i = 0; i < mb; ++i) {
+          Tensor in_sub = input_.getBatchSlice(b + i, 1);
+          Tensor col_i = col_sub.getSharedDataTensor({out_len, col_len},
+                                                     i * out_len * col_len);
+          im2col(in_sub, filter_dim, padding, stride,
+                 {dilation[0], dilation[1]}, col_i);
+        }
 
-    im2col(in_sub, filter_dim, padding, stride, {1, 1}, im2col_result);
-    filter_kernel.dot(im2col_result, out, false, true);
+        Tensor col = col_sub.getSharedDataTensor({mb * out_len, col_len}, 0);
+        if (mb == 1) {
+          Tensor out = hidden_.getBatchSlice(b, 1);
+          out.reshape({filter_size, out_len});
+          filter_kernel.dot(col, out, false, true);
+        } else {
+          Tensor out =
+            out_sub.getSharedDataTensor({filter_size, mb * out_len}, 0);
+          filter_kernel.dot(col, out, false, true);
+          unpackSamples(out, b, mb, hidden_);
+        }
+      }
+    }
   }
 
   filter_kernel.reshape(filter_dim);
-  status = hidden_.add_i(bias_kernel);
-  if (status != ML_ERROR_NONE) {
-    throw std::invalid_argument("[Conv2D] adding bias failed");
+  if (fused_act == ActivationType::ACT_NONE) {
+    status = hidden_.add_i(bias_kernel);
+    if (status != ML_ERROR_NONE) {
+      throw std::invalid_argument("[Conv2D] adding bias failed");
+    }
+    return;
+  }
+
+  /// bias and activation are applied together while the output is hot
+#pragma omp parallel for num_threads(workers) schedule(static)
+  for (unsigned int b = 0; b < batch; ++b) {
+    Tensor out = hidden_.getBatchSlice(b, 1);
+    biasActivation(out.getData(), bias_kernel.getData(), filter_size, out_len,
+                   true, fused_act);
   }
 }
 
+void Conv2DLayer::foldBatchNormalization(RunLayerContext &context) {
+  unsigned int filter_size = std::get<props::FilterSize>(conv_props);
+  Tensor &filter_kernel = context.getWeight(wt_idx[ConvParams::weight]);
+
+  bool folded = foldBatchNorm(
+    filter_kernel.getData(),
+    context.getWeight(wt_idx[ConvParams::bias]).getData(),
+    context.getWeight(wt_idx[ConvParams::mu]).getData(),
+    context.getWeight(wt_idx[ConvParams::var]).getData(),
+    context.getWeight(wt_idx[ConvParams::gamma]).getData(),
+    context.getWeight(wt_idx[ConvParams::beta]).getData(), filter_size,
+    filter_kernel.getDim().getFeatureLen(), true,
+    std::get<props::Epsilon>(conv_props));
+
+  if (folded)
+    winograd_filter_valid = false;
+}
+
 void Conv2DLayer::calcDerivative(RunLayerContext &context) {
   unsigned int filter_size = std::get<props::FilterSize>(conv_props);
   auto &stride = std::get<std::array<props::Stride, CONV2D_DIM>>(conv_props);
+  auto &dilation =
+    std::get<std::array<props::Dilation, CONV2D_DIM>>(conv_props);
 
   Tensor &derivative = context.getIncomingDerivative(SINGLE_INOUT_IDX);
   Tensor &input_derivative = context.getOutgoingDerivative(SINGLE_INOUT_IDX);
@@ -428,15 +830,43 @@ void Conv2DLayer::calcDerivative(RunLayerContext &context) {
   /// filter_kernel^T X derivaitive  -> column matrix
   /// col2im(column matrix) to reconstruct the original image
   Tensor &col2im_result = context.getTensor(wt_idx[ConvParams::inter_result]);
-  col2im_result.reshape(calcCol2ImOutputDim(derivative.getDim(), filter_dim));
+  unsigned int batch = derivative.batch();
+  unsigned int workers = std::min(num_workers, batch);
+  unsigned int out_len = derivative.width() * derivative.height();
+  unsigned int col_len = filter_dim.getFeatureLen();
+
+#pragma omp parallel for num_threads(workers) schedule(static)
+  for (unsigned int t = 0; t < workers; ++t) {
+    Tensor col_sub = col2im_result.getBatchSlice(t, 1);
+    Tensor out_sub;
+    if (micro_batch > 1)
+      out_sub = context.getTensor(wt_idx[ConvParams::out_matrix])
+                  .getBatchSlice(t, 1);
+    auto [begin, end] = getBatchRange(batch, workers, t);
+
+    for (unsigned int b = begin; b < end; b += micro_batch) {
+      unsigned int mb = std::min(micro_batch, end - b);
+
+      Tensor deriv_sub;
+      if (mb == 1) {
+        deriv_sub = derivative.getBatchSlice(b, 1);
+        deriv_sub.reshape({filter_size, out_len});
+      } else {
+        deriv_sub =
+          out_sub.getSharedDataTensor({filter_size, mb * out_len}, 0);
+        packSamples(derivative, b, mb, deriv_sub);
+      }
 
-  for (unsigned int b = 0; b < derivative.batch(); ++b) {
-    Tensor deriv_sub = derivative.getBatchSlice(b, 1);
-    Tensor in_deriv_sub = input_derivative.getBatchSlice(b, 1);
-    deriv_sub.reshape({filter_size, derivative.width() * derivative.height()});
+      /// column matrices of the micro batch lie side by side
+      Tensor col = col_sub.getSharedDataTensor({col_len, mb * out_len}, 0);
+      filter_kernel.dot(deriv_sub, col, true, false);
 
-    filter_kernel.dot(deriv_sub, col2im_result, true, false);
-    col2im(col2im_result, filter_dim, padding, stride, {1, 1}, in_deriv_sub);
+      for (unsigned int i = 0; i < mb; ++i) {
+        Tensor in_deriv_sub = input_derivative.getBatchSlice(b + i, 1);
+        col2im(col, filter_dim, padding, stride, {dilation[0], dilation[1]},
+               in_deriv_sub, i * out_len);
+      }
+    }
   }
 
   filter_kernel.reshape(filter_dim);
@@ -445,6 +875,8 @@ void Conv2DLayer::calcDerivative(RunLayerContext &context) {
 void Conv2DLayer::calcGradient(RunLayerContext &context) {
   unsigned int filter_size = std::get<props::FilterSize>(conv_props);
   auto &stride = std::get<std::array<props::Stride, CONV2D_DIM>>(conv_props);
+  auto &dilation =
+    std::get<std::array<props::Dilation, CONV2D_DIM>>(conv_props);
 
   Tensor &derivative = context.getIncomingDerivative(SINGLE_INOUT_IDX);
   Tensor &input_ = context.getInput(SINGLE_INOUT_IDX);
@@ -466,27 +898,100 @@ void Conv2DLayer::calcGradient(RunLayerContext &context) {
   TensorDim out_dim_squeezed{filter_size,
                              derivative.width() * derivative.height()};
 
+  unsigned int batch = input_.batch();
+  unsigned int workers = std::min(num_workers, batch);
+  unsigned int out_len = out_dim_squeezed.width();
+  unsigned int col_len = filter_dim_squeezed.width();
+
   /// input -(im2col)-> column_matrix -> filter x (column_matrix) = output
   /// so delK = dy x column_matrix ^ T;
-  for (unsigned int b = 0; b < input_.batch(); ++b) {
-    Tensor deriv_sub = derivative.getBatchSlice(b, 1);
-    deriv_sub.reshape(out_dim_squeezed);
+  /// each worker accumulates the gradient of its own chunk of the batch
+#pragma omp parallel for num_threads(workers) schedule(static)
+  for (unsigned int t = 0; t < workers; ++t) {
+    Tensor col_sub = im2col_result.getBatchSlice(t, 1);
+    Tensor out_sub;
+    if (micro_batch > 1)
+      out_sub = context.getTensor(wt_idx[ConvParams::out_matrix])
+                  .getBatchSlice(t, 1);
+    Tensor grad_sub =
+      t == 0 ? delK
+             : context.getTensor(wt_idx[ConvParams::partial_grad])
+                 .getBatchSlice(t - 1, 1);
+    grad_sub.reshape(filter_dim_squeezed);
+    auto [begin, end] = getBatchRange(batch, workers, t);
+
+    for (unsigned int b = begin; b < end; b += micro_batch) {
+      unsigned int mb = std::min(micro_batch, end - b);
+
+      Tensor deriv_sub;
+      if (mb == 1) {
+        deriv_sub = derivative.getBatchSlice(b, 1);
+        deriv_sub.reshape(out_dim_squeezed);
+      } else {
+        deriv_sub =
+          out_sub.getSharedDataTensor({filter_size, mb * out_len}, 0);
+        packSamples(derivative, b, mb, deriv_sub);
+      }
 
-    Tensor in_sub = input_.getBatchSlice(b, 1);
+      /**
+       * @todo this result can be cached from the forward iteration at the
+       * expense of memory. In this case, memory of im2col_result must be saved
+       * for the whole batch. try this while benchmarking.
+       */
+      for (unsigned int i = 0; i < mb; ++i) {
+        Tensor in_sub = input_.getBatchSlice(b + i, 1);
+        Tensor col_i = col_sub.getSharedDataTensor({out_len, col_len},
+                                                   i * out_len * col_len);
+        im2col(in_sub, filter_dim, padding, stride, {dilation[0], dilation[1]},
+               col_i);
+      }
 
-    /**
-     * @todo this result can be cached from the forward iteration at the
-     * expense of memory. In this case, memory of im2col_result must be saved
-     * for the whole batch. try this while benchmarking.
-     */
-    im2col(in_sub, filter_dim, padding, stride, {1, 1}, im2col_result);
-    deriv_sub.dot(im2col_result, delK, false, false, b == 0 ? 0 : 1);
+      Tensor col = col_sub.getSharedDataTensor({mb * out_len, col_len}, 0);
+      deriv_sub.dot(col, grad_sub, false, false, b == begin ? 0 : 1);
+    }
+  }
+
+  /// reduce the partial gradients in the order of the workers
+  for (unsigned int t = 1; t < workers; ++t) {
+    Tensor grad_sub = context.getTensor(wt_idx[ConvParams::partial_grad])
+                        .getBatchSlice(t - 1, 1);
+    grad_sub.reshape(filter_dim_squeezed);
+    delK.add_i(grad_sub);
   }
 
   delK.reshape(filter_dim);
   derivative.sum({0, 2, 3}, delBias);
 }
 
+void Conv2DLayer::quantize(RunLayerContext &context, float input_range) {
+  auto &quantized = std::get<props::Quantized>(conv_props);
+  /// the filter is packed already, as it is loaded from a quantized model
+  if (quantized)
+    return;
+
+  unsigned int filter_size = std::get<props::FilterSize>(conv_props);
+  Tensor &filter_kernel = context.getWeight(wt_idx[ConvParams::weight]);
+  unsigned int col_len = filter_kernel.getDim().getFeatureLen();
+  if (!canPackInt8(filter_size, col_len)) {
+    ml_logw("[Conv2D] filter is too small to be packed in int8, keep running "
+            "in fp32");
+    return;
+  }
+
+  if (std::get<props::FusedBatchNorm>(conv_props))
+    foldBatchNormalization(context);
+
+  /// each filter is a row of [channel * kernel_height * kernel_width]. The
+  /// fp32 filter is not kept, so the layer can not be trained any more
+  packInt8PerChannel(filter_kernel.getData(), filter_size, col_len, false,
+                     getInt8Scale(input_range));
+  quantized.set(true);
+}
+
+void Conv2DLayer::prepareWeights(RunLayerContext &context) {
+  winograd_filter_valid = false;
+}
+
 void Conv2DLayer::exportTo(Exporter &exporter,
                            const ExportMethods &method) const {
   LayerImpl::exportTo(exporter, method);
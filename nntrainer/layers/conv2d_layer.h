@@ -15,9 +15,12 @@
 #define __CONV2D_LAYER_H_
 #ifdef __cplusplus
 
+#include <cstdint>
 #include <memory.h>
+#include <vector>
 
 #include <common_properties.h>
+#include <conv2d_kernels.h>
 #include <layer_impl.h>
 
 namespace nntrainer {
@@ -96,6 +99,21 @@ public:
    */
   void setProperty(const std::vector<std::string> &values) override;
 
+  /**
+   * @copydoc Layer::supportQuantization()
+   */
+  bool supportQuantization() const override { return true; }
+
+  /**
+   * @copydoc Layer::quantize(RunLayerContext &context, float input_range)
+   */
+  void quantize(RunLayerContext &context, float input_range) override;
+
+  /**
+   * @copydoc Layer::prepareWeights(RunLayerContext &context)
+   */
+  void prepareWeights(RunLayerContext &context) override;
+
   /* TO DO : support keras type of padding */
   /* enum class PaddingType { */
   /*   full = 0, */
@@ -107,12 +125,28 @@ public:
   inline static const std::string type = "conv2d";
 
 private:
+  /**
+   * @brief fold the fused batch normalization into the filter and bias
+   *
+   * @param context context of the layer
+   */
+  void foldBatchNormalization(RunLayerContext &context);
+
   std::array<unsigned int, CONV2D_DIM * 2> padding;
   std::tuple<props::FilterSize, std::array<props::KernelSize, CONV2D_DIM>,
-             std::array<props::Stride, CONV2D_DIM>, props::Padding2D>
+             std::array<props::Stride, CONV2D_DIM>, props::Padding2D,
+             props::Im2ColBatch, props::FusedActivation, props::FusedBatchNorm,
+             props::Epsilon, std::array<props::Dilation, CONV2D_DIM>,
+             props::Quantized>
     conv_props;
 
-  std::array<unsigned int, 5> wt_idx; /**< indices of the weights and tensors */
+  std::array<unsigned int, 12>
+    wt_idx; /**< indices of the weights and tensors */
+  Tensor winograd_filter;     /**< filter transformed for winograd */
+  bool winograd_filter_valid; /**< winograd_filter is of the current filter */
+  unsigned int num_workers; /**< number of workers running over the batch */
+  unsigned int micro_batch; /**< number of samples lowered at once */
+  ConvAlgorithm algorithm;  /**< algorithm used in the forwarding */
 };
 
 } // namespace nntrainer
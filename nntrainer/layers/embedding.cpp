@@ -11,6 +11,11 @@
  *
  */
 
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include <blas_interface.h>
 #include <embedding.h>
 #include <layer_context.h>
 #include <lazy_tensor.h>
@@ -18,6 +23,7 @@
 #include <nntrainer_log.h>
 #include <node_exporter.h>
 #include <util_func.h>
+#include <weight.h>
 
 namespace nntrainer {
 
@@ -97,8 +103,10 @@ void EmbeddingLayer::forwarding(RunLayerContext &context, bool training) {
         throw std::invalid_argument("input word index is greater than in_dim");
       }
 
-      Tensor cur_weight = weight.getSharedDataTensor(out_tensor_dim, embed_idx);
-      Tensor out_tensor = hidden_.getSharedDataTensor(out_tensor_dim, i);
+      Tensor cur_weight =
+        weight.getSharedDataTensor(out_tensor_dim, embed_idx * out_dim);
+      Tensor out_tensor = hidden_.getSharedDataTensor(
+        out_tensor_dim, (b * input_.width() + i) * out_dim);
 
       /** if zero_mask_idx matches the given index, set the output to zero */
       if (!zero_mask_idx.empty() && embed_idx == zero_mask_idx.get()) {
@@ -119,14 +127,31 @@ void EmbeddingLayer::calcGradient(RunLayerContext &context) {
   unsigned int out_dim = std::get<props::OutDim>(embedding_props);
   auto &zero_mask_idx = std::get<props::ZeroIdxMask>(embedding_props);
 
+  Weight &weight = context.getWeightObject(weight_idx);
   Tensor &djdw = context.getWeightGrad(weight_idx);
   Tensor &derivative_ = context.getIncomingDerivative(SINGLE_INOUT_IDX);
   Tensor &input_ = context.getInput(SINGLE_INOUT_IDX);
-  TensorDim out_tensor_dim = TensorDim({1, 1, 1, out_dim});
 
-  // TODO:
-  // This is to calculate gradient with current implementation of optimizer.
-  // In order to accelerate, we need to better way like using index to weight.
+  /**
+   * The gradient is given only for the rows of the looked up words, so it is
+   * set as a sparse gradient of the weight. Repeated words accumulate to the
+   * same row. The values of the rows are packed at the front of the gradient
+   * tensor, which has room for all the rows of the weight.
+   *
+   * A shared weight accumulates over the accesses, the rows are merged to
+   * the sparse gradient of the access before, or added to the dense gradient
+   * when a layer before has set the dense one.
+   */
+  bool first_access = context.isGradientFirstAccess(weight_idx);
+  bool dense = !first_access && !weight.hasSparseGradient();
+
+  row_pos.clear();
+  sparse_rows.clear();
+  if (!first_access && !dense) {
+    sparse_rows = weight.getSparseGradientRows();
+    for (unsigned int i = 0; i < sparse_rows.size(); ++i)
+      row_pos.emplace(sparse_rows[i], i);
+  }
 
   for (unsigned int b = 0; b < input_.batch(); ++b) {
     uint *in_data =
@@ -135,17 +160,38 @@ void EmbeddingLayer::calcGradient(RunLayerContext &context) {
     for (unsigned int i = 0; i < input_.width(); ++i) {
       uint embed_idx = in_data[i];
 
-      Tensor cur_dw = djdw.getSharedDataTensor(out_tensor_dim, embed_idx);
-      Tensor in_derv = derivative_.getSharedDataTensor(out_tensor_dim, i);
+      /** if zero_mask_idx matches the given index, there is no gradient */
+      if (!zero_mask_idx.empty() && embed_idx == zero_mask_idx.get())
+        continue;
 
-      /** if zero_mask_idx matches the given index, set the grad to zero */
-      if (!zero_mask_idx.empty() && embed_idx == zero_mask_idx.get()) {
-        cur_dw.setZero();
+      const float *deriv =
+        derivative_.getAddress((b * input_.width() + i) * out_dim);
+      if (dense) {
+        saxpy(out_dim, 1.0f, deriv, 1, djdw.getAddress(embed_idx * out_dim),
+              1);
+        continue;
+      }
+
+      auto found = row_pos.emplace(embed_idx, sparse_rows.size());
+      float *row = djdw.getAddress(found.first->second * out_dim);
+      if (found.second) {
+        sparse_rows.push_back(embed_idx);
+        std::copy(deriv, deriv + out_dim, row);
       } else {
-        cur_dw.copyData(in_derv);
+        saxpy(out_dim, 1.0f, deriv, 1, row, 1);
       }
     }
   }
+
+  if (dense)
+    return;
+
+  Tensor values;
+  if (!sparse_rows.empty()) {
+    TensorDim values_dim(1, 1, sparse_rows.size(), out_dim);
+    values = djdw.getSharedDataTensor(values_dim, 0);
+  }
+  weight.setSparseGradient(sparse_rows, values);
 }
 
 void EmbeddingLayer::exportTo(Exporter &exporter,
@@ -15,6 +15,9 @@
 #define __EMBEDDING_H__
 #ifdef __cplusplus
 
+#include <unordered_map>
+#include <vector>
+
 #include <common_properties.h>
 #include <layer_impl.h>
 
@@ -97,6 +100,9 @@ public:
 private:
   std::tuple<props::InDim, props::OutDim, props::ZeroIdxMask> embedding_props;
   unsigned int weight_idx;
+  std::vector<unsigned int> sparse_rows; /**< rows of the sparse gradient */
+  std::unordered_map<unsigned int, unsigned int>
+    row_pos; /**< position of a row in the sparse gradient */
 };
 } // namespace nntrainer
 
@@ -22,6 +22,8 @@
  */
 
 #include <fc_layer.h>
+#include <fusion_kernels.h>
+#include <int8_kernels.h>
 #include <layer_context.h>
 #include <lazy_tensor.h>
 #include <nntrainer_error.h>
@@ -33,7 +35,7 @@ namespace nntrainer {
 
 static constexpr size_t SINGLE_INOUT_IDX = 0;
 
-enum FCParams { weight, bias };
+enum FCParams { weight, bias, mu, var, gamma, beta };
 
 void FullyConnectedLayer::finalize(InitLayerContext &context) {
   auto &weight_regularizer =
@@ -73,6 +75,41 @@ void FullyConnectedLayer::finalize(InitLayerContext &context) {
 
   weight_idx[FCParams::bias] = context.requestWeight(
     bias_dim, bias_initializer, WeightRegularizer::NONE, 1.0f, "bias", true);
+
+  auto fused_act = std::get<props::FusedActivation>(fc_props).get();
+  NNTR_THROW_IF(fused_act != ActivationType::ACT_NONE &&
+                  !isFusableActivation(fused_act),
+                std::invalid_argument)
+    << "[FC] only relu, sigmoid and tanh can be fused";
+
+  if (std::get<props::FusedBatchNorm>(fc_props)) {
+    /// batch normalization normalizes the unit only when there is no channel
+    NNTR_THROW_IF(in_dim.channel() != 1, std::invalid_argument)
+      << "[FC] batch normalization can not be fused with channels";
+
+    /// requested in the order of the batch normalization layer so that the
+    /// weights saved from the model before fusion can be loaded
+    weight_idx[FCParams::mu] =
+      context.requestWeight(bias_dim, Tensor::Initializer::ZEROS,
+                            WeightRegularizer::NONE, 1.0f, "moving_mean", false);
+    weight_idx[FCParams::var] = context.requestWeight(
+      bias_dim, Tensor::Initializer::ONES, WeightRegularizer::NONE, 1.0f,
+      "moving_variance", false);
+    weight_idx[FCParams::gamma] =
+      context.requestWeight(bias_dim, Tensor::Initializer::ONES,
+                            WeightRegularizer::NONE, 1.0f, "gamma", false);
+    weight_idx[FCParams::beta] =
+      context.requestWeight(bias_dim, Tensor::Initializer::ZEROS,
+                            WeightRegularizer::NONE, 1.0f, "beta", false);
+  }
+
+  num_threads = context.getNumThreads();
+
+  if (std::get<props::Quantized>(fc_props)) {
+    NNTR_THROW_IF(!canPackInt8(unit, in_dim.width()), std::invalid_argument)
+      << "[FC] weight is too small to be packed in int8";
+    quantized_input.resize(in_dim.getDataLen());
+  }
 }
 
 void FullyConnectedLayer::exportTo(Exporter &exporter,
@@ -87,14 +124,93 @@ void FullyConnectedLayer::setProperty(const std::vector<std::string> &values) {
 }
 
 void FullyConnectedLayer::forwarding(RunLayerContext &context, bool training) {
+  auto fused_act = std::get<props::FusedActivation>(fc_props).get();
+  bool fused_bn = std::get<props::FusedBatchNorm>(fc_props);
+  bool quantized = std::get<props::Quantized>(fc_props);
+  NNTR_THROW_IF(training && (fused_bn || quantized ||
+                             fused_act != ActivationType::ACT_NONE),
+                std::invalid_argument)
+    << "[FC] fused or quantized layer only supports inference";
+
+  /// the packed weight is folded before it is quantized
+  if (fused_bn && !quantized)
+    foldBatchNormalization(context);
+
   Tensor &weight = context.getWeight(weight_idx[FCParams::weight]);
   Tensor &bias = context.getWeight(weight_idx[FCParams::bias]);
 
   Tensor &hidden_ = context.getOutput(SINGLE_INOUT_IDX);
   Tensor &input_ = context.getInput(SINGLE_INOUT_IDX);
 
-  input_.dot(weight, hidden_);
-  hidden_.add_i(bias);
+  if (quantized) {
+    /// output in fp32 is dequantized with the scales of input and weight
+    unsigned int in_width = weight.height();
+    unsigned int unit = weight.width();
+    unsigned int rows = input_.size() / in_width;
+    auto packed = getInt8PackedWeight(weight.getData(), unit, in_width);
+
+    quantizeSymmetric(input_.getData(), input_.size(), *packed.input_scale,
+                      quantized_input.data());
+    int8GemmNT(rows, unit, in_width, quantized_input.data(), packed.data,
+               *packed.input_scale, nullptr, packed.scales, hidden_.getData(),
+               unit, num_threads);
+  } else {
+    input_.dot(weight, hidden_);
+  }
+
+  if (fused_act == ActivationType::ACT_NONE) {
+    hidden_.add_i(bias);
+  } else {
+    unsigned int unit = hidden_.width();
+    biasActivation(hidden_.getData(), bias.getData(), hidden_.size() / unit,
+                   unit, false, fused_act);
+  }
+}
+
+void FullyConnectedLayer::foldBatchNormalization(RunLayerContext &context) {
+  Tensor &weight = context.getWeight(weight_idx[FCParams::weight]);
+  unsigned int unit = weight.width();
+
+  bool folded = foldBatchNorm(
+    weight.getData(), context.getWeight(weight_idx[FCParams::bias]).getData(),
+    context.getWeight(weight_idx[FCParams::mu]).getData(),
+    context.getWeight(weight_idx[FCParams::var]).getData(),
+    context.getWeight(weight_idx[FCParams::gamma]).getData(),
+    context.getWeight(weight_idx[FCParams::beta]).getData(), unit,
+    weight.height(), false, std::get<props::Epsilon>(fc_props));
+}
+
+void FullyConnectedLayer::quantize(RunLayerContext &context,
+                                   float input_range) {
+  auto &quantized = std::get<props::Quantized>(fc_props);
+  /// the weight is packed already, as it is loaded from a quantized model
+  if (quantized)
+    return;
+
+  Tensor &weight = context.getWeight(weight_idx[FCParams::weight]);
+  unsigned int in_width = weight.height();
+  unsigned int unit = weight.width();
+  if (!canPackInt8(unit, in_width)) {
+    ml_logw("[FC] weight is too small to be packed in int8, keep running in "
+            "fp32");
+    return;
+  }
+
+  if (std::get<props::FusedBatchNorm>(fc_props))
+    foldBatchNormalization(context);
+
+  /// each output channel is a column of the weight, packed to be a row. The
+  /// fp32 weight is not kept, so the layer can not be trained any more
+  packInt8PerChannel(weight.getData(), unit, in_width, true,
+                     getInt8Scale(input_range));
+  quantized.set(true);
+  quantized_input.resize(context.getInput(SINGLE_INOUT_IDX).size());
+}
+
+void FullyConnectedLayer::setBatch(RunLayerContext &context,
+                                   unsigned int batch) {
+  if (std::get<props::Quantized>(fc_props))
+    quantized_input.resize(context.getInput(SINGLE_INOUT_IDX).size());
 }
 
 void FullyConnectedLayer::calcDerivative(RunLayerContext &context) {
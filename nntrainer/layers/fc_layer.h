@@ -15,6 +15,9 @@
 #define __FC_LAYER_H__
 #ifdef __cplusplus
 
+#include <cstdint>
+#include <vector>
+
 #include <common_properties.h>
 #include <layer_impl.h>
 
@@ -31,8 +34,10 @@ public:
    */
   FullyConnectedLayer() :
     LayerImpl(),
-    fc_props(props::Unit()),
-    weight_idx({0}) {}
+    fc_props(props::Unit(), props::FusedActivation(), props::FusedBatchNorm(),
+             props::Epsilon(), props::Quantized()),
+    weight_idx({0}),
+    num_threads(1) {}
 
   /**
    * @brief     Destructor of Fully Connected Layer
@@ -94,12 +99,39 @@ public:
    */
   void setProperty(const std::vector<std::string> &values) override;
 
+  /**
+   * @copydoc Layer::supportQuantization()
+   */
+  bool supportQuantization() const override { return true; }
+
+  /**
+   * @copydoc Layer::quantize(RunLayerContext &context, float input_range)
+   */
+  void quantize(RunLayerContext &context, float input_range) override;
+
+  /**
+   * @copydoc Layer::setBatch(RunLayerContext &context, unsigned int batch)
+   */
+  void setBatch(RunLayerContext &context, unsigned int batch) override;
+
   inline static const std::string type = "fully_connected";
 
 private:
-  std::tuple<props::Unit>
-    fc_props; /**< fc layer properties : unit - number of output neurons */
-  std::array<unsigned int, 2> weight_idx; /**< indices of the weights */
+  /**
+   * @brief fold the fused batch normalization into the weight and bias
+   *
+   * @param context context of the layer
+   */
+  void foldBatchNormalization(RunLayerContext &context);
+
+  std::tuple<props::Unit, props::FusedActivation, props::FusedBatchNorm,
+             props::Epsilon, props::Quantized>
+    fc_props; /**< fc layer properties : unit - number of output neurons,
+                 activation and batch normalization fused at inference, and
+                 if the weight is packed in int8 */
+  std::array<unsigned int, 6> weight_idx; /**< indices of the weights */
+  unsigned int num_threads; /**< number of threads to run the int8 GEMM */
+  std::vector<int8_t> quantized_input; /**< int8 input, sized with the batch */
 };
 } // namespace nntrainer
 
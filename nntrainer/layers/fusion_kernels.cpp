@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   fusion_kernels.cpp
+ * @date   17 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  Kernels for the layers fused at inference
+ *
+ */
+
+#include <cmath>
+
+#include <fusion_kernels.h>
+
+namespace nntrainer {
+
+namespace {
+
+/**
+ * @brief add the bias and apply the activation to a contiguous range
+ *
+ * @tparam Act activation applied to each element
+ */
+template <typename Act>
+void biasActivate(float *data, const float *bias, unsigned int rows,
+                  unsigned int cols, bool bias_per_row, Act act) {
+  for (unsigned int r = 0; r < rows; ++r) {
+    float *row = data + static_cast<size_t>(r) * cols;
+    if (bias_per_row) {
+      float b = bias[r];
+      for (unsigned int c = 0; c < cols; ++c)
+        row[c] = act(row[c] + b);
+    } else {
+      for (unsigned int c = 0; c < cols; ++c)
+        row[c] = act(row[c] + bias[c]);
+    }
+  }
+}
+
+} // namespace
+
+void biasActivation(float *data, const float *bias, unsigned int rows,
+                    unsigned int cols, bool bias_per_row, ActivationType act) {
+  switch (act) {
+  case ActivationType::ACT_RELU:
+    biasActivate(data, bias, rows, cols, bias_per_row,
+                 [](float x) { return x > 0.0f ? x : 0.0f; });
+    break;
+  case ActivationType::ACT_SIGMOID:
+    biasActivate(data, bias, rows, cols, bias_per_row,
+                 [](float x) { return 1.0f / (1.0f + std::exp(-x)); });
+    break;
+  case ActivationType::ACT_TANH:
+    biasActivate(data, bias, rows, cols, bias_per_row,
+                 [](float x) { return std::tanh(x); });
+    break;
+  default:
+    biasActivate(data, bias, rows, cols, bias_per_row,
+                 [](float x) { return x; });
+    break;
+  }
+}
+
+bool foldBatchNorm(float *weight, float *bias, float *mu, const float *var,
+                   float *gamma, float *beta, unsigned int channels,
+                   size_t len, bool channel_major, float epsilon) {
+  bool folded = true;
+  for (unsigned int c = 0; c < channels && folded; ++c) {
+    folded = mu[c] == 0.0f && beta[c] == 0.0f &&
+             gamma[c] == std::sqrt(var[c] + epsilon);
+  }
+
+  if (folded)
+    return false;
+
+  for (unsigned int c = 0; c < channels; ++c) {
+    float stddev = std::sqrt(var[c] + epsilon);
+    float scale = gamma[c] / stddev;
+
+    if (channel_major) {
+      float *w = weight + c * len;
+      for (size_t i = 0; i < len; ++i)
+        w[i] *= scale;
+    } else {
+      for (size_t i = 0; i < len; ++i)
+        weight[i * channels + c] *= scale;
+    }
+
+    bias[c] = (bias[c] - mu[c]) * scale + beta[c];
+    mu[c] = 0.0f;
+    beta[c] = 0.0f;
+    gamma[c] = stddev;
+  }
+
+  return true;
+}
+
+} // namespace nntrainer
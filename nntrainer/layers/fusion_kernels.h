@@ -0,0 +1,75 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   fusion_kernels.h
+ * @date   17 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  Kernels for the layers fused at inference
+ *
+ */
+
+#ifndef __FUSION_KERNELS_H__
+#define __FUSION_KERNELS_H__
+#ifdef __cplusplus
+
+#include <cstddef>
+
+#include <common_properties.h>
+
+namespace nntrainer {
+
+/**
+ * @brief check if the activation can be applied in the epilogue of a layer
+ *
+ * @param act activation type
+ * @retval true if the activation is element-wise and supported
+ */
+inline bool isFusableActivation(ActivationType act) {
+  return act == ActivationType::ACT_RELU ||
+         act == ActivationType::ACT_SIGMOID || act == ActivationType::ACT_TANH;
+}
+
+/**
+ * @brief add the bias and apply the activation to a matrix in a single pass
+ *
+ * @param[in,out] data matrix of [rows, cols]
+ * @param[in] bias bias of [rows] if bias_per_row, [cols] otherwise
+ * @param[in] rows number of the rows
+ * @param[in] cols number of the columns
+ * @param[in] bias_per_row true if an element of the bias is added to a row
+ * @param[in] act activation, ACT_NONE only adds the bias
+ */
+void biasActivation(float *data, const float *bias, unsigned int rows,
+                    unsigned int cols, bool bias_per_row, ActivationType act);
+
+/**
+ * @brief fold the batch normalization into the weight and bias of the layer
+ * preceding it
+ * @details with scale = gamma / sqrt(var + epsilon), every weight of an output
+ * channel c is multiplied by scale[c] and the bias becomes (bias - mu) * scale
+ * + beta. Then mu and beta are set to 0 and gamma to sqrt(var + epsilon), which
+ * leaves the batch normalization an identity and makes folding again a no-op.
+ *
+ * @param[in,out] weight weight of [channels, len] if channel_major, [len,
+ * channels] otherwise
+ * @param[in,out] bias bias of [channels]
+ * @param[in,out] mu moving mean of [channels]
+ * @param[in] var moving variance of [channels]
+ * @param[in,out] gamma gamma of [channels]
+ * @param[in,out] beta beta of [channels]
+ * @param[in] channels number of the output channels
+ * @param[in] len number of the weights of an output channel
+ * @param[in] channel_major true if the weights of a channel are contiguous
+ * @param[in] epsilon epsilon of the batch normalization
+ * @retval true if the weights are changed, false if already folded
+ */
+bool foldBatchNorm(float *weight, float *bias, float *mu, const float *var,
+                   float *gamma, float *beta, unsigned int channels,
+                   size_t len, bool channel_major, float epsilon);
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __FUSION_KERNELS_H__ */
@@ -26,12 +26,14 @@
  *   xs------------------+--------+---------------+
  */
 
+#include <blas_interface.h>
 #include <cmath>
 #include <gru.h>
 #include <layer_context.h>
 #include <nntrainer_error.h>
 #include <nntrainer_log.h>
 #include <node_exporter.h>
+#include <recurrent_kernels.h>
 #include <util_func.h>
 
 namespace nntrainer {
@@ -189,74 +191,100 @@ void GRULayer::forwarding(RunLayerContext &context, bool training) {
   const TensorDim &input_dim = input_.getDim();
 
   hidden_.setZero();
-  zrg.setZero();
   h_prev.setZero();
 
-  Tensor hs_prev;
-  Tensor hs;
+  const unsigned int batch = input_dim.batch();
+  const unsigned int max_timestep = input_dim.height();
+  const unsigned int gate_size = unit * NUM_GATE;
+  const bool fused = isGateFusable(recurrent_acti_func, acti_func);
 
   // zt = sigma(W_hz.h_prev + W_xz.xs)
   // rt = sigma(W_hr.h_prev + W_xr.xs)
   // gt = tanh((h_prev*rt).W_hr + W_xg.xs)
   // h_nx = (1-zt)*gt + zt*h_prev
 
-  for (unsigned int b = 0; b < input_dim.batch(); ++b) {
-    Tensor islice = input_.getBatchSlice(b, 1);
-    Tensor oslice = hidden_.getBatchSlice(b, 1);
-    Tensor zrg_ = zrg.getBatchSlice(b, 1);
-
-    for (unsigned int t = 0; t < islice.height(); ++t) {
-      Tensor xs =
-        islice.getSharedDataTensor({islice.width()}, t * islice.width());
-
-      /** @todo verify this dropout working */
-      // if (dropout_rate > 0.0 && training) {
-      //   xs.multiply_i(xs.dropout_mask(dropout_rate));
-      // }
-      hs = oslice.getSharedDataTensor({oslice.width()}, t * oslice.width());
-      Tensor zrg_t =
-        zrg_.getSharedDataTensor({unit * NUM_GATE}, unit * t * NUM_GATE);
+  /** x_z, x_r, x_g of every sample and timestep in a single gemm */
+  input_.dot(weight_xh, zrg);
 
-      if (t > 0) {
-        hs_prev = oslice.getSharedDataTensor({oslice.width()},
-                                             (t - 1) * oslice.width());
-      } else {
-        hs_prev = h_prev.getBatchSlice(b, 1);
-      }
+  Tensor ztrt_b = bias_h.getSharedDataTensor({unit * 2}, 0);
+  Tensor gt_b = bias_h.getSharedDataTensor({unit}, unit * 2);
 
-      xs.dot(weight_xh, zrg_t); // x_z, x_r, x_g
+  /** rt * h_prev of the whole batch, input of the candidate gemm */
+  Tensor temp(batch, 1, 1, unit);
 
-      Tensor ztrt = zrg_t.getSharedDataTensor({unit * 2}, 0);
-      Tensor ztrt_b = bias_h.getSharedDataTensor({unit * 2}, 0);
+  for (unsigned int t = 0; t < max_timestep; ++t) {
+    const float *h_prev_data;
+    unsigned int h_prev_ld;
+    if (t > 0) {
+      h_prev_data = hidden_.getData() + (t - 1) * unit;
+      h_prev_ld = max_timestep * unit;
+    } else {
+      h_prev_data = h_prev.getData();
+      h_prev_ld = unit;
+    }
 
-      Tensor w_hh;
-      w_hh.copy_with_stride(
-        weight_hh.getSharedDataTensor({1, 1, unit, unit * 2}, 0, false));
-      Tensor w_g;
-      w_g.copy_with_stride(
-        weight_hh.getSharedDataTensor({1, 1, unit, unit}, unit * 2, false));
+    float *zrg_data = zrg.getData() + t * gate_size;
+
+    /** W_hz.h_prev, W_hr.h_prev for the whole batch */
+    sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, batch, unit * 2, unit,
+          1.0f, h_prev_data, h_prev_ld, weight_hh.getData(), gate_size, 1.0f,
+          zrg_data, max_timestep * gate_size);
+
+    for (unsigned int b = 0; b < batch; ++b) {
+      Tensor zrg_t = zrg.getSharedDataTensor(
+        {gate_size}, (b * max_timestep + t) * gate_size);
+      Tensor hs_prev =
+        t > 0 ? hidden_.getSharedDataTensor(
+                  {unit}, (b * max_timestep + t - 1) * unit)
+              : h_prev.getBatchSlice(b, 1);
+      Tensor temp_b = temp.getBatchSlice(b, 1);
+
+      if (fused) {
+        gruUpdateResetForward(unit, bias_h.getData(), hs_prev.getData(),
+                              zrg_t.getData(), temp_b.getData());
+      } else {
+        Tensor ztrt = zrg_t.getSharedDataTensor({unit * 2}, 0);
+        ztrt.add_i(ztrt_b);
 
-      Tensor gt = zrg_t.getSharedDataTensor({unit}, unit * 2);
-      Tensor gt_b = bias_h.getSharedDataTensor({unit}, unit * 2);
+        Tensor zt = ztrt.getSharedDataTensor({unit}, 0);
+        Tensor rt = ztrt.getSharedDataTensor({unit}, unit);
 
-      ztrt.add_i(hs_prev.dot(w_hh));
-      ztrt.add_i(ztrt_b);
+        recurrent_acti_func.run_fn(rt, rt);
+        recurrent_acti_func.run_fn(zt, zt);
 
-      Tensor zt = ztrt.getSharedDataTensor({unit}, 0);
-      Tensor rt = ztrt.getSharedDataTensor({unit}, unit);
+        rt.multiply(hs_prev, temp_b);
+      }
+    }
 
-      recurrent_acti_func.run_fn(rt, rt);
-      recurrent_acti_func.run_fn(zt, zt);
+    /** W_hg.(h_prev*rt) for the whole batch */
+    sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, batch, unit, unit, 1.0f,
+          temp.getData(), unit, weight_hh.getData() + unit * 2, gate_size,
+          1.0f, zrg_data + unit * 2, max_timestep * gate_size);
+
+    for (unsigned int b = 0; b < batch; ++b) {
+      Tensor zrg_t = zrg.getSharedDataTensor(
+        {gate_size}, (b * max_timestep + t) * gate_size);
+      Tensor hs_prev =
+        t > 0 ? hidden_.getSharedDataTensor(
+                  {unit}, (b * max_timestep + t - 1) * unit)
+              : h_prev.getBatchSlice(b, 1);
+      Tensor hs =
+        hidden_.getSharedDataTensor({unit}, (b * max_timestep + t) * unit);
+
+      if (fused) {
+        gruCandidateForward(unit, bias_h.getData(), nullptr, hs_prev.getData(),
+                            zrg_t.getData(), hs.getData());
+      } else {
+        Tensor zt = zrg_t.getSharedDataTensor({unit}, 0);
+        Tensor gt = zrg_t.getSharedDataTensor({unit}, unit * 2);
 
-      Tensor temp;
-      rt.multiply(hs_prev, temp);
-      gt.add_i(temp.dot(w_g));
-      gt.add_i(gt_b);
-      acti_func.run_fn(gt, gt);
+        gt.add_i(gt_b);
+        acti_func.run_fn(gt, gt);
 
-      zt.multiply(hs_prev, hs);
-      temp = zt.multiply(-1.0).add(1.0);
-      hs.add_i(gt.multiply(temp));
+        zt.multiply(hs_prev, hs);
+        Tensor one_minus_zt = zt.multiply(-1.0).add(1.0);
+        hs.add_i(gt.multiply(one_minus_zt));
+      }
 
       if (dropout_rate > epsilon && training) {
         Tensor mask_ = context.getTensor(wt_idx[GRUParams::dropout_mask])
@@ -337,6 +365,17 @@ void GRULayer::calcGradient(RunLayerContext &context) {
   }
 
   Tensor dh_nx = Tensor({derivative_.width()});
+  Tensor temp = Tensor({unit});
+  Tensor rh = Tensor({unit});
+
+  Tensor wg_hh;
+  wg_hh.copy_with_stride(
+    weight_hh.getSharedDataTensor({1, 1, unit, unit}, unit * 2, false));
+  Tensor wzr_hh;
+  wzr_hh.copy_with_stride(
+    weight_hh.getSharedDataTensor({1, 1, unit, unit * 2}, 0, false));
+
+  const bool fused = isGateFusable(recurrent_acti_func, acti_func);
 
   for (unsigned int b = 0; b < input_dim.batch(); ++b) {
     Tensor deriv_t = derivative_.getBatchSlice(b, 1);
@@ -371,50 +410,50 @@ void GRULayer::calcGradient(RunLayerContext &context) {
         dh.add_i(dh_nx);
       }
 
-      Tensor dhz = dzrg_t.getSharedDataTensor({unit}, 0);
-      Tensor dhr = dzrg_t.getSharedDataTensor({unit}, unit);
       Tensor dhg = dzrg_t.getSharedDataTensor({unit}, unit * 2);
-
-      Tensor zt = zrg_t.getSharedDataTensor({unit}, 0);
-      Tensor rt = zrg_t.getSharedDataTensor({unit}, unit);
-      Tensor gt = zrg_t.getSharedDataTensor({unit}, unit * 2);
-
-      zt.multiply(dh, dh_nx); // dh_nx = d1
-
-      dh.multiply(hs_prev, dhz);       // dhz = d2
-      dhz.subtract_i(gt.multiply(dh)); // dhz = d5
-      zt.multiply(-1.0, dhg);
-      dhg.add_i(1.0);
-      dhg.multiply_i(dh); // dhg = d6
-
-      recurrent_acti_func.run_prime_fn(zt, dhz, dhz); // dhz = d7
-      acti_func.run_prime_fn(gt, dhg, dhg);           // dhg = d8
-
       Tensor dhzr = dzrg_t.getSharedDataTensor({unit * 2}, 0); // dhz+dhr
 
-      Tensor wg_hh;
-      wg_hh.copy_with_stride(
-        weight_hh.getSharedDataTensor({1, 1, unit, unit}, unit * 2, false));
-      Tensor wzr_hh;
-      wzr_hh.copy_with_stride(
-        weight_hh.getSharedDataTensor({1, 1, unit, unit * 2}, 0, false));
-
-      Tensor temp = Tensor({hs_t.width()});
-      temp.setZero();
-      dhg.dot(wg_hh, temp, false, true); // temp = d10
-      hs_prev.multiply(temp, dhr);       // dhr = d15
-      temp.multiply_i(rt);               // temp=d14
-      dh_nx.add_i(temp);                 //  dh_nx = d1 + d14
-      // reset temp : hs_prev * rt for djdw_g_h
-      hs_prev.multiply(rt, temp);
-      recurrent_acti_func.run_prime_fn(rt, dhr, dhr); // dhr = d16
+      if (fused) {
+        gruCandidateBackward(unit, zrg_t.getData(), hs_prev.getData(),
+                             dh.getData(), dzrg_t.getData(), dh_nx.getData());
+        dhg.dot(wg_hh, temp, false, true); // temp = d10
+        gruResetBackward(unit, zrg_t.getData(), hs_prev.getData(),
+                         temp.getData(), dzrg_t.getData(), dh_nx.getData(),
+                         rh.getData());
+      } else {
+        Tensor dhz = dzrg_t.getSharedDataTensor({unit}, 0);
+        Tensor dhr = dzrg_t.getSharedDataTensor({unit}, unit);
+
+        Tensor zt = zrg_t.getSharedDataTensor({unit}, 0);
+        Tensor rt = zrg_t.getSharedDataTensor({unit}, unit);
+        Tensor gt = zrg_t.getSharedDataTensor({unit}, unit * 2);
+
+        zt.multiply(dh, dh_nx); // dh_nx = d1
+
+        dh.multiply(hs_prev, dhz);       // dhz = d2
+        dhz.subtract_i(gt.multiply(dh)); // dhz = d5
+        zt.multiply(-1.0, dhg);
+        dhg.add_i(1.0);
+        dhg.multiply_i(dh); // dhg = d6
+
+        recurrent_acti_func.run_prime_fn(zt, dhz, dhz); // dhz = d7
+        acti_func.run_prime_fn(gt, dhg, dhg);           // dhg = d8
+
+        dhg.dot(wg_hh, temp, false, true); // temp = d10
+        hs_prev.multiply(temp, dhr);       // dhr = d15
+        temp.multiply_i(rt);               // temp=d14
+        dh_nx.add_i(temp);                 //  dh_nx = d1 + d14
+        // rh : hs_prev * rt for djdw_g_h
+        hs_prev.multiply(rt, rh);
+        recurrent_acti_func.run_prime_fn(rt, dhr, dhr); // dhr = d16
+      }
 
       djdb_h.add_i(dzrg_t); // dzrg_t = d7+d16+d8
 
       djdw_x.add_i(xs.dot(dzrg_t, true, false));
 
       djdw_zr_h.add_i(hs_prev.dot(dhzr, true, false));
-      djdw_g_h.add_i(temp.dot(dhg, true, false));
+      djdw_g_h.add_i(rh.dot(dhg, true, false));
       dhzr.dot(wzr_hh, dh_nx, false, true, 1.0); // dh_nx = d1 + d14 + d12 + d17
     }
   }
@@ -33,6 +33,7 @@
 #include <nntrainer_error.h>
 #include <nntrainer_log.h>
 #include <node_exporter.h>
+#include <recurrent_kernels.h>
 #include <util_func.h>
 
 #include <layer_context.h>
@@ -209,13 +210,6 @@ void GRUCellLayer::forwarding(RunLayerContext &context, bool training) {
   if (timestep) {
     zr_gate.add_i_strided(prev_hidden_state.dot(weight_hh_zr));
   }
-  Tensor bias_ih_zr = bias_ih.getSharedDataTensor({2 * unit}, 0);
-  zr_gate.add_i(bias_ih_zr);
-
-  recurrent_acti_func.run_fn(zr_gate, zr_gate);
-
-  Tensor z_gate = zr_gate.getSharedDataTensor({batch_size, unit}, 0, false);
-  Tensor r_gate = zr_gate.getSharedDataTensor({batch_size, unit}, unit, false);
 
   Tensor temp;
   prev_hidden_state.dot(weight_hh_g, temp, false, false);
@@ -224,18 +218,44 @@ void GRUCellLayer::forwarding(RunLayerContext &context, bool training) {
   Tensor bias_hh_g = bias_ih.getSharedDataTensor({unit}, 2 * unit);
   temp.add_i(bias_hh_g);
 #endif
-  temp.multiply_i_strided(r_gate);
-  g_gate.add_i_strided(temp);
+
+  if (isGateFusable(recurrent_acti_func, acti_func)) {
+#if ENABLE_BIAS_IH
+    const float *bias_ih_g = bias_ih.getData();
+#else
+    const float *bias_ih_g = nullptr;
+#endif
+
+    for (unsigned int b = 0; b < batch_size; ++b) {
+      float *zrg = zrg_gate.getAddress(b * NUM_GATE * unit);
+      gruUpdateResetForward(unit, bias_ih.getData(), nullptr, zrg, nullptr);
+      gruCandidateForward(unit, bias_ih_g, temp.getAddress(b * unit),
+                          prev_hidden_state.getAddress(b * unit), zrg,
+                          hidden_state.getAddress(b * unit));
+    }
+  } else {
+    Tensor bias_ih_zr = bias_ih.getSharedDataTensor({2 * unit}, 0);
+    zr_gate.add_i(bias_ih_zr);
+
+    recurrent_acti_func.run_fn(zr_gate, zr_gate);
+
+    Tensor z_gate = zr_gate.getSharedDataTensor({batch_size, unit}, 0, false);
+    Tensor r_gate =
+      zr_gate.getSharedDataTensor({batch_size, unit}, unit, false);
+
+    temp.multiply_i_strided(r_gate);
+    g_gate.add_i_strided(temp);
 #if ENABLE_BIAS_IH
-  Tensor bias_ih_g = bias_ih.getSharedDataTensor({unit}, 2 * unit);
-  g_gate.add_i(bias_ih_g);
+    Tensor bias_ih_g = bias_ih.getSharedDataTensor({unit}, 2 * unit);
+    g_gate.add_i(bias_ih_g);
 #endif
 
-  acti_func.run_fn(g_gate, g_gate);
+    acti_func.run_fn(g_gate, g_gate);
 
-  z_gate.multiply_strided(prev_hidden_state, hidden_state);
-  temp = z_gate.multiply(-1.0).add(1.0);
-  hidden_state.add_i(g_gate.multiply_strided(temp));
+    z_gate.multiply_strided(prev_hidden_state, hidden_state);
+    temp = z_gate.multiply(-1.0).add(1.0);
+    hidden_state.add_i(g_gate.multiply_strided(temp));
+  }
 
   if (dropout_rate > epsilon && training) {
     Tensor mask = context.getTensor(wt_idx[GRUCellParams::dropout_mask]);
@@ -344,16 +364,26 @@ void GRUCellLayer::calcGradient(RunLayerContext &context) {
   Tensor rt = zrg_gate.getSharedDataTensor({batch_size, unit}, unit, false);
   Tensor gt = zrg_gate.getSharedDataTensor({batch_size, unit}, unit * 2, false);
 
-  hidden_state_derivative.multiply_strided(zt, dh_nx);    // dh_nx = d1
-  hidden_state_derivative.multiply_strided(hs_prev, dhz); // dhz = d2
-  dhz.add_i_strided(hidden_state_derivative.multiply_strided(gt),
-                    -1.0f); // dhz = d5
-  zt.multiply(-1.0, dhg);
-  dhg.add_i(1.0);
-  dhg.multiply_i_strided(hidden_state_derivative); // dhg = d6
-
-  recurrent_acti_func.run_prime_fn(zt, dhz, dhz); // dhz = d7
-  acti_func.run_prime_fn(gt, dhg, dhg);           // dhg = d8
+  if (isGateFusable(recurrent_acti_func, acti_func)) {
+    for (unsigned int b = 0; b < batch_size; ++b) {
+      gruCandidateBackward(unit, zrg_gate.getAddress(b * NUM_GATE * unit),
+                           hs_prev.getAddress(b * unit),
+                           hidden_state_derivative.getAddress(b * unit),
+                           zrg_gate_derivative.getAddress(b * NUM_GATE * unit),
+                           dh_nx.getAddress(b * unit));
+    }
+  } else {
+    hidden_state_derivative.multiply_strided(zt, dh_nx);    // dh_nx = d1
+    hidden_state_derivative.multiply_strided(hs_prev, dhz); // dhz = d2
+    dhz.add_i_strided(hidden_state_derivative.multiply_strided(gt),
+                      -1.0f); // dhz = d5
+    zt.multiply(-1.0, dhg);
+    dhg.add_i(1.0);
+    dhg.multiply_i_strided(hidden_state_derivative); // dhg = d6
+
+    recurrent_acti_func.run_prime_fn(zt, dhz, dhz); // dhz = d7
+    acti_func.run_prime_fn(gt, dhg, dhg);           // dhg = d8
+  }
 
   Tensor dhzr = zrg_gate_derivative.getSharedDataTensor({batch_size, unit * 2},
                                                         0, false); // dhz+dhr
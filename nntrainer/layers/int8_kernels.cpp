@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   int8_kernels.cpp
+ * @date   17 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  Kernels for the symmetric int8 quantized inference
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <int8_kernels.h>
+#include <nntrainer_error.h>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define USE_AVX2_KERNEL
+#include <immintrin.h>
+#endif
+
+namespace nntrainer {
+
+/// rows of B computed together, kept in the cache while A is streamed
+static constexpr unsigned int INT8_GEMM_N_BLOCK = 64;
+
+/// rows of B multiplied with a row of A at a time by the micro kernel
+static constexpr unsigned int INT8_GEMM_NR = 4;
+
+/**
+ * @brief micro kernel of the int8 GEMM, dot products of a row of A with
+ * INT8_GEMM_NR rows of B accumulated in int32
+ *
+ * @param K length of the rows
+ * @param a row of A
+ * @param b rows of B
+ * @param acc dot product of each row of B
+ */
+typedef void (*Int8DotKernel)(unsigned int K, const int8_t *a,
+                              const int8_t *const *b, int32_t *acc);
+
+static void int8_dot_kernel_generic(unsigned int K, const int8_t *a,
+                                    const int8_t *const *b, int32_t *acc) {
+  for (unsigned int r = 0; r < INT8_GEMM_NR; ++r) {
+    int32_t sum = 0;
+    for (unsigned int k = 0; k < K; ++k)
+      sum += static_cast<int32_t>(a[k]) * static_cast<int32_t>(b[r][k]);
+    acc[r] = sum;
+  }
+}
+
+#ifdef USE_AVX2_KERNEL
+/**
+ * @brief horizontal sum of the lanes of a register
+ */
+__attribute__((target("avx2"))) static inline int32_t
+hsum_epi32_avx2(__m256i v) {
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v),
+                              _mm256_extracti128_si256(v, 1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+}
+
+__attribute__((target("avx2"))) static void
+int8_dot_kernel_avx2(unsigned int K, const int8_t *a, const int8_t *const *b,
+                     int32_t *acc) {
+  __m256i c[INT8_GEMM_NR];
+  for (unsigned int r = 0; r < INT8_GEMM_NR; ++r)
+    c[r] = _mm256_setzero_si256();
+
+  /// 16 values are widened to int16, and pairs of the products are summed to
+  /// int32 by madd, which does not overflow as -128 is never used
+  unsigned int k = 0;
+  for (; k + 16 <= K; k += 16) {
+    __m256i a_val = _mm256_cvtepi8_epi16(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + k)));
+    for (unsigned int r = 0; r < INT8_GEMM_NR; ++r) {
+      __m256i b_val = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(b[r] + k)));
+      c[r] = _mm256_add_epi32(c[r], _mm256_madd_epi16(a_val, b_val));
+    }
+  }
+
+  for (unsigned int r = 0; r < INT8_GEMM_NR; ++r) {
+    int32_t sum = hsum_epi32_avx2(c[r]);
+    for (unsigned int j = k; j < K; ++j)
+      sum += static_cast<int32_t>(a[j]) * static_cast<int32_t>(b[r][j]);
+    acc[r] = sum;
+  }
+}
+#endif
+
+#if defined(__aarch64__)
+static void int8_dot_kernel_neon(unsigned int K, const int8_t *a,
+                                 const int8_t *const *b, int32_t *acc) {
+  int32x4_t c[INT8_GEMM_NR];
+  for (unsigned int r = 0; r < INT8_GEMM_NR; ++r)
+    c[r] = vdupq_n_s32(0);
+
+  /// two products of int8 fit in int16 as -128 is never used, and they are
+  /// accumulated pairwise to int32
+  unsigned int k = 0;
+  for (; k + 16 <= K; k += 16) {
+    int8x16_t a_val = vld1q_s8(a + k);
+    for (unsigned int r = 0; r < INT8_GEMM_NR; ++r) {
+      int8x16_t b_val = vld1q_s8(b[r] + k);
+      int16x8_t prod = vmull_s8(vget_low_s8(a_val), vget_low_s8(b_val));
+      prod = vmlal_s8(prod, vget_high_s8(a_val), vget_high_s8(b_val));
+      c[r] = vpadalq_s16(c[r], prod);
+    }
+  }
+
+  for (unsigned int r = 0; r < INT8_GEMM_NR; ++r) {
+    int32_t sum = vaddvq_s32(c[r]);
+    for (unsigned int j = k; j < K; ++j)
+      sum += static_cast<int32_t>(a[j]) * static_cast<int32_t>(b[r][j]);
+    acc[r] = sum;
+  }
+}
+#endif
+
+/**
+ * @brief select the int8 micro kernel from the features of the running cpu
+ */
+static Int8DotKernel selectInt8DotKernel() {
+#ifdef USE_AVX2_KERNEL
+  if (__builtin_cpu_supports("avx2"))
+    return int8_dot_kernel_avx2;
+#endif
+#if defined(__aarch64__)
+  return int8_dot_kernel_neon;
+#endif
+  return int8_dot_kernel_generic;
+}
+
+/**
+ * @brief bytes of the scales packed in front of the int8 weight
+ */
+static size_t int8PackedScaleBytes(unsigned int rows) {
+  return (1 + static_cast<size_t>(rows)) * sizeof(float);
+}
+
+void quantizePerChannel(const float *src, unsigned int rows, unsigned int cols,
+                        int8_t *dst, float *scales) {
+  for (unsigned int r = 0; r < rows; ++r) {
+    const float *row = src + static_cast<size_t>(r) * cols;
+    float range = 0.0f;
+    for (unsigned int c = 0; c < cols; ++c)
+      range = std::max(range, std::abs(row[c]));
+
+    scales[r] = getInt8Scale(range);
+    quantizeSymmetric(row, cols, scales[r], dst + static_cast<size_t>(r) * cols);
+  }
+}
+
+void quantizeSymmetric(const float *src, size_t len, float scale, int8_t *dst) {
+  if (scale == 0.0f) {
+    std::fill(dst, dst + len, 0);
+    return;
+  }
+
+  float inv_scale = 1.0f / scale;
+  for (size_t i = 0; i < len; ++i) {
+    float q = std::nearbyint(src[i] * inv_scale);
+    q = std::min(std::max(q, -INT8_QUANT_MAX), INT8_QUANT_MAX);
+    dst[i] = static_cast<int8_t>(q);
+  }
+}
+
+bool canPackInt8(unsigned int rows, unsigned int cols) {
+  size_t size = static_cast<size_t>(rows) * cols;
+  return size > 0 && int8PackedScaleBytes(rows) + size <= size * sizeof(float);
+}
+
+Int8PackedWeight getInt8PackedWeight(float *buffer, unsigned int rows,
+                                     unsigned int cols) {
+  return {buffer, buffer + 1,
+          reinterpret_cast<int8_t *>(buffer) + int8PackedScaleBytes(rows)};
+}
+
+void packInt8PerChannel(float *buffer, unsigned int rows, unsigned int cols,
+                        bool transposed, float input_scale) {
+  NNTR_THROW_IF(!canPackInt8(rows, cols), std::invalid_argument)
+    << "int8 weight of " << rows << "x" << cols
+    << " does not fit in the buffer of the fp32 weight";
+
+  /// each channel is copied to a row first, as the packed weight overwrites
+  /// the buffer it is quantized from
+  size_t size = static_cast<size_t>(rows) * cols;
+  std::vector<float> channels(buffer, buffer + size);
+  if (transposed) {
+    for (unsigned int c = 0; c < cols; ++c)
+      for (unsigned int r = 0; r < rows; ++r)
+        channels[static_cast<size_t>(r) * cols + c] =
+          buffer[static_cast<size_t>(c) * rows + r];
+  }
+
+  auto packed = getInt8PackedWeight(buffer, rows, cols);
+  *packed.input_scale = input_scale;
+  quantizePerChannel(channels.data(), rows, cols, packed.data, packed.scales);
+}
+
+void int8GemmNT(unsigned int M, unsigned int N, unsigned int K,
+                const int8_t *A, const int8_t *B, float alpha,
+                const float *a_scales, const float *b_scales, float *C,
+                unsigned int ldc, unsigned int num_threads) {
+  static const Int8DotKernel micro_kernel = selectInt8DotKernel();
+  int n_blocks = (N + INT8_GEMM_N_BLOCK - 1) / INT8_GEMM_N_BLOCK;
+
+#pragma omp parallel for num_threads(num_threads) schedule(static)
+  for (int nb = 0; nb < n_blocks; ++nb) {
+    unsigned int n_begin = nb * INT8_GEMM_N_BLOCK;
+    unsigned int n_end = std::min(N, n_begin + INT8_GEMM_N_BLOCK);
+
+    for (unsigned int m = 0; m < M; ++m) {
+      const int8_t *a = A + static_cast<size_t>(m) * K;
+      float a_scale = a_scales ? alpha * a_scales[m] : alpha;
+      float *c = C + static_cast<size_t>(m) * ldc;
+
+      for (unsigned int n = n_begin; n < n_end; n += INT8_GEMM_NR) {
+        /// the rows past the end repeat the last row, and are discarded
+        unsigned int nr = std::min(INT8_GEMM_NR, n_end - n);
+        const int8_t *b[INT8_GEMM_NR];
+        for (unsigned int r = 0; r < INT8_GEMM_NR; ++r)
+          b[r] = B + static_cast<size_t>(n + std::min(r, nr - 1)) * K;
+
+        int32_t acc[INT8_GEMM_NR];
+        micro_kernel(K, a, b, acc);
+
+        for (unsigned int r = 0; r < nr; ++r) {
+          float scale = b_scales ? a_scale * b_scales[n + r] : a_scale;
+          c[n + r] = static_cast<float>(acc[r]) * scale;
+        }
+      }
+    }
+  }
+}
+
+} // namespace nntrainer
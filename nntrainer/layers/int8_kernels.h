@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   int8_kernels.h
+ * @date   17 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  Kernels for the symmetric int8 quantized inference
+ *
+ */
+
+#ifndef __INT8_KERNELS_H__
+#define __INT8_KERNELS_H__
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nntrainer {
+
+/**
+ * @brief largest magnitude of a symmetric int8 value, -128 is not used
+ */
+constexpr const float INT8_QUANT_MAX = 127.0f;
+
+/**
+ * @brief get the symmetric scale mapping the given range to int8
+ *
+ * @param range maximum absolute value to be represented
+ * @return float scale, value ~= quantized * scale. 0 if the range is 0
+ */
+inline float getInt8Scale(float range) { return range / INT8_QUANT_MAX; }
+
+/**
+ * @brief quantize each row of a matrix to int8 with its own symmetric scale
+ *
+ * @param[in] src matrix of [rows, cols]
+ * @param[in] rows number of the rows, each row is a channel
+ * @param[in] cols number of the columns
+ * @param[out] dst quantized matrix of [rows, cols]
+ * @param[out] scales scale of each row of [rows]
+ */
+void quantizePerChannel(const float *src, unsigned int rows, unsigned int cols,
+                        int8_t *dst, float *scales);
+
+/**
+ * @brief quantize with a symmetric scale, saturating out of range values
+ *
+ * @param[in] src data to quantize
+ * @param[in] len length of the data
+ * @param[in] scale scale of the quantization, 0 quantizes everything to 0
+ * @param[out] dst quantized data, which can be the buffer of @a src to
+ * quantize in place
+ */
+void quantizeSymmetric(const float *src, size_t len, float scale, int8_t *dst);
+
+/**
+ * @brief int8 weight packed in the buffer of its fp32 weight, which is not
+ * kept once quantized. The buffer holds the scale of the input, the scale of
+ * each row and the int8 rows in order, so it is allocated, saved and loaded
+ * as the fp32 weight is.
+ */
+struct Int8PackedWeight {
+  float *input_scale; /**< scale to quantize the input */
+  float *scales;      /**< scale of each row of [rows] */
+  int8_t *data;       /**< int8 rows of [rows, cols] */
+};
+
+/**
+ * @brief check if the int8 weight of [rows, cols] fits in the buffer of the
+ * fp32 weight of the same shape
+ *
+ * @param rows number of the rows, each row is a channel
+ * @param cols number of the columns
+ * @return true if it can be packed
+ */
+bool canPackInt8(unsigned int rows, unsigned int cols);
+
+/**
+ * @brief get the int8 weight packed in the given buffer
+ *
+ * @param buffer buffer of the fp32 weight of [rows, cols]
+ * @param rows number of the rows
+ * @param cols number of the columns
+ * @return Int8PackedWeight views to the packed weight
+ */
+Int8PackedWeight getInt8PackedWeight(float *buffer, unsigned int rows,
+                                     unsigned int cols);
+
+/**
+ * @brief quantize the fp32 weight per channel and pack it in its own buffer
+ *
+ * @param[in,out] buffer fp32 weight, which holds the packed weight on return
+ * @param[in] rows number of the channels
+ * @param[in] cols number of the values of each channel
+ * @param[in] transposed true if the weight is [cols, rows], each channel being
+ * a column
+ * @param[in] input_scale scale to quantize the input, packed with the weight
+ * @throw std::invalid_argument if the int8 weight does not fit
+ */
+void packInt8PerChannel(float *buffer, unsigned int rows, unsigned int cols,
+                        bool transposed, float input_scale);
+
+/**
+ * @brief int8 GEMM of A x B^T, dequantized to float
+ * @details C[m][n] = alpha * a_scales[m] * b_scales[n] * sum_k A[m][k] *
+ * B[n][k], accumulated in int32. Both A and B are row major so that the
+ * innermost loop runs over contiguous memory of both.
+ *
+ * @param[in] M number of the rows of A and C
+ * @param[in] N number of the rows of B, columns of C
+ * @param[in] K number of the columns of A and B
+ * @param[in] A int8 matrix of [M, K]
+ * @param[in] B int8 matrix of [N, K]
+ * @param[in] alpha scale applied to every element
+ * @param[in] a_scales scale of each row of A, nullptr if not scaled per row
+ * @param[in] b_scales scale of each row of B, nullptr if not scaled per row
+ * @param[out] C output of [M, N] with the leading dimension ldc
+ * @param[in] ldc leading dimension of C
+ * @param[in] num_threads number of threads to run the GEMM
+ */
+void int8GemmNT(unsigned int M, unsigned int N, unsigned int K,
+                const int8_t *A, const int8_t *B, float alpha,
+                const float *a_scales, const float *b_scales, float *C,
+                unsigned int ldc, unsigned int num_threads = 1);
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __INT8_KERNELS_H__ */
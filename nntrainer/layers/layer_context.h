@@ -41,13 +41,16 @@ public:
    * @brief Construct a new Init Layer Context object
    *
    * @param dim Input dimensions for the layer
+   * @param num_threads_ number of threads the layer is allowed to use
    */
   InitLayerContext(const std::vector<TensorDim> &dim, unsigned int num_out,
                    bool in_place_, const std::string &n = "",
-                   const std::string &prefix_ = "") :
+                   const std::string &prefix_ = "",
+                   unsigned int num_threads_ = 1) :
     input_dim(dim),
     in_place(in_place_),
     num_outputs(num_out),
+    num_threads(num_threads_),
     name(n),
     prefix(prefix_) {
     NNTR_THROW_IF(!validate(), std::invalid_argument)
@@ -276,6 +279,15 @@ public:
    */
   bool executeInPlace() const { return in_place; }
 
+  /**
+   * @brief   get the number of threads the layer is allowed to use
+   *
+   * @return number of threads
+   * @note layer must request its per-thread memory based on this value at
+   * finalize(), as no memory can be allocated while running
+   */
+  unsigned int getNumThreads() const { return num_threads; }
+
 private:
   std::vector<TensorDim> input_dim;  /**< Input dimensions for the layer */
   std::vector<TensorDim> output_dim; /**< Output dimensions for the layer */
@@ -287,6 +299,7 @@ private:
                      variables) */
 
   unsigned int num_outputs; /**< number of outputs for the layer */
+  unsigned int num_threads; /**< number of threads for the layer */
   std::string name;         /**< name of the layer */
   std::string prefix;       /**< prefix of the layer */
 };
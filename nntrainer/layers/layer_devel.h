@@ -239,6 +239,32 @@ public:
    * @return true if supports backwarding, else false
    */
   virtual bool supportBackwarding() const = 0;
+
+  /**
+   * @brief  check if this layer supports the int8 quantized inference
+   * @note   layers which do not support it keep running in fp32, as the
+   * quantized layers take and give fp32 tensors at their boundaries
+   * @return true if the layer can be quantized, else false
+   */
+  virtual bool supportQuantization() const { return false; }
+
+  /**
+   * @brief  quantize the weights to int8 in place of the fp32 weights, after
+   * which the forwarding runs in int8 and the layer can not be trained. The
+   * int8 weights are saved and loaded as the weights are.
+   * @param  context Context of the layer, with the weights allocated
+   * @param  input_range maximum absolute value of the input observed while
+   * calibrating, which decides the scale to quantize the input
+   */
+  virtual void quantize(RunLayerContext &context, float input_range) {}
+
+  /**
+   * @brief  prepare what is derived from the weights, called once whenever
+   * the values of the weights are set from outside of the training, like
+   * being initialized or loaded
+   * @param  context Context of the layer, with the weights allocated
+   */
+  virtual void prepareWeights(RunLayerContext &context) {}
 };
 
 /// @todo Decide where to put and how to implement(#986)
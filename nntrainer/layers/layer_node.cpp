@@ -56,6 +56,18 @@ public:
   using prop_tag = bool_prop_tag;
 };
 
+/**
+ * @brief Checkpoint property, true if the outputs are kept for the
+ * backwarding while the layers before are recomputed
+ *
+ */
+class Checkpoint : public Property<bool> {
+public:
+  Checkpoint() : Property<bool>() {}
+  static constexpr const char *key = "checkpoint";
+  using prop_tag = bool_prop_tag;
+};
+
 /**
  * @brief Loss property, this defines loss specification of layer
  *
@@ -159,7 +171,7 @@ LayerNode::LayerNode(std::unique_ptr<nntrainer::Layer> &&l) :
   run_context(nullptr),
   layer_node_props(new PropsType(props::Name(), props::Distribute(),
                                  props::Trainable(), {}, {},
-                                 props::SharedFrom())),
+                                 props::SharedFrom(), props::Checkpoint())),
   layer_node_props_realization(
     new RealizationPropsType(props::Flatten(), props::Activation())),
   loss(new props::Loss()),
@@ -314,6 +326,14 @@ bool LayerNode::getDistribute() const {
   return distribute.get();
 }
 
+bool LayerNode::getCheckpoint() const {
+  auto &checkpoint = std::get<props::Checkpoint>(*layer_node_props);
+  if (checkpoint.empty()) {
+    return false;
+  }
+  return checkpoint.get();
+}
+
 const nntrainer::Layer *LayerNode::getLayer() const {
   if (run_context && getDistribute())
     return static_cast<TimeDistLayer *>(layer.get())->getDistLayer();
@@ -428,7 +448,8 @@ void LayerNode::save(std::ofstream &file) const {
 /**
  * @brief     Finalize creating the layer node
  */
-InitLayerContext LayerNode::finalize(const std::vector<TensorDim> &input_dims) {
+InitLayerContext LayerNode::finalize(const std::vector<TensorDim> &input_dims,
+                                     unsigned int num_threads) {
   /** Create init context right before finalize */
   if (run_context)
     throw std::runtime_error("Finalizing a layer which is already finalized");
@@ -494,9 +515,9 @@ InitLayerContext LayerNode::finalize(const std::vector<TensorDim> &input_dims) {
   }
 
   auto scope = getSharedFrom().empty() ? getName() : getSharedFrom();
-  auto init_context =
-    InitLayerContext(actual_input_dims, num_outputs,
-                     executeInPlace() != InPlace::NONE, getName(), scope);
+  auto init_context = InitLayerContext(actual_input_dims, num_outputs,
+                                       executeInPlace() != InPlace::NONE,
+                                       getName(), scope, num_threads);
 
   layer->finalize(init_context);
 
@@ -533,6 +554,23 @@ void LayerNode::forwarding(bool training) {
     loss->set(*loss + run_context->getLoss());
 }
 
+void LayerNode::quantize(float input_range) {
+  NNTR_THROW_IF(!supportQuantization(), std::invalid_argument)
+    << "Layer " << getName() << " of type " << getType()
+    << " does not support quantization";
+  NNTR_THROW_IF(!run_context, std::runtime_error)
+    << "Layer " << getName() << " must be finalized before quantization";
+
+  layer->quantize(*run_context, input_range);
+}
+
+void LayerNode::prepareWeights() {
+  NNTR_THROW_IF(!run_context, std::runtime_error)
+    << "Layer " << getName() << " must be finalized before preparing weights";
+
+  layer->prepareWeights(*run_context);
+}
+
 /**
  * @brief     calc the derivative to be passed to the previous layer
  */
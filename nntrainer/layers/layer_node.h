@@ -50,6 +50,7 @@ class InputLayer;
 class InputShape;
 class Activation;
 class SharedFrom;
+class Checkpoint;
 class Connection;
 class InputConnection;
 } // namespace props
@@ -218,8 +219,10 @@ public:
    * step. Any tensor memory required must be requested to the context which
    * will be made available during execution of the layer with the context.
    * @note configureRunContext() is expected to called right after this.
+   * @param   num_threads number of threads the layer is allowed to use
    */
-  InitLayerContext finalize(const std::vector<TensorDim> &input_dims = {});
+  InitLayerContext finalize(const std::vector<TensorDim> &input_dims = {},
+                            unsigned int num_threads = 1);
 
   /**
    * @brief     Forward Propagation of a layer
@@ -309,6 +312,27 @@ public:
    */
   bool supportBackwarding() const { return getLayer()->supportBackwarding(); }
 
+  /**
+   * @brief     check if the layer supports the int8 quantized inference
+   *
+   * @return boolean true if the layer can be quantized, else false
+   */
+  bool supportQuantization() const { return layer->supportQuantization(); }
+
+  /**
+   * @brief     quantize the weights of the layer to int8
+   *
+   * @param input_range maximum absolute value of the input observed while
+   * calibrating
+   */
+  void quantize(float input_range);
+
+  /**
+   * @brief     prepare what the layer derives from its weights, after the
+   * values of the weights are set
+   */
+  void prepareWeights();
+
   /**
    * Support interfaces for the properties intercepted from layer
    */
@@ -339,6 +363,13 @@ public:
    */
   bool getDistribute() const;
 
+  /**
+   * @brief     get checkpoint for this layer
+   * @retval true if the outputs are kept while the layers before this are
+   * recomputed in the backwarding
+   */
+  bool getCheckpoint() const;
+
   /**
    * @brief     get activation for this layer
    * @retval dist to enable/disable distribute
@@ -754,7 +785,8 @@ properties in the context/graph unless intended. */
   using PropsType =
     std::tuple<props::Name, props::Distribute, props::Trainable,
                std::vector<props::InputConnection>,
-               std::vector<props::InputShape>, props::SharedFrom>;
+               std::vector<props::InputShape>, props::SharedFrom,
+               props::Checkpoint>;
 
   using RealizationPropsType = std::tuple<props::Flatten, props::Activation>;
   /** these realization properties results in addition of new layers, hence
@@ -11,12 +11,15 @@
  *
  */
 
+#include <blas_interface.h>
 #include <cmath>
 #include <layer_context.h>
+#include <lazy_tensor.h>
 #include <lstm.h>
 #include <nntrainer_error.h>
 #include <nntrainer_log.h>
 #include <node_exporter.h>
+#include <recurrent_kernels.h>
 #include <util_func.h>
 
 namespace nntrainer {
@@ -206,59 +209,79 @@ void LSTMLayer::forwarding(RunLayerContext &context, bool training) {
    * will be contain a single timestep data only.
    */
 
-  for (unsigned int b = 0; b < input_dim.batch(); ++b) {
-    Tensor islice = input_.getBatchSlice(b, 1);
-    Tensor oslice = hidden_.getBatchSlice(b, 1);
-    Tensor cell = m_cell_.getBatchSlice(b, 1);
-    Tensor fgio_ = fgio.getBatchSlice(b, 1);
+  const unsigned int batch = input_dim.batch();
+  const unsigned int gate_size = unit * NUM_GATE;
+  const bool fused = isGateFusable(recurrent_acti_func, acti_func);
 
+  /**
+   * project the input to the gates. The whole sequence of every sample is
+   * a single [batch * timestep, input] x [input, gate] gemm.
+   */
+  if (start_timestep == 0 && end_timestep == max_timestep &&
+      input_dim.height() == max_timestep) {
+    input_.dot(weight_xh, fgio);
+  } else {
     for (unsigned int t = start_timestep; t < end_timestep; ++t) {
-      Tensor xs;
-      if (islice.height() != 1)
-        xs = islice.getSharedDataTensor({islice.width()}, t * islice.width());
-      else
-        xs = islice;
-
-      Tensor hs =
-        oslice.getSharedDataTensor({oslice.width()}, t * oslice.width());
-      Tensor cs = cell.getSharedDataTensor({cell.width()}, t * cell.width());
-      Tensor fgio_t =
-        fgio_.getSharedDataTensor({unit * NUM_GATE}, unit * t * NUM_GATE);
-
-      xs.dot(weight_xh, fgio_t);
-      fgio_t.add_i(bias_h);
-
-      if (t > 0) {
-        Tensor hs_prev = oslice.getSharedDataTensor({oslice.width()},
-                                                    (t - 1) * oslice.width());
-        hs_prev.dot(weight_hh, fgio_t, false, false, 1.0);
-      }
+      unsigned int x_offset =
+        input_dim.height() != 1 ? t * input_dim.width() : 0;
+      sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, batch, gate_size,
+            input_dim.width(), 1.0f, input_.getData() + x_offset,
+            input_dim.height() * input_dim.width(), weight_xh.getData(),
+            gate_size, 0.0f, fgio.getData() + t * gate_size,
+            max_timestep * gate_size);
+    }
+  }
 
-      Tensor hi = fgio_t.getSharedDataTensor({unit}, 0);
-      Tensor hf = fgio_t.getSharedDataTensor({unit}, unit);
-      Tensor hg = fgio_t.getSharedDataTensor({unit}, unit * 2);
-      Tensor ho = fgio_t.getSharedDataTensor({unit}, unit * 3);
+  for (unsigned int t = start_timestep; t < end_timestep; ++t) {
+    /** recurrent projection of the whole batch at once */
+    if (t > 0) {
+      sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, batch, gate_size, unit,
+            1.0f, hidden_.getData() + (t - 1) * unit, max_timestep * unit,
+            weight_hh.getData(), gate_size, 1.0f,
+            fgio.getData() + t * gate_size, max_timestep * gate_size);
+    }
 
-      recurrent_acti_func.run_fn(hf, hf);
-      recurrent_acti_func.run_fn(hi, hi);
-      recurrent_acti_func.run_fn(ho, ho);
-      acti_func.run_fn(hg, hg);
+    for (unsigned int b = 0; b < batch; ++b) {
+      const unsigned int offset = b * max_timestep + t;
+      Tensor hs = hidden_.getSharedDataTensor({unit}, offset * unit);
+      Tensor cs = m_cell_.getSharedDataTensor({unit}, offset * unit);
 
-      if (t > 0) {
-        Tensor cs_prev =
-          cell.getSharedDataTensor({cell.width()}, (t - 1) * cell.width());
-        hf.multiply(cs_prev, cs);
+      if (fused) {
+        const float *cs_prev = t > 0 ? cs.getData() - unit : nullptr;
+        lstmGateForward(unit, bias_h.getData(), cs_prev,
+                        fgio.getData() + offset * gate_size, cs.getData(),
+                        hs.getData());
+      } else {
+        Tensor fgio_t =
+          fgio.getSharedDataTensor({gate_size}, offset * gate_size);
+        fgio_t.add_i(bias_h);
+
+        Tensor hi = fgio_t.getSharedDataTensor({unit}, 0);
+        Tensor hf = fgio_t.getSharedDataTensor({unit}, unit);
+        Tensor hg = fgio_t.getSharedDataTensor({unit}, unit * 2);
+        Tensor ho = fgio_t.getSharedDataTensor({unit}, unit * 3);
+
+        recurrent_acti_func.run_fn(hf, hf);
+        recurrent_acti_func.run_fn(hi, hi);
+        recurrent_acti_func.run_fn(ho, ho);
+        acti_func.run_fn(hg, hg);
+
+        if (t > 0) {
+          Tensor cs_prev =
+            m_cell_.getSharedDataTensor({unit}, (offset - 1) * unit);
+          hf.chain().multiply_i(cs_prev).add_product_i(hg, hi).run(cs);
+        } else {
+          hg.multiply(hi, cs);
+        }
+
+        acti_func.run_fn(cs, hs);
+        hs.multiply_i(ho);
       }
-      cs.add_i(hg.multiply(hi));
-
-      acti_func.run_fn(cs, hs);
-      hs.multiply_i(ho);
 
       if (dropout_rate > epsilon && training) {
         Tensor mask_ = context.getTensor(wt_idx[LSTMParams::dropout_mask])
                          .getBatchSlice(b, 1);
-        Tensor msk =
-          mask_.getSharedDataTensor({mask_.width()}, t * mask_.width());
+        Tensor msk = mask_.getSharedDataTensor({unit}, t * unit);
         msk.dropout_mask(dropout_rate);
         hs.multiply_i(msk);
       }
@@ -352,6 +375,7 @@ void LSTMLayer::calcGradient(RunLayerContext &context) {
   Tensor &dm_cell_ = context.getTensorGrad(wt_idx[LSTMParams::mem_cell]);
   Tensor &fgio = context.getTensor(wt_idx[LSTMParams::fgio]);
   Tensor &d_fgio = context.getTensorGrad(wt_idx[LSTMParams::fgio]);
+  const bool fused = isGateFusable(recurrent_acti_func, acti_func);
 
   /** get the timestep values */
   unsigned int max_timestep = std::get<props::MaxTimestep>(lstm_props).get();
@@ -451,46 +475,54 @@ void LSTMLayer::calcGradient(RunLayerContext &context) {
           cs_t.getSharedDataTensor({cs_t.width()}, (t - 1) * cs_t.width());
       }
 
-      Tensor dhi = dfgio_t.getSharedDataTensor({unit}, 0);
-      Tensor dhf = dfgio_t.getSharedDataTensor({unit}, unit);
-      Tensor dhg = dfgio_t.getSharedDataTensor({unit}, unit * 2);
-      Tensor dho = dfgio_t.getSharedDataTensor({unit}, unit * 3);
-
-      Tensor hi = fgio_t.getSharedDataTensor({unit}, 0);
-      Tensor hf = fgio_t.getSharedDataTensor({unit}, unit);
-      Tensor hg = fgio_t.getSharedDataTensor({unit}, unit * 2);
-      Tensor ho = fgio_t.getSharedDataTensor({unit}, unit * 3);
-
-      acti_func.run_fn(cs, dho);
-      dho.multiply_i(dh);
-      acti_func.run_fn(cs, cs);
-
-      if ((unsigned)t + 1 == max_timestep) {
-        acti_func.run_prime_fn(cs, dc, dh);
-        dc.multiply_i(ho);
+      if (fused) {
+        float *dc_prev =
+          t > 0 ? derivc_t.getData() + (t - 1) * derivc_t.width() : nullptr;
+        lstmGateBackward(unit, fgio_t.getData(), cs_prev.getData(),
+                         cs.getData(), dh.getData(), dc.getData(), dc_prev,
+                         dfgio_t.getData());
       } else {
-        /// @todo optimize this by updating run_prime_fn to accumulate or make
-        /// it inplace somehow
-        Tensor dc_temp(dc.getDim());
-        acti_func.run_prime_fn(cs, dc_temp, dh);
-        dc_temp.multiply_i(ho);
-        dc.add_i(dc_temp);
-      }
-
-      if (t > 0) {
-        Tensor dc_nx = derivc_t.getSharedDataTensor({derivc_t.width()},
-                                                    (t - 1) * derivc_t.width());
-        dc.multiply(hf, dc_nx);
+        Tensor dhi = dfgio_t.getSharedDataTensor({unit}, 0);
+        Tensor dhf = dfgio_t.getSharedDataTensor({unit}, unit);
+        Tensor dhg = dfgio_t.getSharedDataTensor({unit}, unit * 2);
+        Tensor dho = dfgio_t.getSharedDataTensor({unit}, unit * 3);
+
+        Tensor hi = fgio_t.getSharedDataTensor({unit}, 0);
+        Tensor hf = fgio_t.getSharedDataTensor({unit}, unit);
+        Tensor hg = fgio_t.getSharedDataTensor({unit}, unit * 2);
+        Tensor ho = fgio_t.getSharedDataTensor({unit}, unit * 3);
+
+        acti_func.run_fn(cs, dho);
+        dho.multiply_i(dh);
+        acti_func.run_fn(cs, cs);
+
+        if ((unsigned)t + 1 == max_timestep) {
+          acti_func.run_prime_fn(cs, dc, dh);
+          dc.multiply_i(ho);
+        } else {
+          /// @todo optimize this by updating run_prime_fn to accumulate or
+          /// make it inplace somehow
+          Tensor dc_temp(dc.getDim());
+          acti_func.run_prime_fn(cs, dc_temp, dh);
+          dc.chain().add_product_i(dc_temp, ho).run(dc);
+        }
+
+        if (t > 0) {
+          Tensor dc_nx = derivc_t.getSharedDataTensor(
+            {derivc_t.width()}, (t - 1) * derivc_t.width());
+          dc.multiply(hf, dc_nx);
+        }
+
+        dc.multiply(cs_prev, dhf);
+        dc.multiply(hg, dhi);
+        dc.multiply(hi, dhg);
+
+        recurrent_acti_func.run_prime_fn(ho, dho, dho);
+        recurrent_acti_func.run_prime_fn(hf, dhf, dhf);
+        recurrent_acti_func.run_prime_fn(hi, dhi, dhi);
+        acti_func.run_prime_fn(hg, dhg, dhg);
       }
 
-      dc.multiply(cs_prev, dhf);
-      dc.multiply(hg, dhi);
-      dc.multiply(hi, dhg);
-
-      recurrent_acti_func.run_prime_fn(ho, dho, dho);
-      recurrent_acti_func.run_prime_fn(hf, dhf, dhf);
-      recurrent_acti_func.run_prime_fn(hi, dhi, dhi);
-      acti_func.run_prime_fn(hg, dhg, dhg);
       djdb_h.add_i(dfgio_t);
       djdw_x.add_i(xs.dot(dfgio_t, true, false));
       djdw_h.add_i(hs_prev.dot(dfgio_t, true, false));
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   recurrent_kernels.cpp
+ * @date   16 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  Fused gate kernels of the lstm and gru family of layers
+ *
+ */
+
+#include <cmath>
+
+#include <recurrent_kernels.h>
+
+namespace nntrainer {
+
+/**
+ * @brief sigmoid of a single value
+ */
+static inline float sigmoid(float x) { return 1.0f / (1.0f + std::exp(-x)); }
+
+bool isGateFusable(const ActiFunc &recurrent_acti_func,
+                   const ActiFunc &acti_func) {
+  return recurrent_acti_func.getActivationType() ==
+           ActivationType::ACT_SIGMOID &&
+         acti_func.getActivationType() == ActivationType::ACT_TANH;
+}
+
+void lstmGateForward(unsigned int unit, const float *bias, const float *c_prev,
+                     float *ifgo, float *c, float *h) {
+  float *i = ifgo;
+  float *f = ifgo + unit;
+  float *g = ifgo + unit * 2;
+  float *o = ifgo + unit * 3;
+
+  if (bias != nullptr) {
+#pragma omp simd
+    for (unsigned int j = 0; j < unit * 4; ++j)
+      ifgo[j] += bias[j];
+  }
+
+  for (unsigned int j = 0; j < unit; ++j) {
+    i[j] = sigmoid(i[j]);
+    f[j] = sigmoid(f[j]);
+    g[j] = std::tanh(g[j]);
+    o[j] = sigmoid(o[j]);
+
+    float cell = i[j] * g[j];
+    if (c_prev != nullptr)
+      cell += f[j] * c_prev[j];
+
+    c[j] = cell;
+    h[j] = o[j] * std::tanh(cell);
+  }
+}
+
+void lstmGateBackward(unsigned int unit, const float *ifgo,
+                      const float *c_prev, const float *c, const float *dh,
+                      float *dc, float *dc_prev, float *d_ifgo) {
+  const float *i = ifgo;
+  const float *f = ifgo + unit;
+  const float *g = ifgo + unit * 2;
+  const float *o = ifgo + unit * 3;
+
+  float *di = d_ifgo;
+  float *df = d_ifgo + unit;
+  float *dg = d_ifgo + unit * 2;
+  float *dout = d_ifgo + unit * 3;
+
+  for (unsigned int j = 0; j < unit; ++j) {
+    float tanh_c = std::tanh(c[j]);
+    float dcell = dc[j] + dh[j] * o[j] * (1.0f - tanh_c * tanh_c);
+    dc[j] = dcell;
+
+    if (dc_prev != nullptr)
+      dc_prev[j] = dcell * f[j];
+
+    dout[j] = dh[j] * tanh_c * o[j] * (1.0f - o[j]);
+    df[j] = c_prev != nullptr ? dcell * c_prev[j] * f[j] * (1.0f - f[j])
+                              : 0.0f;
+    di[j] = dcell * g[j] * i[j] * (1.0f - i[j]);
+    dg[j] = dcell * i[j] * (1.0f - g[j] * g[j]);
+  }
+}
+
+void gruUpdateResetForward(unsigned int unit, const float *bias,
+                           const float *h_prev, float *zrg, float *rh) {
+  float *r = zrg + unit;
+
+  if (bias != nullptr) {
+#pragma omp simd
+    for (unsigned int j = 0; j < unit * 2; ++j)
+      zrg[j] += bias[j];
+  }
+
+  for (unsigned int j = 0; j < unit * 2; ++j)
+    zrg[j] = sigmoid(zrg[j]);
+
+  if (rh != nullptr) {
+#pragma omp simd
+    for (unsigned int j = 0; j < unit; ++j)
+      rh[j] = r[j] * h_prev[j];
+  }
+}
+
+void gruCandidateForward(unsigned int unit, const float *bias,
+                         const float *hh_g, const float *h_prev, float *zrg,
+                         float *h) {
+  const float *z = zrg;
+  const float *r = zrg + unit;
+  float *g = zrg + unit * 2;
+
+  for (unsigned int j = 0; j < unit; ++j) {
+    float pre = g[j];
+    if (hh_g != nullptr)
+      pre += r[j] * hh_g[j];
+    if (bias != nullptr)
+      pre += bias[unit * 2 + j];
+
+    g[j] = std::tanh(pre);
+    h[j] = z[j] * h_prev[j] + (1.0f - z[j]) * g[j];
+  }
+}
+
+void gruCandidateBackward(unsigned int unit, const float *zrg,
+                          const float *h_prev, const float *dh, float *d_zrg,
+                          float *dh_prev) {
+  const float *z = zrg;
+  const float *g = zrg + unit * 2;
+
+  float *dz = d_zrg;
+  float *dg = d_zrg + unit * 2;
+
+#pragma omp simd
+  for (unsigned int j = 0; j < unit; ++j) {
+    dh_prev[j] = z[j] * dh[j];
+    dz[j] = dh[j] * (h_prev[j] - g[j]) * z[j] * (1.0f - z[j]);
+    dg[j] = dh[j] * (1.0f - z[j]) * (1.0f - g[j] * g[j]);
+  }
+}
+
+void gruResetBackward(unsigned int unit, const float *zrg, const float *h_prev,
+                      const float *d_rh, float *d_zrg, float *dh_prev,
+                      float *rh) {
+  const float *r = zrg + unit;
+  float *dr = d_zrg + unit;
+
+#pragma omp simd
+  for (unsigned int j = 0; j < unit; ++j) {
+    dr[j] = h_prev[j] * d_rh[j] * r[j] * (1.0f - r[j]);
+    dh_prev[j] += d_rh[j] * r[j];
+    rh[j] = h_prev[j] * r[j];
+  }
+}
+
+} // namespace nntrainer
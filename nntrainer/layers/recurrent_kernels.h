@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   recurrent_kernels.h
+ * @date   16 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  Fused gate kernels of the lstm and gru family of layers
+ *
+ * Each kernel handles a single row of [unit * NUM_GATE] gates and applies
+ * the activations, the cell and the hidden update in one pass. The kernels
+ * assume sigmoid as the recurrent activation and tanh as the hidden state
+ * activation, which must be checked with isGateFusable() beforehand.
+ *
+ */
+
+#ifndef __RECURRENT_KERNELS_H__
+#define __RECURRENT_KERNELS_H__
+#ifdef __cplusplus
+
+#include <acti_func.h>
+
+namespace nntrainer {
+
+/**
+ * @brief check if the fused gate kernels can be used for given activations
+ *
+ * @param recurrent_acti_func activation of the gates
+ * @param acti_func activation of the hidden state
+ * @return true if the recurrent activation is sigmoid and the hidden state
+ * activation is tanh
+ */
+bool isGateFusable(const ActiFunc &recurrent_acti_func,
+                   const ActiFunc &acti_func);
+
+/**
+ * @brief lstm gates forward of a single sample
+ * @details ifgo holds the pre-activation of the gates in i, f, g, o order and
+ * is replaced with their activations. c = f * c_prev + i * g and
+ * h = o * tanh(c).
+ *
+ * @param[in] unit number of the units
+ * @param[in] bias bias of the gates, nullptr if no bias is added
+ * @param[in] c_prev previous cell state, nullptr if it is zero
+ * @param[in/out] ifgo gates of [unit * 4]
+ * @param[out] c cell state
+ * @param[out] h hidden state
+ */
+void lstmGateForward(unsigned int unit, const float *bias, const float *c_prev,
+                     float *ifgo, float *c, float *h);
+
+/**
+ * @brief lstm gates backward of a single sample
+ * @details dc accumulates the derivative coming through the hidden state,
+ * and the derivative of the gate pre-activations is written to d_ifgo.
+ *
+ * @param[in] unit number of the units
+ * @param[in] ifgo activated gates of [unit * 4]
+ * @param[in] c_prev previous cell state, nullptr if it is zero
+ * @param[in] c cell state
+ * @param[in] dh derivative of the hidden state
+ * @param[in/out] dc derivative of the cell state
+ * @param[out] dc_prev derivative of the previous cell state, can be nullptr
+ * @param[out] d_ifgo derivative of the gates of [unit * 4]
+ */
+void lstmGateBackward(unsigned int unit, const float *ifgo,
+                      const float *c_prev, const float *c, const float *dh,
+                      float *dc, float *dc_prev, float *d_ifgo);
+
+/**
+ * @brief gru update and reset gates forward of a single sample
+ * @details z and r of zrg are replaced with their activations and rh is set
+ * to r * h_prev when given.
+ *
+ * @param[in] unit number of the units
+ * @param[in] bias bias of the z, r, g gates, nullptr if no bias is added
+ * @param[in] h_prev previous hidden state, used only when rh is given
+ * @param[in/out] zrg gates of [unit * 3]
+ * @param[out] rh reset previous hidden state, can be nullptr
+ */
+void gruUpdateResetForward(unsigned int unit, const float *bias,
+                           const float *h_prev, float *zrg, float *rh);
+
+/**
+ * @brief gru candidate gate and hidden state forward of a single sample
+ * @details g = tanh(g + r * hh_g + bias_g) and h = z * h_prev + (1 - z) * g
+ *
+ * @param[in] unit number of the units
+ * @param[in] bias bias of the z, r, g gates, nullptr if no bias is added
+ * @param[in] hh_g recurrent projection of the candidate gate to be reset,
+ * nullptr if it is already accumulated in g
+ * @param[in] h_prev previous hidden state
+ * @param[in/out] zrg gates of [unit * 3] with activated z and r
+ * @param[out] h hidden state
+ */
+void gruCandidateForward(unsigned int unit, const float *bias,
+                         const float *hh_g, const float *h_prev, float *zrg,
+                         float *h);
+
+/**
+ * @brief gru candidate and update gates backward of a single sample
+ *
+ * @param[in] unit number of the units
+ * @param[in] zrg activated gates of [unit * 3]
+ * @param[in] h_prev previous hidden state
+ * @param[in] dh derivative of the hidden state
+ * @param[out] d_zrg derivative of the z and g gates
+ * @param[out] dh_prev derivative of the previous hidden state through z
+ */
+void gruCandidateBackward(unsigned int unit, const float *zrg,
+                          const float *h_prev, const float *dh, float *d_zrg,
+                          float *dh_prev);
+
+/**
+ * @brief gru reset gate backward of a single sample where the reset is
+ * applied on the previous hidden state
+ *
+ * @param[in] unit number of the units
+ * @param[in] zrg activated gates of [unit * 3]
+ * @param[in] h_prev previous hidden state
+ * @param[in] d_rh derivative of r * h_prev
+ * @param[out] d_zrg derivative of the r gate
+ * @param[in/out] dh_prev derivative of the previous hidden state
+ * @param[out] rh r * h_prev
+ */
+void gruResetBackward(unsigned int unit, const float *zrg, const float *h_prev,
+                      const float *d_rh, float *d_zrg, float *dh_prev,
+                      float *rh);
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __RECURRENT_KERNELS_H__ */
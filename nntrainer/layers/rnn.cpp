@@ -11,6 +11,7 @@
  *
  */
 
+#include <blas_interface.h>
 #include <cmath>
 #include <layer_context.h>
 #include <nntrainer_error.h>
@@ -143,25 +144,26 @@ void RNNLayer::forwarding(RunLayerContext &context, bool training) {
   Tensor &input_ = context.getInput(SINGLE_INOUT_IDX);
   const TensorDim &input_dim = input_.getDim();
 
-  // TODO: swap b and t index with transpose
-  for (unsigned int b = 0; b < input_dim.batch(); ++b) {
-    Tensor islice = input_.getBatchSlice(b, 1);
-    Tensor oslice = hidden_.getBatchSlice(b, 1);
+  const unsigned int batch = input_dim.batch();
+  const unsigned int max_timestep = input_dim.height();
+  const unsigned int unit = hidden_.width();
 
-    for (unsigned int t = 0; t < islice.height(); ++t) {
-      Tensor xs =
-        islice.getSharedDataTensor({islice.width()}, t * islice.width());
-      Tensor hs =
-        oslice.getSharedDataTensor({oslice.width()}, t * oslice.width());
+  /** input projection of every sample and timestep in a single gemm */
+  input_.dot(weight_xh, hidden_);
 
-      xs.dot(weight_xh, hs);
-      hs.add_i(bias_h);
+  for (unsigned int t = 0; t < max_timestep; ++t) {
+    /** recurrent projection of the whole batch at once */
+    if (t > 0) {
+      sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, batch, unit, unit, 1.0f,
+            hidden_.getData() + (t - 1) * unit, max_timestep * unit,
+            weight_hh.getData(), unit, 1.0f, hidden_.getData() + t * unit,
+            max_timestep * unit);
+    }
 
-      if (t > 0) {
-        Tensor hs_prev = oslice.getSharedDataTensor({oslice.width()},
-                                                    (t - 1) * oslice.width());
-        hs_prev.dot(weight_hh, hs, false, false, 1.0);
-      }
+    for (unsigned int b = 0; b < batch; ++b) {
+      Tensor hs =
+        hidden_.getSharedDataTensor({unit}, (b * max_timestep + t) * unit);
+      hs.add_i(bias_h);
 
       // In-place calculation for activation
       acti_func.run_fn(hs, hs);
@@ -99,6 +99,11 @@ void SplitLayer::forwarding(RunLayerContext &context, bool training) {
 
   for (unsigned int idx = 0; idx < context.getNumOutputs(); idx++) {
     Tensor &output_ = context.getOutput(idx);
+    if (output_.getData() == input_.getAddress(0, 0, idx, 0)) {
+      /** already placed in the input by the in-place optimization */
+      continue;
+    }
+
     const TensorDim out_dim = output_.getDim();
     output_.reshape(output_reshape_helper);
 
@@ -128,6 +133,11 @@ void SplitLayer::calcDerivative(RunLayerContext &context) {
 
   for (unsigned int idx = 0; idx < context.getNumOutputs(); idx++) {
     Tensor &output_ = context.getIncomingDerivative(idx);
+    if (output_.getData() == input_.getAddress(0, 0, idx, 0)) {
+      /** already placed in the input by the in-place optimization */
+      continue;
+    }
+
     const TensorDim out_dim = output_.getDim();
     output_.reshape(output_reshape_helper);
 
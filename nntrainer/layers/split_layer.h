@@ -71,6 +71,12 @@ public:
    */
   bool supportBackwarding() const override { return true; };
 
+  /**
+   * @copydoc Layer::supportInPlace()
+   * @note the outputs can be placed in the input without copying
+   */
+  bool supportInPlace() const override { return true; }
+
   /**
    * @copydoc Layer::exportTo(Exporter &exporter, ExportMethods method)
    */
@@ -121,7 +121,8 @@ void TimeDistLayer::finalize(InitLayerContext &context) {
   TensorDim dist_dim = input_dim;
   dist_dim.height(1);
   InitLayerContext dist_context({dist_dim}, context.getNumOutputs(),
-                                context.executeInPlace(), context.getName());
+                                context.executeInPlace(), context.getName(),
+                                "", context.getNumThreads());
 
   // During forwarding and backwarding, it set the input and output buffer of
   // dist_layer properly
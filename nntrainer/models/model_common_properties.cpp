@@ -29,4 +29,30 @@ ContinueTrain::ContinueTrain(bool value) { set(value); }
 
 MemoryOptimization::MemoryOptimization(bool value) { set(value); }
 
+MemoryPlanner::MemoryPlanner(MemoryPlannerInfo::Enum value) { set(value); }
+
+NumThreads::NumThreads(unsigned int value) { set(value); }
+
+ParallelLayers::ParallelLayers(unsigned int value) { set(value); }
+
+LossScale::LossScale(float value) { set(value); }
+
+bool LossScale::isValid(const float &value) const { return value >= 1.0f; }
+
+MemorySwap::MemorySwap(bool value) { set(value); }
+
+MemorySwapPath::MemorySwapPath(const std::string &value) { set(value); }
+
+MemorySwapLookahead::MemorySwapLookahead(unsigned int value) { set(value); }
+
+AsyncSave::AsyncSave(bool value) { set(value); }
+
+AsyncUpdate::AsyncUpdate(bool value) { set(value); }
+
+InferenceFusion::InferenceFusion(bool value) { set(value); }
+
+OptimizerStateType::OptimizerStateType(OptimizerStateTypeInfo::Enum value) {
+  set(value);
+}
+
 } // namespace nntrainer::props
@@ -126,6 +126,242 @@ public:
   MemoryOptimization(bool value = true);
 };
 
+/**
+ * @brief     Enumeration of the memory planners
+ */
+struct MemoryPlannerInfo {
+  enum class Enum { optimized_v1, best_fit };
+  static constexpr std::initializer_list<Enum> EnumList = {Enum::optimized_v1,
+                                                           Enum::best_fit};
+
+  static constexpr const char *EnumStr[] = {"optimized_v1_planner",
+                                            "best_fit_planner"};
+};
+
+/**
+ * @brief model memory planner property, used when memory_optimization is true
+ *
+ */
+class MemoryPlanner final : public EnumProperty<MemoryPlannerInfo> {
+public:
+  static constexpr const char *key =
+    "memory_planner";                   /**< unique key to access */
+  using prop_tag = enum_class_prop_tag; /**< property type */
+
+  /**
+   * @brief Constructor
+   *
+   * @param value value to set, defaults to optimized_v1_planner
+   */
+  MemoryPlanner(
+    MemoryPlannerInfo::Enum value = MemoryPlannerInfo::Enum::optimized_v1);
+};
+
+/**
+ * @brief model number of threads property
+ *
+ */
+class NumThreads : public PositiveIntegerProperty {
+public:
+  static constexpr const char *key = "num_threads"; /**< unique key to access */
+  using prop_tag = uint_prop_tag;                   /**< property type */
+
+  /**
+   * @brief Construct a new NumThreads object
+   *
+   * @param value value to set, defaults to 1
+   */
+  NumThreads(unsigned int value = 1);
+};
+
+/**
+ * @brief model parallel layers property, number of threads running the
+ * independent layers of the graph concurrently
+ *
+ */
+class ParallelLayers : public PositiveIntegerProperty {
+public:
+  static constexpr const char *key =
+    "parallel_layers";              /**< unique key to access */
+  using prop_tag = uint_prop_tag; /**< property type */
+
+  /**
+   * @brief Construct a new ParallelLayers object
+   *
+   * @param value value to set, defaults to 1 which runs the layers one by one
+   */
+  ParallelLayers(unsigned int value = 1);
+};
+
+/**
+ * @brief model loss scale property, scaling the loss up while backwarding so
+ * that small gradients do not underflow in the 16 bit floating points
+ *
+ */
+class LossScale : public Property<float> {
+public:
+  static constexpr const char *key = "loss_scale"; /**< unique key to access */
+  using prop_tag = float_prop_tag;                 /**< property type */
+
+  /**
+   * @brief Construct a new LossScale object
+   *
+   * @param value value to set, defaults to 1 which disables the scaling
+   */
+  LossScale(float value = 1.0f);
+
+  /**
+   * @brief LossScale validator
+   *
+   * @param value float to validate
+   * @retval true if it is greater or equal than 1.0
+   * @retval false if it is smaller than 1.0
+   */
+  bool isValid(const float &value) const override;
+};
+
+/**
+ * @brief model memory swap property, swapping out the tensors idle for long
+ * to a file
+ *
+ */
+class MemorySwap : public Property<bool> {
+public:
+  static constexpr const char *key = "memory_swap"; /**< unique key to access */
+  using prop_tag = bool_prop_tag;                   /**< property type */
+
+  /**
+   * @brief Constructor
+   *
+   * @param value value to set, defaults to false
+   */
+  MemorySwap(bool value = false);
+};
+
+/**
+ * @brief model memory swap path property, directory of the swap file
+ *
+ */
+class MemorySwapPath : public Property<std::string> {
+public:
+  static constexpr const char *key =
+    "memory_swap_path";          /**< unique key to access */
+  using prop_tag = str_prop_tag; /**< property type */
+
+  /**
+   * @brief Constructor
+   *
+   * @param value value to set, defaults to the current directory
+   */
+  MemorySwapPath(const std::string &value = ".");
+};
+
+/**
+ * @brief model memory swap lookahead property, number of the execution orders
+ * to start reading a swapped tensor ahead of its use
+ *
+ */
+class MemorySwapLookahead : public Property<unsigned int> {
+public:
+  static constexpr const char *key =
+    "memory_swap_lookahead";      /**< unique key to access */
+  using prop_tag = uint_prop_tag; /**< property type */
+
+  /**
+   * @brief Constructor
+   *
+   * @param value value to set, defaults to 4
+   */
+  MemorySwapLookahead(unsigned int value = 4);
+};
+
+/**
+ * @brief model async save property, writing the weights saved while training
+ * on a background thread
+ *
+ */
+class AsyncSave : public Property<bool> {
+public:
+  static constexpr const char *key = "async_save"; /**< unique key to access */
+  using prop_tag = bool_prop_tag;                  /**< property type */
+
+  /**
+   * @brief Constructor
+   *
+   * @param value value to set, defaults to false
+   */
+  AsyncSave(bool value = false);
+};
+
+/**
+ * @brief model async update property, applying the gradients of a layer on a
+ * background thread while the layers before it run the backwarding
+ *
+ */
+class AsyncUpdate : public Property<bool> {
+public:
+  static constexpr const char *key =
+    "async_update";                 /**< unique key to access */
+  using prop_tag = bool_prop_tag; /**< property type */
+
+  /**
+   * @brief Constructor
+   *
+   * @param value value to set, defaults to false
+   */
+  AsyncUpdate(bool value = false);
+};
+
+/**
+ * @brief model inference fusion property, fusing the layers of the model for
+ * the inference at compile
+ *
+ */
+class InferenceFusion : public Property<bool> {
+public:
+  static constexpr const char *key =
+    "inference_fusion";           /**< unique key to access */
+  using prop_tag = bool_prop_tag; /**< property type */
+
+  /**
+   * @brief Constructor
+   *
+   * @param value value to set, defaults to false
+   */
+  InferenceFusion(bool value = false);
+};
+
+/**
+ * @brief     Enumeration of the data types to store the optimizer states in
+ */
+struct OptimizerStateTypeInfo {
+  enum class Enum { fp32, fp16, bf16 };
+  static constexpr std::initializer_list<Enum> EnumList = {
+    Enum::fp32, Enum::fp16, Enum::bf16};
+
+  static constexpr const char *EnumStr[] = {"fp32", "fp16", "bf16"};
+};
+
+/**
+ * @brief model optimizer state type property, storing the variables of the
+ * optimizer like the moments of adam in 16 bit floating points
+ *
+ */
+class OptimizerStateType final : public EnumProperty<OptimizerStateTypeInfo> {
+public:
+  static constexpr const char *key =
+    "optimizer_state_type";             /**< unique key to access */
+  using prop_tag = enum_class_prop_tag; /**< property type */
+
+  /**
+   * @brief Constructor
+   *
+   * @param value value to set, defaults to fp32
+   */
+  OptimizerStateType(
+    OptimizerStateTypeInfo::Enum value = OptimizerStateTypeInfo::Enum::fp32);
+};
+
 } // namespace nntrainer::props
 
 #endif
@@ -196,6 +196,8 @@ int ModelLoader::loadDatasetConfigIni(dictionary *ini, NeuralNetwork &model) {
     bufsizepros +=
       iniparser_getstring(ini, "DataSet:BufferSize",
                           iniparser_getstring(ini, "DataSet:buffer_size", "1"));
+    std::string numworkersprops("num_workers=");
+    numworkersprops += iniparser_getstring(ini, "DataSet:num_workers", "1");
 
     auto parse_and_set = [&](const char *key, DatasetModeType dt,
                              bool required) -> int {
@@ -208,7 +210,8 @@ int ModelLoader::loadDatasetConfigIni(dictionary *ini, NeuralNetwork &model) {
       try {
         model.data_buffers[static_cast<int>(dt)] =
           createDataBuffer(DatasetType::FILE, resolvePath(path).c_str());
-        model.data_buffers[static_cast<int>(dt)]->setProperty({bufsizepros});
+        model.data_buffers[static_cast<int>(dt)]->setProperty(
+          {bufsizepros, numworkersprops});
       } catch (...) {
         ml_loge("path is not valid, path: %s", resolvePath(path).c_str());
         return ML_ERROR_INVALID_PARAMETER;
@@ -21,15 +21,22 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <mutex>
+#include <numeric>
 #include <sstream>
+#include <unordered_set>
 
 #include <activation_realizer.h>
 #include <databuffer.h>
 #include <flatten_realizer.h>
+#include <fusion_realizer.h>
 #include <ini_interpreter.h>
 #include <ini_wrapper.h>
 #include <input_realizer.h>
@@ -56,12 +63,127 @@
 
 namespace nntrainer {
 
+/**
+ * @brief magic to identify the weight file of MODEL_FORMAT_MMAP
+ */
+static constexpr const char MMAP_WEIGHT_MAGIC[8] = {'N', 'N', 'T', 'R',
+                                                    'M', 'M', 'A', 'P'};
+
+/**
+ * @brief version of the weight file of MODEL_FORMAT_MMAP
+ */
+static constexpr const uint32_t MMAP_WEIGHT_VERSION = 1;
+
+/**
+ * @brief alignment of each weight in the weight file of MODEL_FORMAT_MMAP, so
+ * that the kernels can use the mapped weights as they are
+ */
+static constexpr const size_t MMAP_WEIGHT_ALIGNMENT = 64;
+
+/**
+ * @brief header of the weight file of MODEL_FORMAT_MMAP, followed by an entry
+ * of the offset table for each weight and then the data of the weights
+ */
+struct MappedWeightHeader {
+  char magic[8];         /**< MMAP_WEIGHT_MAGIC */
+  uint32_t version;      /**< MMAP_WEIGHT_VERSION */
+  uint32_t num_weights;  /**< number of the weights */
+  uint32_t epoch_idx;    /**< epoch index of the model */
+  uint32_t iteration;    /**< iterations trained */
+};
+
+/**
+ * @brief entry of the offset table of the weight file of MODEL_FORMAT_MMAP
+ */
+struct MappedWeightEntry {
+  uint64_t offset; /**< byte offset of the data from the start of the file */
+  uint64_t bytes;  /**< byte size of the data */
+};
+
+/**
+ * @brief get the weights of the graph in the order they are saved, where the
+ * shared weights are saved once
+ */
+static std::vector<Tensor *> getWeightsToSave(const NetworkGraph &graph) {
+  std::vector<Tensor *> weights;
+  for (auto iter = graph.cbegin(); iter != graph.cend(); iter++) {
+    auto &rc = (*iter)->getRunContext();
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+      if (rc.isGradientLastAccess(i)) {
+        weights.push_back(&rc.getWeight(i));
+      }
+    }
+  }
+  return weights;
+}
+
+/**
+ * @brief get the optimizer variables of the weights to save, in the order of
+ * the weights, empty if they are not allocated
+ */
+static std::vector<Tensor *>
+getOptimizerVariablesToSave(const NetworkGraph &graph) {
+  std::vector<Tensor *> vars;
+  for (auto iter = graph.cbegin(); iter != graph.cend(); iter++) {
+    auto &rc = (*iter)->getRunContext();
+    for (unsigned int i = 0; i < rc.getNumWeights(); ++i) {
+      if (!rc.isGradientLastAccess(i))
+        continue;
+
+      auto &w = rc.getWeightObject(i);
+      for (unsigned int j = 0; j < w.getNumOptVariable(); ++j) {
+        auto &var = w.getOptimizerVariableRef(j);
+        if (!var.isAllocated())
+          return {};
+        vars.push_back(&var);
+      }
+    }
+  }
+  return vars;
+}
+
+/**
+ * @brief write to a temporary file next to the file, then rename it to the
+ * file so that the file is never left half written
+ */
+static void writeAtomically(const std::string &file_path,
+                            const std::function<void(std::ofstream &)> &write) {
+  std::string temp_path = file_path + ".tmp";
+  auto file = checkedOpenStream<std::ofstream>(
+    temp_path, std::ios::out | std::ios::binary);
+  write(file);
+  file.close();
+  NNTR_THROW_IF(file.fail(), std::runtime_error)
+    << "failed to close " << temp_path;
+
+  NNTR_THROW_IF(std::rename(temp_path.c_str(), file_path.c_str()) != 0,
+                std::runtime_error)
+    << "failed to rename " << temp_path << " to " << file_path;
+}
+
+/**
+ * @brief check if the file is the weight file of MODEL_FORMAT_MMAP
+ */
+static bool isMappedWeightFile(const std::string &file_path) {
+  std::ifstream file(file_path, std::ios::in | std::ios::binary);
+  char magic[sizeof(MMAP_WEIGHT_MAGIC)];
+  return file.read(magic, sizeof(magic)) &&
+         std::memcmp(magic, MMAP_WEIGHT_MAGIC, sizeof(magic)) == 0;
+}
+
 NeuralNetwork::NeuralNetwork(AppContext app_context_) :
   model_props(props::LossType(), {}, {}),
   model_flex_props(props::Epochs(), props::TrainingBatchSize(),
                    props::SavePath(), props::ContinueTrain(),
-                   props::SaveBestPath(), props::MemoryOptimization()),
+                   props::SaveBestPath(), props::MemoryOptimization(),
+                   props::MemoryPlanner(), props::NumThreads(),
+                   props::LossScale(), props::MemorySwap(),
+                   props::MemorySwapPath(), props::MemorySwapLookahead(),
+                   props::AsyncSave(), props::InferenceFusion(),
+                   props::ParallelLayers(), props::AsyncUpdate(),
+                   props::OptimizerStateType()),
   load_path(std::string()),
+  opt_load_offset(0),
   epoch_idx(0),
   iter(0),
   loss(0.0f),
@@ -69,6 +191,10 @@ NeuralNetwork::NeuralNetwork(AppContext app_context_) :
   initialized(false),
   compiled(false),
   loadedFromConfig(false),
+  inference_session(false),
+  loss_scale(1.0f),
+  loss_scale_iterations(0),
+  save_buffer(nullptr),
   app_context(app_context_) {}
 
 int NeuralNetwork::loadFromConfig(const std::string &config) {
@@ -137,6 +263,9 @@ int NeuralNetwork::compile() {
   realizers.emplace_back(new PreviousInputRealizer(input_layers));
   realizers.emplace_back(new MultioutRealizer());
   realizers.emplace_back(new FlattenRealizer());
+  if (std::get<props::InferenceFusion>(model_flex_props)) {
+    realizers.emplace_back(new FusionRealizer());
+  }
   realizers.emplace_back(new ActivationRealizer());
 
   for (auto &realizer : realizers) {
@@ -146,6 +275,16 @@ int NeuralNetwork::compile() {
   model_graph = NetworkGraph();
   model_graph.setMemoryOptimizations(
     std::get<props::MemoryOptimization>(model_flex_props));
+  model_graph.setMemoryPlanner(
+    to_string(std::get<props::MemoryPlanner>(model_flex_props)));
+  model_graph.setMemorySwap(
+    std::get<props::MemorySwap>(model_flex_props)
+      ? std::get<props::MemorySwapPath>(model_flex_props).get()
+      : "",
+    std::get<props::MemorySwapLookahead>(model_flex_props));
+  model_graph.setNumThreads(std::get<props::NumThreads>(model_flex_props));
+  model_graph.setParallelLayers(
+    std::get<props::ParallelLayers>(model_flex_props));
   for (auto &node : rep) {
     model_graph.addLayer(node);
   }
@@ -195,9 +334,15 @@ int NeuralNetwork::initialize() {
                                             label_layer_prop.end());
   }
 
+  /** the gradients are kept until the updates in background are done */
+  bool async_update = std::get<props::AsyncUpdate>(model_flex_props);
+  model_graph.setAsyncUpdate(async_update);
   status = model_graph.initialize(input_layers, label_layers);
   NN_RETURN_STATUS();
 
+  if (async_update)
+    update_pool = std::make_shared<ThreadPool>(2);
+
   // initialize optimizer and related variables
   if (opt) {
     /** TODO: update request of optimizer to be of same format as
@@ -207,16 +352,28 @@ int NeuralNetwork::initialize() {
       [this](const TensorDim &dim) {
         return opt->getOptimizerVariableDim(dim);
       };
-    model_graph.requestOptimizerVariable(cb, true);
+    using StateType = props::OptimizerStateTypeInfo::Enum;
+    StateType state_type = std::get<props::OptimizerStateType>(model_flex_props);
+    Tensor::DataType opt_type = state_type == StateType::fp16
+                                  ? Tensor::DataType::FP16
+                                : state_type == StateType::bf16
+                                  ? Tensor::DataType::BF16
+                                  : Tensor::DataType::FP32;
+    model_graph.requestOptimizerVariable(cb, true, opt_type);
   }
 
-  // Allocate weights
-  model_graph.allocateWeights();
+  /** weights mapped from the file to load are not allocated */
+  bool map_weights = !load_path.empty() && isMappedWeightFile(load_path);
+  if (!map_weights)
+    model_graph.allocateWeights();
 
   initialized = true;
 
   if (!load_path.empty()) {
-    load(load_path, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+    load(load_path, map_weights ? ml::train::ModelFormat::MODEL_FORMAT_MMAP
+                                : ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  } else {
+    model_graph.prepareWeights();
   }
 
   return status;
@@ -254,6 +411,28 @@ sharedConstTensors NeuralNetwork::forwarding(sharedConstTensors input,
   return forwarding(training);
 }
 
+/**
+ * @brief     number of iterations without an overflow to raise the loss scale
+ */
+static constexpr unsigned int LOSS_SCALE_GROWTH_INTERVAL = 2000;
+
+/**
+ * @brief     scale the gradient of the weight back down by the loss scale
+ *
+ * @param w weight of the gradient
+ * @param scale loss scale
+ * @return true if the gradient is finite, false if it has overflowed
+ */
+static bool unscaleGradient(Weight &w, float scale) {
+  Tensor &grad = w.hasSparseGradient() ? w.getSparseGradientValues()
+                                       : w.getGradientRef();
+  grad.multiply_i(1.0f / scale);
+
+  const float *data = grad.getData();
+  return std::all_of(data, data + grad.size(),
+                     [](float val) { return std::isfinite(val); });
+}
+
 /**
  * @brief     back propagation
  *            Call backwarding function of layer in reverse order
@@ -265,8 +444,40 @@ void NeuralNetwork::backwarding(int iteration) {
   NNTR_THROW_IF(!opt, std::invalid_argument) << "optimizer is null!";
 #endif
 
+  unsigned int num_threads = std::get<props::NumThreads>(model_flex_props);
+  float scale = loss_scale;
+  /** the nodes of a level and the updates can run concurrently */
+  std::atomic<bool> overflow(false);
+  std::mutex scaled_mutex;
+  std::vector<Weight *> scaled_weights;
+
+  std::function<void(Weight &)> apply = [iteration, num_threads,
+                                         opt_ = opt.get()](Weight &w) {
+    if (w.hasSparseGradient() && !opt_->supportSparseGradient())
+      w.densifyGradient();
+    w.calcRegularizationGradient();
+    RunOptimizerContext opt_context(&w, iteration, num_threads);
+    opt_->applyGradient(opt_context);
+    w.clearSparseGradient();
+  };
+
+  /** with the loss scaled, no weight is updated until all the gradients are
+   * known to be finite, so that an overflow skips the whole step */
+  std::function<void(Weight &)> update =
+    [scale, &apply, &overflow, &scaled_mutex, &scaled_weights](Weight &w) {
+      if (scale == 1.0f) {
+        apply(w);
+        return;
+      }
+      if (!unscaleGradient(w, scale))
+        overflow = true;
+      std::lock_guard<std::mutex> lock(scaled_mutex);
+      scaled_weights.push_back(&w);
+    };
+
   std::function<void(std::shared_ptr<LayerNode>, int)> backwarding_op =
-    [this](std::shared_ptr<LayerNode> node, int iteration) -> void {
+    [this, scale, &update](std::shared_ptr<LayerNode> node,
+                           int iteration) -> void {
     /**
      * Do not change this order:
      * 1. calcGradient
@@ -297,21 +508,68 @@ void NeuralNetwork::backwarding(int iteration) {
     if (!dynamic_training_opt.isGradientMode() && apply_gradient)
       node->calcGradient();
 
-    if (node->needsCalcDerivative())
+    if (node->needsCalcDerivative()) {
       node->calcDerivative();
 
+      /// the loss is scaled up from the derivative of the loss layer
+      if (scale != 1.0f && node->requireLabel()) {
+        auto &rc = node->getRunContext();
+        for (unsigned int i = 0; i < rc.getNumInputs(); ++i)
+          rc.getOutgoingDerivative(i).multiply_i(scale);
+      }
+    }
+
     if (apply_gradient) {
       /// Apply gradient only at the end of the last shared weight access
       model_graph.applyGradientsOnLastAccess(
-        node.get(), [iteration, opt_ = opt.get()](Weight &w) {
-          w.calcRegularizationGradient();
-          RunOptimizerContext opt_context(&w, iteration);
-          opt_->applyGradient(opt_context);
+        node.get(), [this, &update](Weight &w) {
+          /** the gradient is final, so it is applied while the nodes before
+           * run the backwarding */
+          if (update_pool)
+            update_pool->submit([&update, &w] { update(w); });
+          else
+            update(w);
         });
     }
   };
 
-  model_graph.backwarding(iteration, backwarding_op);
+  if (update_pool) {
+    try {
+      model_graph.backwarding(iteration, backwarding_op);
+    } catch (...) {
+      /** the updates refer to this frame, so they are waited for anyway */
+      try {
+        update_pool->wait();
+      } catch (...) {
+      }
+      throw;
+    }
+    /** the next forwarding reads the updated weights */
+    update_pool->wait();
+  } else {
+    model_graph.backwarding(iteration, backwarding_op);
+  }
+
+  if (scale == 1.0f)
+    return;
+
+  for (auto &w : scaled_weights) {
+    if (!overflow)
+      apply(*w);
+    else
+      w->clearSparseGradient();
+  }
+
+  if (overflow) {
+    loss_scale = std::max(1.0f, loss_scale / 2.0f);
+    loss_scale_iterations = 0;
+    ml_logw("gradient overflowed at iteration %d, loss scale lowered to %f",
+            iteration, loss_scale);
+  } else if (++loss_scale_iterations >= LOSS_SCALE_GROWTH_INTERVAL) {
+    loss_scale = std::min(loss_scale * 2.0f,
+                          std::get<props::LossScale>(model_flex_props).get());
+    loss_scale_iterations = 0;
+  }
 }
 
 void NeuralNetwork::save(const std::string &file_path,
@@ -320,17 +578,63 @@ void NeuralNetwork::save(const std::string &file_path,
     << "Cannot save model if not initialized yet, path: " << file_path
     << " format: " << static_cast<unsigned>(format);
 
+  /** the checkpoint being written must not interleave with this */
+  waitCheckpoint();
+
   /// @todo this switch case should be delegating the function call only. It's
   /// not delegating for now as required logics are managable for now.
   switch (format) {
   case ml::train::ModelFormat::MODEL_FORMAT_BIN: {
+    /** the optimizer variables follow while they are allocated for training */
+    auto opt_vars = getOptimizerVariablesToSave(model_graph);
+    writeAtomically(file_path, [this, &opt_vars](std::ofstream &model_file) {
+      for (auto iter = model_graph.cbegin(); iter != model_graph.cend();
+           iter++) {
+        (*iter)->save(model_file);
+      }
+      checkedWrite(model_file, (char *)&epoch_idx, sizeof(epoch_idx),
+                   "[NeuralNetwork::save] failed to write epoch_idx");
+      checkedWrite(model_file, (char *)&iter, sizeof(iter),
+                   "[NeuralNetwork::save] failed to write iteration");
+      for (auto &var : opt_vars)
+        var->save(model_file);
+    });
+    break;
+  }
+  case ml::train::ModelFormat::MODEL_FORMAT_MMAP: {
+    auto weights = getWeightsToSave(model_graph);
+    MappedWeightHeader header;
+    std::memcpy(header.magic, MMAP_WEIGHT_MAGIC, sizeof(header.magic));
+    header.version = MMAP_WEIGHT_VERSION;
+    header.num_weights = weights.size();
+    header.epoch_idx = epoch_idx;
+    header.iteration = iter;
+
+    std::vector<MappedWeightEntry> entries;
+    size_t offset = sizeof(header) + weights.size() * sizeof(MappedWeightEntry);
+    for (auto &w : weights) {
+      offset = (offset + MMAP_WEIGHT_ALIGNMENT - 1) / MMAP_WEIGHT_ALIGNMENT *
+               MMAP_WEIGHT_ALIGNMENT;
+      entries.push_back({offset, w->bytes()});
+      offset += w->bytes();
+    }
+
     auto model_file = checkedOpenStream<std::ofstream>(
       file_path, std::ios::out | std::ios::binary);
-    for (auto iter = model_graph.cbegin(); iter != model_graph.cend(); iter++) {
-      (*iter)->save(model_file);
+    checkedWrite(model_file, (char *)&header, sizeof(header),
+                 "[NeuralNetwork::save] failed to write header");
+    checkedWrite(model_file, (char *)entries.data(),
+                 entries.size() * sizeof(MappedWeightEntry),
+                 "[NeuralNetwork::save] failed to write offset table");
+
+    const char padding[MMAP_WEIGHT_ALIGNMENT] = {};
+    size_t written = sizeof(header) + entries.size() * sizeof(MappedWeightEntry);
+    for (unsigned int i = 0; i < weights.size(); ++i) {
+      checkedWrite(model_file, padding, entries[i].offset - written,
+                   "[NeuralNetwork::save] failed to write padding");
+      weights[i]->save(model_file);
+      written = entries[i].offset + entries[i].bytes;
     }
-    model_file.write((char *)&epoch_idx, sizeof(epoch_idx));
-    model_file.write((char *)&iter, sizeof(iter));
     model_file.close();
     break;
   }
@@ -357,6 +661,8 @@ void NeuralNetwork::save(const std::string &file_path,
 
 void NeuralNetwork::load(const std::string &file_path,
                          ml::train::ModelFormat format) {
+  waitCheckpoint();
+
   /// @todo this switch case should be delegating the function call only. It's
   /// not delegating for now as required logics are managable for now.
   switch (format) {
@@ -382,9 +688,61 @@ void NeuralNetwork::load(const std::string &file_path,
       std::cerr << "failed to read epoch idx, proceeding with default index\n";
     }
 
+    /** the optimizer variables are read once allocated for the training */
+    opt_load_path.clear();
+    if (model_file && model_file.peek() != std::ifstream::traits_type::eof()) {
+      opt_load_path = file_path;
+      opt_load_offset = model_file.tellg();
+      loadOptimizerVariables();
+    }
+
+    model_graph.prepareWeights();
     ml_logi("read modelfile: %s", file_path.c_str());
     break;
   }
+  case ml::train::ModelFormat::MODEL_FORMAT_MMAP: {
+    NNTR_THROW_IF(!initialized, std::runtime_error)
+      << "Cannot load if not initialized yet, path: " << file_path
+      << " format: " << static_cast<unsigned>(format);
+
+    auto model_file = std::make_shared<MMapedMemory>(file_path);
+    auto header = model_file->typedBuffer<MappedWeightHeader>();
+    NNTR_THROW_IF(model_file->size() < sizeof(MappedWeightHeader) ||
+                    std::memcmp(header->magic, MMAP_WEIGHT_MAGIC,
+                                sizeof(header->magic)) != 0 ||
+                    header->version != MMAP_WEIGHT_VERSION,
+                  std::runtime_error)
+      << "not a weight file to map, path: " << file_path;
+
+    auto weights = getWeightsToSave(model_graph);
+    NNTR_THROW_IF(header->num_weights != weights.size() ||
+                    model_file->size() <
+                      sizeof(MappedWeightHeader) +
+                        weights.size() * sizeof(MappedWeightEntry),
+                  std::runtime_error)
+      << "number of the weights does not match, path: " << file_path
+      << " saved: " << header->num_weights << " model: " << weights.size();
+
+    /** the weights become views of the mapped file without any copy */
+    auto entries = reinterpret_cast<MappedWeightEntry *>(header + 1);
+    std::unordered_map<std::string, size_t> offsets;
+    for (unsigned int i = 0; i < weights.size(); ++i) {
+      NNTR_THROW_IF(entries[i].bytes != weights[i]->bytes() ||
+                      entries[i].offset % MMAP_WEIGHT_ALIGNMENT != 0,
+                    std::runtime_error)
+        << "weight does not match, name: " << weights[i]->getName()
+        << " path: " << file_path;
+      offsets[weights[i]->getName()] = entries[i].offset;
+    }
+
+    model_graph.mapWeights(model_file, offsets);
+
+    epoch_idx = header->epoch_idx;
+    iter = header->iteration;
+    model_graph.prepareWeights();
+    ml_logi("mapped modelfile: %s", file_path.c_str());
+    break;
+  }
   case ml::train::ModelFormat::MODEL_FORMAT_INI_WITH_BIN: {
     int ret = loadFromConfig(file_path);
     throw_status(ret);
@@ -516,13 +874,19 @@ sharedConstTensors NeuralNetwork::inference(sharedConstTensors X,
   if (!validateInput(X))
     throw std::invalid_argument("Input validation failed.");
 
-  allocate(ExecutionMode::INFERENCE);
+  /**
+   * in an inference session, the memory planned for the current batch size is
+   * reused. Changing the batch size above re-plans the allocated pool.
+   */
+  if (!inference_session || !model_graph.isAllocated() ||
+      model_graph.getExecutionMode() != ExecutionMode::INFERENCE)
+    allocate(ExecutionMode::INFERENCE);
 
   START_PROFILE(profile::NN_FORWARD);
   out = forwarding(X, label, false);
   END_PROFILE(profile::NN_FORWARD);
 
-  if (free_mem)
+  if (free_mem && !inference_session)
     /**
      * Free the memory needed for training before exiting.
      * Note that this does not free the weights for the model.
@@ -582,7 +946,11 @@ int NeuralNetwork::setDataset(const DatasetModeType &mode,
 
 int NeuralNetwork::allocate(ExecutionMode mode) {
   model_graph.deallocateTensors();
+  /** weights allocated again are initialized again */
+  bool weight_allocated = model_graph.isWeightAllocated();
   model_graph.allocateTensors(mode);
+  if (!weight_allocated)
+    model_graph.prepareWeights();
 
   return ML_ERROR_NONE;
 }
@@ -593,6 +961,184 @@ int NeuralNetwork::deallocate() {
   return ML_ERROR_NONE;
 }
 
+int NeuralNetwork::startInferenceSession() {
+  if (!initialized) {
+    ml_loge("Cannot start inference session before initializing the model");
+    return ML_ERROR_INVALID_PARAMETER;
+  }
+
+  inference_session = true;
+  return ML_ERROR_NONE;
+}
+
+int NeuralNetwork::stopInferenceSession() {
+  if (!inference_session)
+    return ML_ERROR_NONE;
+
+  inference_session = false;
+  /** weights are kept, as it is done after the inference without session */
+  model_graph.deallocateTensors(false);
+
+  return ML_ERROR_NONE;
+}
+
+std::unique_ptr<ml::train::Model> NeuralNetwork::createInferenceContext() {
+  NNTR_THROW_IF(!initialized, std::invalid_argument)
+    << "Cannot create inference context before initializing the model";
+
+  /** weights of the context are borrowed from this model */
+  model_graph.allocateWeights();
+
+  auto context = std::make_unique<NeuralNetwork>(app_context);
+  context->model_props = model_props;
+  context->model_flex_props = model_flex_props;
+
+  /**
+   * the graph of this model is already realized, so the nodes are recreated
+   * from their properties in the execution order without realizing again
+   */
+  NetworkGraph &graph = context->model_graph;
+  graph.setMemoryOptimizations(
+    std::get<props::MemoryOptimization>(model_flex_props));
+  graph.setMemoryPlanner(
+    to_string(std::get<props::MemoryPlanner>(model_flex_props)));
+  graph.setNumThreads(std::get<props::NumThreads>(model_flex_props));
+  for (auto iter = model_graph.cbegin(); iter != model_graph.cend(); iter++) {
+    auto const &node = *iter;
+    Exporter e;
+    node->exportTo(e, ExportMethods::METHOD_STRINGVECTOR);
+    auto key_val_pairs = e.getResult<ExportMethods::METHOD_STRINGVECTOR>();
+
+    std::vector<std::string> properties;
+    properties.reserve(key_val_pairs->size());
+    for (auto const &[key, value] : *key_val_pairs) {
+      properties.push_back(key + "=" + value);
+    }
+
+    graph.addLayer(createLayerNode(
+      app_context.createObject<Layer>(node->getType()), properties));
+  }
+
+  /** loss layers have been added to the graph of this model already */
+  int status = graph.compile("");
+  NNTR_THROW_IF(status != ML_ERROR_NONE, std::runtime_error)
+    << "Compiling the graph of the inference context failed";
+  context->compiled = true;
+
+  graph.setBatchSize(model_graph.getBatchSize());
+
+  auto &input_layer_prop =
+    std::get<std::vector<props::InputLayer>>(model_props);
+  auto &label_layer_prop =
+    std::get<std::vector<props::LabelLayer>>(model_props);
+  status = graph.initialize(
+    std::vector<std::string>(input_layer_prop.begin(), input_layer_prop.end()),
+    std::vector<std::string>(label_layer_prop.begin(), label_layer_prop.end()));
+  NNTR_THROW_IF(status != ML_ERROR_NONE, std::runtime_error)
+    << "Initializing the graph of the inference context failed";
+
+  graph.borrowWeights(model_graph);
+  context->initialized = true;
+
+  return context;
+}
+
+int NeuralNetwork::quantize(
+  std::shared_ptr<ml::train::Dataset> calibration_set) {
+  if (!initialized) {
+    ml_loge("Cannot quantize the model before initializing the model");
+    return ML_ERROR_INVALID_PARAMETER;
+  }
+
+  if (calibration_set == nullptr) {
+    ml_loge("Cannot quantize the model without the calibration dataset");
+    return ML_ERROR_INVALID_PARAMETER;
+  }
+
+  auto buffer = std::static_pointer_cast<DataBuffer>(calibration_set);
+  auto batch_size = model_graph.getBatchSize();
+  auto in_dims = model_graph.getInputDimension();
+  auto label_dims = model_graph.getOutputDimension();
+
+  allocate(ExecutionMode::INFERENCE);
+
+  /** maximum absolute value of the input of each layer in the graph order */
+  std::vector<float> input_ranges(model_graph.size(), 0.0f);
+  unsigned int num_iterations = 0;
+
+  /** the nodes are run by the forwarding order, which can differ from the
+   * graph order when the independent nodes run concurrently */
+  std::vector<unsigned int> sequence(model_graph.size());
+  std::iota(sequence.begin(), sequence.end(), 0);
+  std::stable_sort(sequence.begin(), sequence.end(),
+                   [this](unsigned int lhs, unsigned int rhs) {
+                     return std::get<0>(model_graph.getSortedLayerNode(lhs)
+                                          ->getExecutionOrder()) <
+                            std::get<0>(model_graph.getSortedLayerNode(rhs)
+                                          ->getExecutionOrder());
+                   });
+
+  std::future<std::shared_ptr<IterationQueue>> future_iq =
+    buffer->startFetchWorker(in_dims, label_dims, false);
+  while (true) {
+    ScopedView<Iteration> iter_view = buffer->fetch();
+    if (iter_view.isEmpty()) {
+      break;
+    }
+    auto &iteration = iter_view.get();
+    if (iteration.batch() != batch_size) {
+      continue;
+    }
+
+    model_graph.setInputsLabels(iteration.getInputsRef(),
+                                iteration.getLabelsRef());
+
+    for (auto idx : sequence) {
+      auto const &node = model_graph.getSortedLayerNode(idx);
+      if (node->supportQuantization()) {
+        input_ranges[idx] =
+          std::max(input_ranges[idx], node->getInput(0).max_abs());
+      }
+      node->forwarding(false);
+    }
+    num_iterations++;
+  }
+  future_iq.get();
+
+  model_graph.setInputsLabels({}, {});
+
+  if (num_iterations == 0) {
+    ml_loge("No data came from the calibration dataset");
+    model_graph.deallocateTensors(false);
+    return ML_ERROR_INVALID_PARAMETER;
+  }
+
+  /** the weight is packed with the scale of the input of a single layer, so
+   * the layers sharing weights keep running in fp32 */
+  std::unordered_set<std::string> shared;
+  for (auto iter = model_graph.cbegin(); iter != model_graph.cend(); iter++) {
+    auto const &shared_from = (*iter)->getSharedFrom();
+    if (!shared_from.empty()) {
+      shared.insert(shared_from);
+      shared.insert((*iter)->getName());
+    }
+  }
+
+  unsigned int idx = 0;
+  for (auto iter = model_graph.cbegin(); iter != model_graph.cend();
+       iter++, idx++) {
+    auto const &node = *iter;
+    if (node->supportQuantization() && shared.count(node->getName()) == 0) {
+      node->quantize(input_ranges[idx]);
+    }
+  }
+
+  if (!inference_session)
+    model_graph.deallocateTensors(false);
+
+  return ML_ERROR_NONE;
+}
+
 int NeuralNetwork::train(const std::vector<std::string> &values) {
   int status = ML_ERROR_NONE;
 
@@ -606,14 +1152,26 @@ int NeuralNetwork::train(const std::vector<std::string> &values) {
     return ML_ERROR_INVALID_PARAMETER;
   }
 
+  if (std::get<props::InferenceFusion>(model_flex_props)) {
+    ml_loge("Cannot train network fused for the inference.");
+    return ML_ERROR_NOT_SUPPORTED;
+  }
+
   setTrainConfig(values);
 
+  loss_scale = std::get<props::LossScale>(model_flex_props);
+  loss_scale_iterations = 0;
+  /** the scaled gradients are applied once all of them are checked */
+  if (loss_scale != 1.0f)
+    model_graph.keepGradients();
+
   /** set batch size just before training */
   model_graph.setBatchSize(
     std::get<props::TrainingBatchSize>(model_flex_props));
 
   status = allocate(ExecutionMode::TRAIN);
   NN_RETURN_STATUS();
+  loadOptimizerVariables();
 
   status = train_run();
   NN_RETURN_STATUS();
@@ -719,7 +1277,7 @@ int NeuralNetwork::train_run() {
     stat.loss /= static_cast<float>(stat.num_iterations);
     auto &save_path = std::get<props::SavePath>(model_flex_props);
     if (!save_path.empty()) {
-      save(save_path, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+      saveCheckpoint(save_path);
     }
 
     std::cout << "#" << epoch_idx << "/" << getEpochs()
@@ -762,7 +1320,7 @@ int NeuralNetwork::train_run() {
       min_loss = stat.loss;
       auto &save_best_path = std::get<props::SaveBestPath>(model_flex_props);
       if (!save_best_path.empty()) {
-        save(save_best_path);
+        saveCheckpoint(save_best_path);
       }
     }
     std::cout << " >> [ Accuracy: " << stat.accuracy
@@ -790,10 +1348,90 @@ int NeuralNetwork::train_run() {
 
   /** Clear the set inputs and labels */
   model_graph.setInputsLabels({}, {});
+  waitCheckpoint();
 
   return status;
 }
 
+void NeuralNetwork::saveCheckpoint(const std::string &file_path) {
+  if (!std::get<props::AsyncSave>(model_flex_props)) {
+    save(file_path, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+    return;
+  }
+
+  /** the snapshot of the previous checkpoint is reused once it is written */
+  waitCheckpoint();
+
+  auto weights = getWeightsToSave(model_graph);
+  auto opt_vars = getOptimizerVariablesToSave(model_graph);
+  size_t size = sizeof(epoch_idx) + sizeof(iter);
+  for (auto &w : weights)
+    size += w->bytes();
+  for (auto &var : opt_vars)
+    size += var->bytes();
+
+  if (!save_buffer)
+    save_buffer = std::make_shared<std::vector<char>>();
+  save_buffer->resize(size);
+
+  /** same layout as MODEL_FORMAT_BIN */
+  char *data = save_buffer->data();
+  for (auto &w : weights) {
+    std::memcpy(data, w->getData<char>(), w->bytes());
+    data += w->bytes();
+  }
+  std::memcpy(data, &epoch_idx, sizeof(epoch_idx));
+  data += sizeof(epoch_idx);
+  std::memcpy(data, &iter, sizeof(iter));
+  data += sizeof(iter);
+  for (auto &var : opt_vars) {
+    std::memcpy(data, var->getData<char>(), var->bytes());
+    data += var->bytes();
+  }
+
+  pending_save = std::async(
+    std::launch::async, [file_path, buffer = save_buffer] {
+      writeAtomically(file_path, [&buffer](std::ofstream &model_file) {
+        checkedWrite(model_file, buffer->data(), buffer->size(),
+                     "[NeuralNetwork::saveCheckpoint] failed to write");
+      });
+    }).share();
+}
+
+void NeuralNetwork::loadOptimizerVariables() {
+  auto opt_vars = getOptimizerVariablesToSave(model_graph);
+  if (opt_load_path.empty() || opt_vars.empty())
+    return;
+
+  auto model_file = checkedOpenStream<std::ifstream>(
+    opt_load_path, std::ios::in | std::ios::binary);
+  model_file.seekg(0, std::ios::end);
+  size_t size = static_cast<size_t>(model_file.tellg()) - opt_load_offset;
+  opt_load_path.clear();
+
+  size_t bytes = 0;
+  for (auto &var : opt_vars)
+    bytes += var->bytes();
+  if (size != bytes) {
+    ml_logw("optimizer variables saved do not match the optimizer, saved: "
+            "%zu bytes, optimizer: %zu bytes, they are not loaded",
+            size, bytes);
+    return;
+  }
+
+  model_file.seekg(opt_load_offset);
+  for (auto &var : opt_vars)
+    var->read(model_file);
+}
+
+void NeuralNetwork::waitCheckpoint() {
+  if (!pending_save.valid())
+    return;
+
+  auto pending = std::move(pending_save);
+  pending.get();
+}
+
 void swap(NeuralNetwork &lhs, NeuralNetwork &rhs) {
   {
     using std::swap;
@@ -801,6 +1439,8 @@ void swap(NeuralNetwork &lhs, NeuralNetwork &rhs) {
     swap(lhs.model_props, rhs.model_props);
     swap(lhs.model_flex_props, rhs.model_flex_props);
     swap(lhs.load_path, rhs.load_path);
+    swap(lhs.opt_load_path, rhs.opt_load_path);
+    swap(lhs.opt_load_offset, rhs.opt_load_offset);
     swap(lhs.epoch_idx, rhs.epoch_idx);
     swap(lhs.iter, rhs.iter);
     swap(lhs.loss, rhs.loss);
@@ -810,6 +1450,12 @@ void swap(NeuralNetwork &lhs, NeuralNetwork &rhs) {
     swap(lhs.model_graph, rhs.model_graph);
     swap(lhs.compiled, rhs.compiled);
     swap(lhs.loadedFromConfig, rhs.loadedFromConfig);
+    swap(lhs.inference_session, rhs.inference_session);
+    swap(lhs.loss_scale, rhs.loss_scale);
+    swap(lhs.loss_scale_iterations, rhs.loss_scale_iterations);
+    swap(lhs.save_buffer, rhs.save_buffer);
+    swap(lhs.pending_save, rhs.pending_save);
+    swap(lhs.update_pool, rhs.update_pool);
   }
 }
 
@@ -1000,6 +1646,17 @@ void NeuralNetwork::print(std::ostream &out, unsigned int flags,
   if (flags & PRINT_GRAPH_INFO) {
     out << "graph contains " << model_graph.size() << " operation nodes\n";
     /// @todo print graph info
+
+    auto [planned, minimum] = model_graph.getTensorMemoryPlan();
+    if (planned > 0) {
+      out << "memory planner: "
+          << (std::get<props::MemoryOptimization>(model_flex_props)
+                ? to_string(std::get<props::MemoryPlanner>(model_flex_props))
+                : BasicPlanner::type)
+          << ", planned " << planned << " bytes for " << minimum
+          << " bytes of the minimum, efficiency "
+          << double(minimum) / double(planned) << '\n';
+    }
   }
 
   if (flags & PRINT_PROP) {
@@ -25,6 +25,7 @@
 #ifdef __cplusplus
 
 #include <array>
+#include <future>
 #include <map>
 #include <memory>
 #include <tuple>
@@ -43,6 +44,7 @@
 #include <network_graph.h>
 #include <optimizer_devel.h>
 #include <tensor.h>
+#include <thread_pool.h>
 
 #include <model.h>
 #include <nntrainer-api-common.h>
@@ -180,6 +182,26 @@ public:
    */
   int deallocate();
 
+  /**
+   * @copydoc Model::startInferenceSession()
+   */
+  int startInferenceSession() override;
+
+  /**
+   * @copydoc Model::stopInferenceSession()
+   */
+  int stopInferenceSession() override;
+
+  /**
+   * @copydoc Model::createInferenceContext()
+   */
+  std::unique_ptr<ml::train::Model> createInferenceContext() override;
+
+  /**
+   * @copydoc Model::quantize(std::shared_ptr<Dataset> calibration_set)
+   */
+  int quantize(std::shared_ptr<ml::train::Dataset> calibration_set) override;
+
   /**
    * @brief     Update graph to make batch normalization in-place
    * @note      This assumes that the batch normalization implementation does
@@ -487,7 +509,12 @@ private:
   using FlexiblePropTypes =
     std::tuple<props::Epochs, props::TrainingBatchSize, props::SavePath,
                props::ContinueTrain, props::SaveBestPath,
-               props::MemoryOptimization>;
+               props::MemoryOptimization, props::MemoryPlanner,
+               props::NumThreads, props::LossScale, props::MemorySwap,
+               props::MemorySwapPath, props::MemorySwapLookahead,
+               props::AsyncSave, props::InferenceFusion,
+               props::ParallelLayers, props::AsyncUpdate,
+               props::OptimizerStateType>;
   using RigidPropTypes =
     std::tuple<props::LossType, std::vector<props::InputLayer>,
                std::vector<props::LabelLayer>>;
@@ -495,6 +522,10 @@ private:
   RigidPropTypes model_props;         /**< model props */
   FlexiblePropTypes model_flex_props; /**< model train props */
   std::string load_path; /**< path to load weights when initialize  */
+  std::string opt_load_path; /**< path to load the optimizer variables from
+                                once they are allocated, empty if none */
+  size_t opt_load_offset;    /**< offset of the optimizer variables in the
+                                file of opt_load_path */
 
   /**
    * @brief   Print Options when printing layer info
@@ -527,6 +558,24 @@ private:
 
   bool loadedFromConfig; /**< Check if config is loaded to prevent load twice */
 
+  bool inference_session; /**< keep the memory allocated for inference across
+                             the calls of inference */
+
+  float loss_scale; /**< current scale of the loss, lowered on an overflow of
+                       the gradients and raised back up to the property */
+
+  unsigned int loss_scale_iterations; /**< iterations since the loss scale
+                                         has been changed */
+
+  std::shared_ptr<std::vector<char>> save_buffer; /**< snapshot of the weights
+                                                     being saved in background */
+
+  std::shared_future<void> pending_save; /**< save running in background */
+
+  std::shared_ptr<ThreadPool> update_pool; /**< thread applying the gradients
+                                              in background, null if they are
+                                              applied right away */
+
   RunStats validation; /** validation statistics of the model */
   RunStats training;   /** training statistics of the model */
   RunStats testing;    /** testing statistics of the model */
@@ -568,6 +617,31 @@ private:
    */
   int train_run();
 
+  /**
+   * @brief     Save the weights while training, in background if async_save
+   * is set
+   * @param[in] file_path file path to save the weights in MODEL_FORMAT_BIN
+   * @details   the weights and the optimizer variables are copied to a
+   * snapshot first, then written to a temporary file next to file_path on a
+   * background thread while the training goes on. The temporary file is renamed to file_path once written,
+   * so file_path always holds a complete checkpoint.
+   */
+  void saveCheckpoint(const std::string &file_path);
+
+  /**
+   * @brief     Load the optimizer variables saved after the weights, once
+   * they are allocated for the training
+   * @details   the variables are kept as they are if the saved ones do not
+   * match the optimizer
+   */
+  void loadOptimizerVariables();
+
+  /**
+   * @brief     Wait for the save running in background to finish
+   * @throws    the error of the save if it has failed
+   */
+  void waitCheckpoint();
+
   /**
    * @brief     Swap function for the class
    */
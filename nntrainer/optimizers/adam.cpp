@@ -11,10 +11,12 @@
  * @brief  This is the Adam optimizer.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 
 #include <adam.h>
+#include <half_precision.h>
 #include <nntrainer_error.h>
 #include <nntrainer_log.h>
 #include <node_exporter.h>
@@ -22,19 +24,102 @@
 
 namespace nntrainer {
 
-Adam::Adam() : adam_props(PropsB1(), PropsB2(), PropsEpsilon()) {
+Adam::Adam() :
+  adam_props(PropsB1(), PropsB2(), PropsEpsilon(), PropsWeightDecay()) {
   /** default properties */
   setProperty({"learning_rate=0.001"});
-  auto &[b1, b2, eps] = adam_props;
+  auto &[b1, b2, eps, weight_decay] = adam_props;
   b1.set(0.9f);
   b2.set(0.999f);
   eps.set(1.0e-7f);
+  weight_decay.set(0.0f);
 }
 
 Adam::~Adam() {}
 
 enum AdamParams { wm, wv };
 
+namespace {
+
+/** minimum number of elements updated by a thread */
+constexpr size_t ADAM_MIN_CHUNK_SIZE = 16384;
+
+/** number of elements of the 16 bit moments converted to fp32 at a time */
+constexpr size_t ADAM_STATE_BLOCK_SIZE = 256;
+
+/**
+ * @brief parameters of the fused adam update
+ */
+struct AdamKernelParams {
+  float beta1;           /**< decay rate of the first moment */
+  float beta2;           /**< decay rate of the second moment */
+  float one_minus_beta1; /**< 1 - beta1, computed before rounding to float */
+  float one_minus_beta2; /**< 1 - beta2, computed before rounding to float */
+  float epsilon;         /**< added to the denominator */
+  float lr;              /**< bias corrected learning rate */
+  float decay; /**< learning rate times the decoupled weight decay */
+};
+
+/**
+ * @brief update the weight and both moments in a single pass
+ *
+ * @param p parameters of the update
+ * @param w weight
+ * @param g gradient
+ * @param m first moment
+ * @param v second moment
+ * @param len number of elements
+ */
+void adamUpdate(const AdamKernelParams &p, float *__restrict w,
+                const float *__restrict g, float *__restrict m,
+                float *__restrict v, size_t len) {
+#pragma omp simd
+  for (size_t i = 0; i < len; ++i) {
+    float gi = g[i];
+    float mi = p.beta1 * m[i] + p.one_minus_beta1 * gi;
+    float vi = p.beta2 * v[i] + p.one_minus_beta2 * gi * gi;
+    m[i] = mi;
+    v[i] = vi;
+    w[i] -= p.lr * mi / (std::sqrt(vi) + p.epsilon) + p.decay * w[i];
+  }
+}
+
+/**
+ * @brief update the weight and the moments stored in any data type, the
+ * moments in 16 bit are converted to fp32 block by block for the update
+ *
+ * @param p parameters of the update
+ * @param w weight
+ * @param g gradient
+ * @param wm first moment tensor
+ * @param wv second moment tensor
+ * @param offset index of the moments to start updating from
+ * @param len number of elements
+ */
+void adamUpdate(const AdamKernelParams &p, float *w, const float *g,
+                Tensor &wm, Tensor &wv, size_t offset, size_t len) {
+  Tensor::DataType type = wm.getDataType();
+  if (type == Tensor::DataType::FP32) {
+    adamUpdate(p, w, g, wm.getData() + offset, wv.getData() + offset, len);
+    return;
+  }
+
+  uint16_t *m = wm.getData<uint16_t>() + offset;
+  uint16_t *v = wv.getData<uint16_t>() + offset;
+  float m_block[ADAM_STATE_BLOCK_SIZE];
+  float v_block[ADAM_STATE_BLOCK_SIZE];
+  for (size_t i = 0; i < len; i += ADAM_STATE_BLOCK_SIZE) {
+    size_t n = std::min(ADAM_STATE_BLOCK_SIZE, len - i);
+    convertData(m + i, type, m_block, Tensor::DataType::FP32, n);
+    convertData(v + i, type, v_block, Tensor::DataType::FP32, n);
+    adamUpdate(p, w + i, g + i, m_block, v_block, n);
+    convertData(m_block, Tensor::DataType::FP32, m + i, type, n);
+    convertData(v_block, Tensor::DataType::FP32, v + i, type, n);
+  }
+}
+
+} // namespace
+
 std::vector<TensorDim> Adam::getOptimizerVariableDim(const TensorDim &dim) {
   return {dim, dim};
 }
@@ -64,11 +149,15 @@ double Adam::getLearningRate(size_t iteration) const {
 }
 
 void Adam::applyGradient(RunOptimizerContext &context) {
+  Tensor &x = context.getWeight();
   Tensor &x_grad = context.getGradient();
+  Tensor &wm = context.getOptimizerVariable(AdamParams::wm);
+  Tensor &wv = context.getOptimizerVariable(AdamParams::wv);
 
   auto &beta1 = std::get<PropsB1>(adam_props).get();
   auto &beta2 = std::get<PropsB2>(adam_props).get();
   auto &epsilon = std::get<PropsEpsilon>(adam_props).get();
+  auto &weight_decay = std::get<PropsWeightDecay>(adam_props).get();
 
   // This is implementation of adam from original paper.
   // This is not deleted intentionally.
@@ -88,22 +177,59 @@ void Adam::applyGradient(RunOptimizerContext &context) {
   //                  .add(epsilon);
   // x.add_i(wm.divide(denom), -ll / biasCorrection1);
 
-  std::function<double(double)> sqrtEps = [epsilon](double f) {
-    return 1 / (sqrtDouble(f) + epsilon);
-  };
-
-  Tensor &wm = context.getOptimizerVariable(AdamParams::wm);
-  Tensor &wv = context.getOptimizerVariable(AdamParams::wv);
-
-  wm.multiply_i(beta1);
-  wm.add_i(x_grad, 1.0f - beta1);
-
-  wv.multiply_i(beta2);
-  wv.add_i(x_grad.multiply(x_grad), 1.0f - beta2);
-
-  x_grad = wv.apply(sqrtEps, x_grad);
-  x_grad.multiply_i(wm);
-  context.applyGradient(getLearningRate(context.getIteration()));
+  /** bias correction is folded into the learning rate */
+  AdamKernelParams params;
+  params.beta1 = beta1;
+  params.beta2 = beta2;
+  /** 1 - 0.9999f is 1.0002e-4 in float, so subtract in double */
+  params.one_minus_beta1 = 1.0 - beta1;
+  params.one_minus_beta2 = 1.0 - beta2;
+  params.epsilon = epsilon;
+  params.lr = getLearningRate(context.getIteration());
+  /** decoupled weight decay (AdamW) is not bias corrected */
+  params.decay =
+    OptimizerImpl::getLearningRate(context.getIteration()) * weight_decay;
+
+  float *w = x.getData();
+
+  if (context.hasSparseGradient()) {
+    /** update only the rows having the gradient, rows are unique */
+    const std::vector<unsigned int> &rows = context.getSparseGradientRows();
+    Tensor &values = context.getSparseGradientValues();
+    size_t width = x.width();
+    size_t num_rows = rows.size();
+
+    unsigned int workers = std::max<size_t>(
+      1, std::min<size_t>(context.getNumThreads(),
+                          num_rows * width / ADAM_MIN_CHUNK_SIZE));
+
+#pragma omp parallel for num_threads(workers) schedule(static)
+    for (size_t i = 0; i < num_rows; ++i) {
+      size_t offset = rows[i] * width;
+      adamUpdate(params, w + offset, values.getAddress(i * width), wm, wv,
+                 offset, width);
+    }
+    return;
+  }
+
+  const float *g = x_grad.getData();
+  size_t len = x.size();
+
+  /** do not wake up threads for the weights too small to be worth it */
+  unsigned int workers = std::max<size_t>(
+    1, std::min<size_t>(context.getNumThreads(), len / ADAM_MIN_CHUNK_SIZE));
+
+  if (workers == 1) {
+    adamUpdate(params, w, g, wm, wv, 0, len);
+    return;
+  }
+
+#pragma omp parallel for num_threads(workers) schedule(static)
+  for (unsigned int t = 0; t < workers; ++t) {
+    size_t begin = len * t / workers;
+    size_t end = len * (t + 1) / workers;
+    adamUpdate(params, w + begin, g + begin, wm, wv, begin, end - begin);
+  }
 }
 
 } // namespace nntrainer
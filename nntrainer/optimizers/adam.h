@@ -52,9 +52,19 @@ public:
   using prop_tag = double_prop_tag;             /**< property type */
 };
 
+/**
+ * @brief decoupled weight decay props
+ *
+ */
+class PropsWeightDecay : public Property<double> {
+public:
+  static constexpr const char *key = "weight_decay"; /**< unique key to access */
+  using prop_tag = double_prop_tag;                  /**< property type */
+};
+
 /**
  * @class   Adam optimizer class
- * @brief   Adam optimizer
+ * @brief   Adam optimizer, AdamW if weight_decay is set
  */
 class Adam : public OptimizerImpl {
 public:
@@ -75,6 +85,13 @@ public:
    */
   void applyGradient(RunOptimizerContext &context) override;
 
+  /**
+   * @copydoc Optimizer::supportSparseGradient()
+   * @note rows without the gradient are not updated, and their moments are
+   * not decayed (lazy adam)
+   */
+  bool supportSparseGradient() const override { return true; }
+
   /**
    * @copydoc Optimizer::getType()
    */
@@ -104,7 +121,7 @@ public:
   void setProperty(const std::vector<std::string> &values) override;
 
 private:
-  std::tuple<PropsB1, PropsB2, PropsEpsilon> adam_props;
+  std::tuple<PropsB1, PropsB2, PropsEpsilon, PropsWeightDecay> adam_props;
 };
 } /* namespace nntrainer */
 
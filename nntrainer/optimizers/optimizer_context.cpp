@@ -36,6 +36,28 @@ Tensor &RunOptimizerContext::getOptimizerVariable(unsigned int idx) const {
   return weight->getOptimizerVariableRef(idx);
 }
 
+/**
+ * @brief Check if the gradient is given as a sparse gradient
+ */
+bool RunOptimizerContext::hasSparseGradient() const {
+  return weight->hasSparseGradient();
+}
+
+/**
+ * @brief Get the rows of the sparse gradient
+ */
+const std::vector<unsigned int> &
+RunOptimizerContext::getSparseGradientRows() const {
+  return weight->getSparseGradientRows();
+}
+
+/**
+ * @brief Get the values of the sparse gradient
+ */
+Tensor &RunOptimizerContext::getSparseGradientValues() const {
+  return weight->getSparseGradientValues();
+}
+
 /**
  * @brief   Apply the gradient with the given learning rate
  */
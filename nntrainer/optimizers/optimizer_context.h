@@ -33,10 +33,15 @@ public:
   /**
    * @brief Construct a new Run Optimizer Context object
    *
+   * @param w weight to update
+   * @param iter current iteration
+   * @param num_threads_ number of threads the optimizer is allowed to use
    */
-  RunOptimizerContext(Weight *w = nullptr, size_t iter = 0) :
+  RunOptimizerContext(Weight *w = nullptr, size_t iter = 0,
+                      unsigned int num_threads_ = 1) :
     weight(w),
-    iteration(iter) {}
+    iteration(iter),
+    num_threads(num_threads_) {}
 
   /**
    * @brief Get the Weight tensor object
@@ -60,6 +65,27 @@ public:
    */
   Tensor &getOptimizerVariable(unsigned int idx) const;
 
+  /**
+   * @brief Check if the gradient is given as a sparse gradient
+   *
+   * @return true if the weight has a sparse gradient, else false
+   */
+  bool hasSparseGradient() const;
+
+  /**
+   * @brief Get the rows of the sparse gradient
+   *
+   * @return const std::vector<unsigned int>& indices of the rows
+   */
+  const std::vector<unsigned int> &getSparseGradientRows() const;
+
+  /**
+   * @brief Get the values of the sparse gradient
+   *
+   * @return Tensor& gradient of the rows given by getSparseGradientRows()
+   */
+  Tensor &getSparseGradientValues() const;
+
   /**
    * @brief   Check if run context is set and is ready to use
    *
@@ -81,9 +107,17 @@ public:
    */
   size_t getIteration() const { return iteration; }
 
+  /**
+   * @brief   Get the number of threads the optimizer is allowed to use
+   *
+   * @return number of threads
+   */
+  unsigned int getNumThreads() const { return num_threads; }
+
 private:
-  Weight *weight;   /**< weights for the optimizer */
-  size_t iteration; /**< iteration number */
+  Weight *weight;           /**< weights for the optimizer */
+  size_t iteration;         /**< iteration number */
+  unsigned int num_threads; /**< number of threads for the update */
 };
 
 } // namespace nntrainer
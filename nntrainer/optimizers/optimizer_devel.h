@@ -55,6 +55,14 @@ public:
    */
   virtual void applyGradient(RunOptimizerContext &context) = 0;
 
+  /**
+   * @brief     check if the optimizer can apply a sparse gradient
+   * @details   the sparse gradient of a weight is written to its dense gradient
+   * before applyGradient() if this returns false
+   * @retval    true if applyGradient() handles the sparse gradient
+   */
+  virtual bool supportSparseGradient() const { return false; }
+
   /**
    * @brief     set Optimizer Parameters
    * @param[in] values Optimizer Parameter list
@@ -35,6 +35,11 @@ public:
    */
   void applyGradient(RunOptimizerContext &context);
 
+  /**
+   * @copydoc Optimizer::supportSparseGradient()
+   */
+  bool supportSparseGradient() const { return true; }
+
   /**
    * @copydoc Optimizer::getType()
    */
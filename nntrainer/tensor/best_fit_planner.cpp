@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   best_fit_planner.cpp
+ * @date   17 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  This is Best Fit Memory Planner
+ *
+ */
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <best_fit_planner.h>
+
+namespace nntrainer {
+
+/**
+ * @copydoc MemoryPlanner::planLayout(
+ * const std::vector<size_t> &memory_size,
+ * const std::vector<std::pair<unsigned int, unsigned int>> &memory_validity,
+ * std::vector<size_t> &memory_offset);
+ *
+ * @details The requests are sorted in the descending order of the size, and
+ * then the ascending order of the start of the validity. Placing the large
+ * memories first leaves gaps which the smaller memories can fill later.
+ */
+size_t BestFitPlanner::planLayout(
+  const std::vector<size_t> &memory_size,
+  const std::vector<std::pair<unsigned int, unsigned int>> &memory_validity,
+  std::vector<size_t> &memory_offset) const {
+
+  std::vector<unsigned int> order(memory_size.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](unsigned int v1, unsigned int v2) {
+                     if (memory_size[v1] == memory_size[v2])
+                       return memory_validity[v1].first <
+                              memory_validity[v2].first;
+                     return memory_size[v1] > memory_size[v2];
+                   });
+
+  /** memories already placed, overlapping with the current request */
+  std::vector<std::pair<size_t, size_t>> overlaps;
+
+  memory_offset.resize(memory_size.size());
+  std::vector<unsigned int> placed;
+  placed.reserve(memory_size.size());
+  size_t memory_req = 0;
+
+  for (auto idx : order) {
+    auto const &valid = memory_validity[idx];
+
+    /** validity end is exclusive */
+    overlaps.clear();
+    for (auto p : placed) {
+      if (memory_validity[p].first < valid.second &&
+          valid.first < memory_validity[p].second)
+        overlaps.emplace_back(memory_offset[p],
+                              memory_offset[p] + memory_size[p]);
+    }
+    std::sort(overlaps.begin(), overlaps.end());
+
+    /** find the smallest gap holding the request, else place on the top */
+    size_t best_offset = 0;
+    size_t best_gap = std::numeric_limits<size_t>::max();
+    size_t gap_start = 0;
+    for (auto const &[begin, end] : overlaps) {
+      if (begin > gap_start) {
+        size_t gap = begin - gap_start;
+        if (gap >= memory_size[idx] && gap < best_gap) {
+          best_gap = gap;
+          best_offset = gap_start;
+        }
+      }
+      gap_start = std::max(gap_start, end);
+    }
+
+    if (best_gap == std::numeric_limits<size_t>::max())
+      best_offset = gap_start;
+
+    memory_offset[idx] = best_offset;
+    memory_req = std::max(memory_req, best_offset + memory_size[idx]);
+    placed.push_back(idx);
+  }
+
+  return memory_req;
+}
+
+} // namespace nntrainer
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   best_fit_planner.h
+ * @date   17 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  This is Best Fit Memory Planner
+ *
+ * @details The requests are placed in the descending order of their sizes.
+ * Each request takes the smallest gap, between the memories already placed
+ * whose validity overlaps with it, which is large enough to hold it. If there
+ * is no such gap, it is placed on top of those memories.
+ *
+ * Unlike the optimized v1 planner, a freed memory can be reused by a request
+ * of a smaller size, which brings the layout closer to the theoretical minimum
+ * when the sizes of the tensors vary.
+ */
+
+#ifndef __BEST_FIT_PLANNER_H__
+#define __BEST_FIT_PLANNER_H__
+
+#include <vector>
+
+#include <memory_planner.h>
+
+namespace nntrainer {
+
+/**
+ * @class   BestFitPlanner
+ * @brief   Best Fit Memory Planner provides the plan for memory layout reusing
+ * the memories of any size
+ */
+class BestFitPlanner : public MemoryPlanner {
+public:
+  /**
+   * @brief BestFitPlanner constructor
+   *
+   */
+  BestFitPlanner() = default;
+
+  /**
+   * @copydoc MemoryPlanner::planLayout(
+   * const std::vector<size_t> &memory_size,
+   * const std::vector<std::pair<unsigned int, unsigned int>> &memory_validity,
+   * std::vector<size_t> &memory_offset);
+   *
+   */
+  size_t planLayout(
+    const std::vector<size_t> &memory_size,
+    const std::vector<std::pair<unsigned int, unsigned int>> &memory_validity,
+    std::vector<size_t> &memory_offset) const;
+
+  /**
+   * @copydoc MemoryPlanner::getType() const
+   *
+   */
+  const std::string &getType() const { return type; }
+
+  inline static const std::string type = "best_fit_planner";
+};
+
+} // namespace nntrainer
+
+#endif /** __BEST_FIT_PLANNER_H__ */
@@ -16,27 +16,469 @@
 
 #include <cmath>
 
-#define sgemv_loop(ci, cj, cM, cN)           \
-  do {                                       \
-    double y0;                               \
-    unsigned int i, j;                       \
-    for (ci = 0; ci != cM; ci++) {           \
-      y0 = Y[ci * incy] * beta;              \
-      for (cj = 0; cj != cN; cj++)           \
-        y0 += A[i + j * lda] * X[cj * incx]; \
-      Y[ci * incy] = y0;                     \
-    }                                        \
-  } while (0);
+#ifndef USE_BLAS
+#include <algorithm>
+#include <vector>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define USE_AVX2_KERNEL
+#include <immintrin.h>
+#endif
+#endif
 
 namespace nntrainer {
 
 #ifndef USE_BLAS
 
+/**
+ * @brief rows of the register tile of the sgemm micro kernel
+ */
+static constexpr unsigned int GEMM_MR = 4;
+
+/**
+ * @brief columns of the register tile of the sgemm micro kernel
+ */
+static constexpr unsigned int GEMM_NR = 16;
+
+/**
+ * @brief rows of A packed at once, sized to stay in L2 cache
+ */
+static constexpr unsigned int GEMM_MC = 128;
+
+/**
+ * @brief depth packed at once, sized to keep a panel of B in L1 cache
+ */
+static constexpr unsigned int GEMM_KC = 256;
+
+/**
+ * @brief columns of B packed at once
+ */
+static constexpr unsigned int GEMM_NC = 4096;
+
+/**
+ * @brief number of partial sums kept in the vector loops, wide enough to fill
+ * a vector register of the targets
+ */
+static constexpr unsigned int VEC_LANES = 8;
+
+/**
+ * @brief micro kernel computing C[MR x NR] += A_panel x B_panel
+ * @param kc depth of the panels
+ * @param a packed panel of A, [kc x MR]
+ * @param b packed panel of B, [kc x NR]
+ * @param c C to accumulate to
+ * @param ldc leading dimension of C
+ */
+using GemmMicroKernel = void (*)(unsigned int kc, const float *a,
+                                 const float *b, float *c, unsigned int ldc);
+
+static void gemm_kernel_generic(unsigned int kc, const float *a,
+                                const float *b, float *c, unsigned int ldc) {
+  float acc[GEMM_MR][GEMM_NR] = {{0.0f}};
+
+  for (unsigned int k = 0; k < kc; ++k) {
+    for (unsigned int i = 0; i < GEMM_MR; ++i) {
+      float a_val = a[i];
+      for (unsigned int j = 0; j < GEMM_NR; ++j)
+        acc[i][j] += a_val * b[j];
+    }
+    a += GEMM_MR;
+    b += GEMM_NR;
+  }
+
+  for (unsigned int i = 0; i < GEMM_MR; ++i)
+    for (unsigned int j = 0; j < GEMM_NR; ++j)
+      c[i * ldc + j] += acc[i][j];
+}
+
+#ifdef USE_AVX2_KERNEL
+__attribute__((target("avx2,fma"))) static void
+gemm_kernel_avx2(unsigned int kc, const float *a, const float *b, float *c,
+                 unsigned int ldc) {
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+
+  for (unsigned int k = 0; k < kc; ++k) {
+    __m256 b0 = _mm256_loadu_ps(b);
+    __m256 b1 = _mm256_loadu_ps(b + 8);
+    __m256 a_val;
+
+    a_val = _mm256_broadcast_ss(a);
+    c00 = _mm256_fmadd_ps(a_val, b0, c00);
+    c01 = _mm256_fmadd_ps(a_val, b1, c01);
+    a_val = _mm256_broadcast_ss(a + 1);
+    c10 = _mm256_fmadd_ps(a_val, b0, c10);
+    c11 = _mm256_fmadd_ps(a_val, b1, c11);
+    a_val = _mm256_broadcast_ss(a + 2);
+    c20 = _mm256_fmadd_ps(a_val, b0, c20);
+    c21 = _mm256_fmadd_ps(a_val, b1, c21);
+    a_val = _mm256_broadcast_ss(a + 3);
+    c30 = _mm256_fmadd_ps(a_val, b0, c30);
+    c31 = _mm256_fmadd_ps(a_val, b1, c31);
+
+    a += GEMM_MR;
+    b += GEMM_NR;
+  }
+
+  __m256 acc[GEMM_MR][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}};
+  for (unsigned int i = 0; i < GEMM_MR; ++i) {
+    float *c_row = c + i * ldc;
+    _mm256_storeu_ps(c_row, _mm256_add_ps(_mm256_loadu_ps(c_row), acc[i][0]));
+    _mm256_storeu_ps(c_row + 8,
+                     _mm256_add_ps(_mm256_loadu_ps(c_row + 8), acc[i][1]));
+  }
+}
+#endif
+
+#if defined(__aarch64__)
+static void gemm_kernel_neon(unsigned int kc, const float *a, const float *b,
+                             float *c, unsigned int ldc) {
+  float32x4_t acc[GEMM_MR][4];
+  for (unsigned int i = 0; i < GEMM_MR; ++i)
+    for (unsigned int j = 0; j < 4; ++j)
+      acc[i][j] = vdupq_n_f32(0.0f);
+
+  for (unsigned int k = 0; k < kc; ++k) {
+    float32x4_t b0 = vld1q_f32(b);
+    float32x4_t b1 = vld1q_f32(b + 4);
+    float32x4_t b2 = vld1q_f32(b + 8);
+    float32x4_t b3 = vld1q_f32(b + 12);
+    float32x4_t a_val = vld1q_f32(a);
+
+    acc[0][0] = vfmaq_laneq_f32(acc[0][0], b0, a_val, 0);
+    acc[0][1] = vfmaq_laneq_f32(acc[0][1], b1, a_val, 0);
+    acc[0][2] = vfmaq_laneq_f32(acc[0][2], b2, a_val, 0);
+    acc[0][3] = vfmaq_laneq_f32(acc[0][3], b3, a_val, 0);
+    acc[1][0] = vfmaq_laneq_f32(acc[1][0], b0, a_val, 1);
+    acc[1][1] = vfmaq_laneq_f32(acc[1][1], b1, a_val, 1);
+    acc[1][2] = vfmaq_laneq_f32(acc[1][2], b2, a_val, 1);
+    acc[1][3] = vfmaq_laneq_f32(acc[1][3], b3, a_val, 1);
+    acc[2][0] = vfmaq_laneq_f32(acc[2][0], b0, a_val, 2);
+    acc[2][1] = vfmaq_laneq_f32(acc[2][1], b1, a_val, 2);
+    acc[2][2] = vfmaq_laneq_f32(acc[2][2], b2, a_val, 2);
+    acc[2][3] = vfmaq_laneq_f32(acc[2][3], b3, a_val, 2);
+    acc[3][0] = vfmaq_laneq_f32(acc[3][0], b0, a_val, 3);
+    acc[3][1] = vfmaq_laneq_f32(acc[3][1], b1, a_val, 3);
+    acc[3][2] = vfmaq_laneq_f32(acc[3][2], b2, a_val, 3);
+    acc[3][3] = vfmaq_laneq_f32(acc[3][3], b3, a_val, 3);
+
+    a += GEMM_MR;
+    b += GEMM_NR;
+  }
+
+  for (unsigned int i = 0; i < GEMM_MR; ++i) {
+    float *c_row = c + i * ldc;
+    for (unsigned int j = 0; j < 4; ++j)
+      vst1q_f32(c_row + j * 4, vaddq_f32(vld1q_f32(c_row + j * 4), acc[i][j]));
+  }
+}
+#endif
+
+/**
+ * @brief select the micro kernel from the features of the running cpu
+ */
+static GemmMicroKernel selectGemmMicroKernel() {
+#ifdef USE_AVX2_KERNEL
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return gemm_kernel_avx2;
+#endif
+#if defined(__aarch64__)
+  return gemm_kernel_neon;
+#endif
+  return gemm_kernel_generic;
+}
+
+/**
+ * @brief rows of A covered at a time by the sgemv micro kernels
+ */
+static constexpr unsigned int GEMV_MR = 4;
+
+/**
+ * @brief micro kernel of sgemv, y[r] += dot(A[r, :], x) for the GEMV_MR rows
+ * @param n length of the rows
+ * @param a first row of A
+ * @param lda leading dimension of A
+ * @param x contiguous x
+ * @param y GEMV_MR contiguous results to accumulate to
+ */
+using GemvMicroKernel = void (*)(unsigned int n, const float *a,
+                                 unsigned int lda, const float *x, float *y);
+
+/**
+ * @brief micro kernel of transposed sgemv, y += s[r] * A[r, :] summed over
+ * the GEMV_MR rows
+ * @param n length of the rows
+ * @param a first row of A
+ * @param lda leading dimension of A
+ * @param s GEMV_MR scales of the rows
+ * @param y contiguous y to accumulate to
+ */
+using GemvTransMicroKernel = void (*)(unsigned int n, const float *a,
+                                      unsigned int lda, const float *s,
+                                      float *y);
+
+static void gemv_kernel_generic(unsigned int n, const float *a,
+                                unsigned int lda, const float *x, float *y) {
+  float acc[GEMV_MR][VEC_LANES] = {{0.0f}};
+  unsigned int j = 0;
+  for (; j + VEC_LANES <= n; j += VEC_LANES)
+    for (unsigned int r = 0; r < GEMV_MR; ++r)
+      for (unsigned int l = 0; l < VEC_LANES; ++l)
+        acc[r][l] += a[r * lda + j + l] * x[j + l];
+
+  for (unsigned int r = 0; r < GEMV_MR; ++r) {
+    float sum = 0.0f;
+    for (unsigned int l = 0; l < VEC_LANES; ++l)
+      sum += acc[r][l];
+    for (unsigned int k = j; k < n; ++k)
+      sum += a[r * lda + k] * x[k];
+    y[r] += sum;
+  }
+}
+
+static void gemv_trans_kernel_generic(unsigned int n, const float *a,
+                                      unsigned int lda, const float *s,
+                                      float *y) {
+  for (unsigned int j = 0; j < n; ++j)
+    y[j] += s[0] * a[j] + s[1] * a[lda + j] + s[2] * a[2 * lda + j] +
+            s[3] * a[3 * lda + j];
+}
+
+#ifdef USE_AVX2_KERNEL
+/**
+ * @brief horizontal sum of the lanes of a register
+ */
+__attribute__((target("avx2,fma"))) static inline float hsum_avx2(__m256 v) {
+  __m128 sum =
+    _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+  return _mm_cvtss_f32(sum);
+}
+
+__attribute__((target("avx2,fma"))) static void
+gemv_kernel_avx2(unsigned int n, const float *a, unsigned int lda,
+                 const float *x, float *y) {
+  const float *a0 = a, *a1 = a + lda, *a2 = a + 2 * lda, *a3 = a + 3 * lda;
+  __m256 c0 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps();
+  __m256 c2 = _mm256_setzero_ps(), c3 = _mm256_setzero_ps();
+
+  unsigned int j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m256 x_val = _mm256_loadu_ps(x + j);
+    c0 = _mm256_fmadd_ps(_mm256_loadu_ps(a0 + j), x_val, c0);
+    c1 = _mm256_fmadd_ps(_mm256_loadu_ps(a1 + j), x_val, c1);
+    c2 = _mm256_fmadd_ps(_mm256_loadu_ps(a2 + j), x_val, c2);
+    c3 = _mm256_fmadd_ps(_mm256_loadu_ps(a3 + j), x_val, c3);
+  }
+
+  float sum[GEMV_MR] = {hsum_avx2(c0), hsum_avx2(c1), hsum_avx2(c2),
+                        hsum_avx2(c3)};
+  for (; j < n; ++j) {
+    sum[0] += a0[j] * x[j];
+    sum[1] += a1[j] * x[j];
+    sum[2] += a2[j] * x[j];
+    sum[3] += a3[j] * x[j];
+  }
+  for (unsigned int r = 0; r < GEMV_MR; ++r)
+    y[r] += sum[r];
+}
+
+__attribute__((target("avx2,fma"))) static void
+gemv_trans_kernel_avx2(unsigned int n, const float *a, unsigned int lda,
+                       const float *s, float *y) {
+  const float *a0 = a, *a1 = a + lda, *a2 = a + 2 * lda, *a3 = a + 3 * lda;
+  __m256 s0 = _mm256_set1_ps(s[0]), s1 = _mm256_set1_ps(s[1]);
+  __m256 s2 = _mm256_set1_ps(s[2]), s3 = _mm256_set1_ps(s[3]);
+
+  unsigned int j = 0;
+  for (; j + 8 <= n; j += 8) {
+    __m256 y_val = _mm256_loadu_ps(y + j);
+    y_val = _mm256_fmadd_ps(s0, _mm256_loadu_ps(a0 + j), y_val);
+    y_val = _mm256_fmadd_ps(s1, _mm256_loadu_ps(a1 + j), y_val);
+    y_val = _mm256_fmadd_ps(s2, _mm256_loadu_ps(a2 + j), y_val);
+    y_val = _mm256_fmadd_ps(s3, _mm256_loadu_ps(a3 + j), y_val);
+    _mm256_storeu_ps(y + j, y_val);
+  }
+  for (; j < n; ++j)
+    y[j] += s[0] * a0[j] + s[1] * a1[j] + s[2] * a2[j] + s[3] * a3[j];
+}
+#endif
+
+#if defined(__aarch64__)
+static void gemv_kernel_neon(unsigned int n, const float *a, unsigned int lda,
+                             const float *x, float *y) {
+  const float *a0 = a, *a1 = a + lda, *a2 = a + 2 * lda, *a3 = a + 3 * lda;
+  float32x4_t c0 = vdupq_n_f32(0.0f), c1 = vdupq_n_f32(0.0f);
+  float32x4_t c2 = vdupq_n_f32(0.0f), c3 = vdupq_n_f32(0.0f);
+
+  unsigned int j = 0;
+  for (; j + 4 <= n; j += 4) {
+    float32x4_t x_val = vld1q_f32(x + j);
+    c0 = vfmaq_f32(c0, vld1q_f32(a0 + j), x_val);
+    c1 = vfmaq_f32(c1, vld1q_f32(a1 + j), x_val);
+    c2 = vfmaq_f32(c2, vld1q_f32(a2 + j), x_val);
+    c3 = vfmaq_f32(c3, vld1q_f32(a3 + j), x_val);
+  }
+
+  float sum[GEMV_MR] = {vaddvq_f32(c0), vaddvq_f32(c1), vaddvq_f32(c2),
+                        vaddvq_f32(c3)};
+  for (; j < n; ++j) {
+    sum[0] += a0[j] * x[j];
+    sum[1] += a1[j] * x[j];
+    sum[2] += a2[j] * x[j];
+    sum[3] += a3[j] * x[j];
+  }
+  for (unsigned int r = 0; r < GEMV_MR; ++r)
+    y[r] += sum[r];
+}
+
+static void gemv_trans_kernel_neon(unsigned int n, const float *a,
+                                   unsigned int lda, const float *s, float *y) {
+  const float *a0 = a, *a1 = a + lda, *a2 = a + 2 * lda, *a3 = a + 3 * lda;
+  float32x4_t s_val = vld1q_f32(s);
+
+  unsigned int j = 0;
+  for (; j + 4 <= n; j += 4) {
+    float32x4_t y_val = vld1q_f32(y + j);
+    y_val = vfmaq_laneq_f32(y_val, vld1q_f32(a0 + j), s_val, 0);
+    y_val = vfmaq_laneq_f32(y_val, vld1q_f32(a1 + j), s_val, 1);
+    y_val = vfmaq_laneq_f32(y_val, vld1q_f32(a2 + j), s_val, 2);
+    y_val = vfmaq_laneq_f32(y_val, vld1q_f32(a3 + j), s_val, 3);
+    vst1q_f32(y + j, y_val);
+  }
+  for (; j < n; ++j)
+    y[j] += s[0] * a0[j] + s[1] * a1[j] + s[2] * a2[j] + s[3] * a3[j];
+}
+#endif
+
+/**
+ * @brief select the sgemv micro kernel from the features of the running cpu
+ */
+static GemvMicroKernel selectGemvMicroKernel() {
+#ifdef USE_AVX2_KERNEL
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return gemv_kernel_avx2;
+#endif
+#if defined(__aarch64__)
+  return gemv_kernel_neon;
+#endif
+  return gemv_kernel_generic;
+}
+
+/**
+ * @brief select the transposed sgemv micro kernel from the features of the
+ * running cpu
+ */
+static GemvTransMicroKernel selectGemvTransMicroKernel() {
+#ifdef USE_AVX2_KERNEL
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    return gemv_trans_kernel_avx2;
+#endif
+#if defined(__aarch64__)
+  return gemv_trans_kernel_neon;
+#endif
+  return gemv_trans_kernel_generic;
+}
+
+/**
+ * @brief scratch buffers of the calling thread, kept across the calls so that
+ * the packing and the staging of strided vectors do not allocate every call
+ */
+struct BlasScratch {
+  std::vector<float> packed_a; /**< packed block of op(A) of sgemm */
+  std::vector<float> packed_b; /**< packed block of op(B) of sgemm */
+  std::vector<float> x;        /**< contiguous x of sgemv */
+  std::vector<float> y;        /**< contiguous y of sgemv */
+};
+
+/**
+ * @brief get a scratch buffer of the calling thread holding at least len
+ * elements, the contents are not kept
+ */
+static float *getScratch(std::vector<float> BlasScratch::*buf, size_t len) {
+  static thread_local BlasScratch scratch;
+  std::vector<float> &vec = scratch.*buf;
+  if (vec.size() < len)
+    vec.resize(len);
+  return vec.data();
+}
+
+/**
+ * @brief pack a block of op(A) scaled by alpha into panels of MR rows
+ */
+static void pack_a(CBLAS_TRANSPOSE TransA, const float *A, unsigned int lda,
+                   unsigned int mc, unsigned int kc, float alpha, float *dst) {
+  for (unsigned int i = 0; i < mc; i += GEMM_MR) {
+    unsigned int mr = std::min(GEMM_MR, mc - i);
+    for (unsigned int k = 0; k < kc; ++k) {
+      for (unsigned int r = 0; r < mr; ++r)
+        dst[r] = alpha * (TransA == CblasTrans ? A[k * lda + i + r]
+                                               : A[(i + r) * lda + k]);
+      for (unsigned int r = mr; r < GEMM_MR; ++r)
+        dst[r] = 0.0f;
+      dst += GEMM_MR;
+    }
+  }
+}
+
+/**
+ * @brief pack a block of op(B) into panels of NR columns
+ */
+static void pack_b(CBLAS_TRANSPOSE TransB, const float *B, unsigned int ldb,
+                   unsigned int kc, unsigned int nc, float *dst) {
+  for (unsigned int j = 0; j < nc; j += GEMM_NR) {
+    unsigned int nr = std::min(GEMM_NR, nc - j);
+    for (unsigned int k = 0; k < kc; ++k) {
+      if (TransB == CblasTrans) {
+        for (unsigned int r = 0; r < nr; ++r)
+          dst[r] = B[(j + r) * ldb + k];
+      } else {
+        std::copy(B + k * ldb + j, B + k * ldb + j + nr, dst);
+      }
+      for (unsigned int r = nr; r < GEMM_NR; ++r)
+        dst[r] = 0.0f;
+      dst += GEMM_NR;
+    }
+  }
+}
+
+/**
+ * @brief dot product of contiguous vectors, with partial sums kept in
+ * VEC_LANES lanes so that the loop can be vectorized
+ */
+static float sdot_contiguous(const unsigned int N, const float *X,
+                             const float *Y) {
+  float acc[VEC_LANES] = {0.0f};
+  unsigned int i = 0;
+  for (; i + VEC_LANES <= N; i += VEC_LANES)
+    for (unsigned int l = 0; l < VEC_LANES; ++l)
+      acc[l] += X[i + l] * Y[i + l];
+
+  float ret = 0.0f;
+  for (unsigned int l = 0; l < VEC_LANES; ++l)
+    ret += acc[l];
+  for (; i < N; ++i)
+    ret += X[i] * Y[i];
+  return ret;
+}
+
 static void saxpy_raw(const unsigned int N, const float alpha, const float *X,
                       const int incX, float *Y, const int incY) {
-  if (incX <= 0 or incY <= 0)
+  if (incX < 0 or incY < 0)
     throw std::invalid_argument(
       "Error: negative inc not supported without cblas");
+  if (incX == 1 && incY == 1) {
+    for (unsigned int i = 0; i < N; ++i)
+      Y[i] += alpha * X[i];
+    return;
+  }
   for (unsigned int i = 0; i < N; ++i)
     Y[i * incY] = Y[i * incY] + X[i * incX] * alpha;
 }
@@ -46,19 +488,79 @@ static void sgemv_raw(CBLAS_ORDER order, CBLAS_TRANSPOSE TransA,
                       const float alpha, const float *A, const unsigned int lda,
                       const float *X, const int incX, const float beta,
                       float *Y, const int incY) {
+  if (order != CblasRowMajor)
+    throw std::invalid_argument(
+      "Error: only row major is supported without cblas");
 
   unsigned int incy = abs(incY);
   unsigned int incx = abs(incX);
+  unsigned int len_x = TransA == CblasTrans ? M : N;
+  unsigned int len_y = TransA == CblasTrans ? N : M;
+
+  static const GemvMicroKernel micro_kernel = selectGemvMicroKernel();
+  static const GemvTransMicroKernel trans_micro_kernel =
+    selectGemvTransMicroKernel();
+
+  /// make x contiguous so that the rows of A are walked with unit stride
+  const float *x = X;
+  if (incx != 1) {
+    float *x_buf = getScratch(&BlasScratch::x, len_x);
+    for (unsigned int i = 0; i < len_x; ++i)
+      x_buf[i] = X[i * incx];
+    x = x_buf;
+  }
+
+  for (unsigned int i = 0; i < len_y; ++i)
+    Y[i * incy] = beta == 0.0f ? 0.0f : beta * Y[i * incy];
+
+  if (alpha == 0.0f)
+    return;
+
+  /// y is accumulated in place when it is contiguous
+  float *y = Y;
+  if (incy != 1) {
+    y = getScratch(&BlasScratch::y, len_y);
+    std::fill(y, y + len_y, 0.0f);
+  }
+
+  unsigned int i = 0;
   if (TransA == CblasTrans) {
-    sgemv_loop(i, j, N, M);
+    /// y += alpha * x[i] * A[i, :] accumulated GEMV_MR rows at a time
+    for (; i + GEMV_MR <= M; i += GEMV_MR) {
+      float scale[GEMV_MR];
+      for (unsigned int r = 0; r < GEMV_MR; ++r)
+        scale[r] = alpha * x[i + r];
+      trans_micro_kernel(N, A + i * lda, lda, scale, y);
+    }
+    for (; i < M; ++i) {
+      float scale = alpha * x[i];
+      const float *a_row = A + i * lda;
+      for (unsigned int j = 0; j < N; ++j)
+        y[j] += scale * a_row[j];
+    }
   } else {
-    sgemv_loop(j, i, M, N);
+    for (; i + GEMV_MR <= M; i += GEMV_MR) {
+      float dot[GEMV_MR] = {0.0f};
+      micro_kernel(N, A + i * lda, lda, x, dot);
+      for (unsigned int r = 0; r < GEMV_MR; ++r)
+        y[i + r] += alpha * dot[r];
+    }
+    for (; i < M; ++i)
+      y[i] += alpha * sdot_contiguous(N, A + i * lda, x);
+  }
+
+  if (incy != 1) {
+    for (unsigned int j = 0; j < len_y; ++j)
+      Y[j * incy] += y[j];
   }
 }
 
 static float sdot_raw(const unsigned int N, const float *X,
                       const unsigned int incX, const float *Y,
                       const unsigned int incY) {
+  if (incX == 1 && incY == 1)
+    return sdot_contiguous(N, X, Y);
+
   float ret = 0;
   for (unsigned int i = 0; i < N; ++i) {
     ret += X[i * incX] * Y[i * incY];
@@ -79,6 +581,14 @@ static void sscal_raw(const unsigned int N, const float alpha, float *X,
                       const int incX) {
   unsigned int incx = abs(incX);
 
+  /// Tensor::setZero() relies on this to clear uninitialized memory, which
+  /// might hold nan
+  if (alpha == 0.0f) {
+    for (unsigned int i = 0; i < N; ++i)
+      X[i * incx] = 0.0f;
+    return;
+  }
+
   for (unsigned int i = 0; i < N; ++i)
     X[i * incx] = alpha * X[i * incx];
 }
@@ -95,26 +605,85 @@ static float snrm2_raw(const unsigned int N, const float *X, const int incX) {
   return sqrt(sum);
 }
 
+/**
+ * @brief sgemm blocked for the cache and tiled for the registers
+ * @details op(B) is packed in [KC x NC] blocks and op(A) in [MC x KC] blocks,
+ * and the micro kernel computes [MR x NR] tiles of C from the packed panels.
+ * alpha is folded into the packed A.
+ */
 static void sgemm_raw(CBLAS_ORDER order, CBLAS_TRANSPOSE TransA,
                       CBLAS_TRANSPOSE TransB, const unsigned int M,
                       const unsigned int N, const unsigned int K,
                       const float alpha, const float *A, const unsigned int lda,
                       const float *B, const unsigned int ldb, const float beta,
                       float *C, const unsigned int ldc) {
+  if (order != CblasRowMajor)
+    throw std::invalid_argument(
+      "Error: only row major is supported without cblas");
+
+  static const GemmMicroKernel micro_kernel = selectGemmMicroKernel();
 
   for (unsigned int m = 0; m < M; ++m) {
-    for (unsigned int n = 0; n < N; ++n) {
-      double c = 0.0;
-      float c_old = C[m * ldc + n];
-      for (unsigned int k = 0; k < K; ++k) {
-        float a, b;
-        a = ((TransA == CblasTrans) ? A[k * lda + m] : A[m * lda + k]);
-        b = ((TransB == CblasTrans) ? B[n * ldb + k] : B[k * ldb + n]);
-        c += a * b;
+    float *c_row = C + m * ldc;
+    if (beta == 0.0f)
+      std::fill(c_row, c_row + N, 0.0f);
+    else if (beta != 1.0f)
+      for (unsigned int n = 0; n < N; ++n)
+        c_row[n] *= beta;
+  }
+
+  if (K == 0 || alpha == 0.0f)
+    return;
+
+  unsigned int nc_max = std::min(GEMM_NC, N);
+  unsigned int kc_max = std::min(GEMM_KC, K);
+  unsigned int mc_max = std::min(GEMM_MC, M);
+  float *packed_b =
+    getScratch(&BlasScratch::packed_b,
+               ((nc_max + GEMM_NR - 1) / GEMM_NR) * GEMM_NR * kc_max);
+  float *packed_a =
+    getScratch(&BlasScratch::packed_a,
+               ((mc_max + GEMM_MR - 1) / GEMM_MR) * GEMM_MR * kc_max);
+  float edge[GEMM_MR * GEMM_NR];
+
+  for (unsigned int jc = 0; jc < N; jc += GEMM_NC) {
+    unsigned int nc = std::min(GEMM_NC, N - jc);
+
+    for (unsigned int pc = 0; pc < K; pc += GEMM_KC) {
+      unsigned int kc = std::min(GEMM_KC, K - pc);
+      const float *b_block =
+        TransB == CblasTrans ? B + jc * ldb + pc : B + pc * ldb + jc;
+      pack_b(TransB, b_block, ldb, kc, nc, packed_b);
+
+      for (unsigned int ic = 0; ic < M; ic += GEMM_MC) {
+        unsigned int mc = std::min(GEMM_MC, M - ic);
+        const float *a_block =
+          TransA == CblasTrans ? A + pc * lda + ic : A + ic * lda + pc;
+        pack_a(TransA, a_block, lda, mc, kc, alpha, packed_a);
+
+        for (unsigned int jr = 0; jr < nc; jr += GEMM_NR) {
+          unsigned int nr = std::min(GEMM_NR, nc - jr);
+          const float *b_panel = packed_b + jr * kc;
+
+          for (unsigned int ir = 0; ir < mc; ir += GEMM_MR) {
+            unsigned int mr = std::min(GEMM_MR, mc - ir);
+            const float *a_panel = packed_a + ir * kc;
+            float *c_tile = C + (ic + ir) * ldc + jc + jr;
+
+            if (mr == GEMM_MR && nr == GEMM_NR) {
+              micro_kernel(kc, a_panel, b_panel, c_tile, ldc);
+              continue;
+            }
+
+            /// partial tile at the edge goes through a temporary tile
+            std::fill(edge, edge + GEMM_MR * GEMM_NR, 0.0f);
+            micro_kernel(kc, a_panel, b_panel, edge, GEMM_NR);
+            for (unsigned int i = 0; i < mr; ++i)
+              for (unsigned int j = 0; j < nr; ++j)
+                c_tile[i * ldc + j] += edge[i * GEMM_NR + j];
+          }
+        }
       }
-      C[m * ldc + n] = alpha * c;
-      if (beta != 0.0)
-        C[m * ldc + n] += beta * c_old;
     }
   }
 }
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   half_precision.cpp
+ * @date   17 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  Conversion kernels between fp32 and the 16 bit floating points
+ *
+ */
+
+#include <cmath>
+#include <cstring>
+
+#include <half_precision.h>
+
+namespace nntrainer {
+
+using DataType = TensorDataType;
+
+/**
+ * @brief reinterpret the bits of a float
+ */
+static inline uint32_t floatBits(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+/**
+ * @brief reinterpret bits as a float
+ */
+static inline float bitsFloat(uint32_t bits) {
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+uint16_t fp32ToFp16(float value) {
+#ifdef __ARM_FP16_FORMAT_IEEE
+  __fp16 h = value;
+  uint16_t bits;
+  std::memcpy(&bits, &h, sizeof(bits));
+  return bits;
+#else
+  uint32_t x = floatBits(value);
+  uint16_t sign = (x >> 16) & 0x8000;
+  uint32_t abs = x & 0x7fffffff;
+
+  /// infinity and NaN, NaN is kept quiet
+  if (abs >= 0x7f800000)
+    return sign | 0x7c00 | (abs > 0x7f800000 ? 0x0200 : 0);
+
+  /// 65520 and above round to infinity
+  if (abs >= 0x477ff000)
+    return sign | 0x7c00;
+
+  /// below 2^-14, the result is a subnormal in the unit of 2^-24
+  if (abs < 0x38800000) {
+    float scaled = bitsFloat(abs) * 16777216.0f;
+    return sign | static_cast<uint16_t>(std::nearbyint(scaled));
+  }
+
+  /// round the mantissa to nearest even and rebias the exponent by 127 - 15
+  abs += 0x0fff + ((abs >> 13) & 1);
+  return sign | static_cast<uint16_t>((abs - 0x38000000) >> 13);
+#endif
+}
+
+float fp16ToFp32(uint16_t value) {
+#ifdef __ARM_FP16_FORMAT_IEEE
+  __fp16 h;
+  std::memcpy(&h, &value, sizeof(h));
+  return h;
+#else
+  uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+  uint32_t exp = (value >> 10) & 0x1f;
+  uint32_t mant = value & 0x3ff;
+
+  if (exp == 0x1f)
+    return bitsFloat(sign | 0x7f800000 | (mant << 13));
+
+  if (exp == 0) {
+    float subnormal = mant * 5.9604644775390625e-08f; /// 2^-24
+    return sign ? -subnormal : subnormal;
+  }
+
+  return bitsFloat(sign | ((exp + 112) << 23) | (mant << 13));
+#endif
+}
+
+uint16_t fp32ToBf16(float value) {
+  uint32_t x = floatBits(value);
+
+  /// NaN is kept quiet, as rounding could turn it into infinity
+  if ((x & 0x7fffffff) > 0x7f800000)
+    return static_cast<uint16_t>((x >> 16) | 0x0040);
+
+  x += 0x7fff + ((x >> 16) & 1);
+  return static_cast<uint16_t>(x >> 16);
+}
+
+float bf16ToFp32(uint16_t value) {
+  return bitsFloat(static_cast<uint32_t>(value) << 16);
+}
+
+void convertData(const void *src, DataType src_type, void *dst,
+                 DataType dst_type, size_t len) {
+  if (src_type == dst_type) {
+    size_t elem = src_type == DataType::FP32 ? sizeof(float) : sizeof(uint16_t);
+    std::memcpy(dst, src, len * elem);
+    return;
+  }
+
+  if (src_type == DataType::FP32) {
+    const float *from = static_cast<const float *>(src);
+    uint16_t *to = static_cast<uint16_t *>(dst);
+    auto convert = dst_type == DataType::FP16 ? fp32ToFp16 : fp32ToBf16;
+    for (size_t i = 0; i < len; ++i)
+      to[i] = convert(from[i]);
+    return;
+  }
+
+  const uint16_t *from = static_cast<const uint16_t *>(src);
+  auto to_fp32 = src_type == DataType::FP16 ? fp16ToFp32 : bf16ToFp32;
+
+  if (dst_type == DataType::FP32) {
+    float *to = static_cast<float *>(dst);
+    for (size_t i = 0; i < len; ++i)
+      to[i] = to_fp32(from[i]);
+    return;
+  }
+
+  uint16_t *to = static_cast<uint16_t *>(dst);
+  auto from_fp32 = dst_type == DataType::FP16 ? fp32ToFp16 : fp32ToBf16;
+  for (size_t i = 0; i < len; ++i)
+    to[i] = from_fp32(to_fp32(from[i]));
+}
+
+} // namespace nntrainer
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   half_precision.h
+ * @date   17 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  Conversion kernels between fp32 and the 16 bit floating points
+ *
+ */
+
+#ifndef __HALF_PRECISION_H__
+#define __HALF_PRECISION_H__
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nntrainer {
+
+/**
+ * @brief     Enumeration of the data type of the tensor elements
+ */
+enum class TensorDataType {
+  FP32, /**< 32 bit float */
+  FP16, /**< IEEE 754 16 bit float */
+  BF16  /**< brain float, the upper 16 bits of the 32 bit float */
+};
+
+/**
+ * @brief convert a fp32 value to IEEE 754 half precision
+ * @note values are rounded to the nearest even, values too large for the half
+ * precision become infinity and NaN stays NaN
+ *
+ * @param value value to convert
+ * @return uint16_t bits of the half precision value
+ */
+uint16_t fp32ToFp16(float value);
+
+/**
+ * @brief convert an IEEE 754 half precision value to fp32, which is exact
+ *
+ * @param value bits of the half precision value
+ * @return float converted value
+ */
+float fp16ToFp32(uint16_t value);
+
+/**
+ * @brief convert a fp32 value to bfloat16, rounding to the nearest even
+ *
+ * @param value value to convert
+ * @return uint16_t bits of the bfloat16 value
+ */
+uint16_t fp32ToBf16(float value);
+
+/**
+ * @brief convert a bfloat16 value to fp32, which is exact
+ *
+ * @param value bits of the bfloat16 value
+ * @return float converted value
+ */
+float bf16ToFp32(uint16_t value);
+
+/**
+ * @brief convert the data between the data types of the tensor
+ *
+ * @param[in] src data to convert
+ * @param[in] src_type data type of @a src
+ * @param[out] dst converted data, which must not overlap with @a src
+ * @param[in] dst_type data type of @a dst
+ * @param[in] len number of the elements
+ */
+void convertData(const void *src, TensorDataType src_type, void *dst,
+                 TensorDataType dst_type, size_t len);
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __HALF_PRECISION_H__ */
@@ -11,18 +11,45 @@
  *
  */
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
 #include <lazy_tensor.h>
 #include <nntrainer_error.h>
+#include <util_func.h>
 
 namespace nntrainer {
 
+namespace {
+
+/** number of elements evaluated at once by a fused group, small enough to
+ * stay in the L1 cache while all the operations are applied */
+constexpr unsigned int FUSED_BLOCK_SIZE = 256;
+
+/**
+ * @brief check if the tensor is laid out without any gap
+ */
+bool isPacked(const Tensor &t) {
+  return t.getStrides() == t.getDim().computeStrides();
+}
+
+} // namespace
+
+void LazyTensor::pushElementwise(ElementwiseOp op) {
+  if (call_chain.empty() || call_chain.back().ops.empty()) {
+    call_chain.push_back(Stage());
+  }
+
+  call_chain.back().ops.push_back(op);
+}
+
 /**
  * @brief Wrapper method of add_i (immediate version of add)
  * @retval this
  */
 LazyTensor &LazyTensor::add_i(float const &value) {
-  call_chain.push_back(
-    [value](Tensor &t) mutable -> int { return t.add_i(value); });
+  pushElementwise({ElementwiseOp::Type::ADD_SCALAR, value, nullptr, nullptr});
   return *this;
 }
 /**
@@ -31,8 +58,7 @@ LazyTensor &LazyTensor::add_i(float const &value) {
  * @retval    LazyTensor *this
  */
 LazyTensor &LazyTensor::add_i(Tensor const &m, float const alpha) {
-  auto f = [&m, alpha](Tensor &t) mutable -> int { return t.add_i(m, alpha); };
-  call_chain.push_back(f);
+  pushElementwise({ElementwiseOp::Type::ADD, alpha, &m, nullptr});
   return *this;
 }
 
@@ -42,8 +68,7 @@ LazyTensor &LazyTensor::add_i(Tensor const &m, float const alpha) {
  * @retval    LazyTensor *this
  */
 LazyTensor &LazyTensor::subtract_i(Tensor const &m) {
-  auto f = [&m](Tensor &t) mutable -> int { return t.subtract_i(m); };
-  call_chain.push_back(f);
+  pushElementwise({ElementwiseOp::Type::ADD, -1.0f, &m, nullptr});
   return *this;
 }
 
@@ -53,8 +78,7 @@ LazyTensor &LazyTensor::subtract_i(Tensor const &m) {
  * @retval    LazyTensor *this
  */
 LazyTensor &LazyTensor::subtract_i(float const &value) {
-  auto f = [value](Tensor &t) mutable -> int { return t.subtract_i(value); };
-  call_chain.push_back(f);
+  pushElementwise({ElementwiseOp::Type::ADD_SCALAR, -value, nullptr, nullptr});
   return *this;
 }
 
@@ -64,8 +88,8 @@ LazyTensor &LazyTensor::subtract_i(float const &value) {
  * @retval LazyTensor *this
  */
 LazyTensor &LazyTensor::multiply_i(float const &value) {
-  auto f = [value](Tensor &t) mutable -> int { return t.multiply_i(value); };
-  call_chain.push_back(f);
+  pushElementwise(
+    {ElementwiseOp::Type::MULTIPLY_SCALAR, value, nullptr, nullptr});
   return *this;
 }
 
@@ -75,8 +99,7 @@ LazyTensor &LazyTensor::multiply_i(float const &value) {
  * @retval    LazyTensor *this
  */
 LazyTensor &LazyTensor::multiply_i(Tensor const &m) {
-  auto f = [&m](Tensor &t) mutable -> int { return t.multiply_i(m); };
-  call_chain.push_back(f);
+  pushElementwise({ElementwiseOp::Type::MULTIPLY, 0.0f, &m, nullptr});
   return *this;
 }
 
@@ -86,8 +109,8 @@ LazyTensor &LazyTensor::multiply_i(Tensor const &m) {
  * @retval    LazyTensor *this
  */
 LazyTensor &LazyTensor::divide_i(float const &value) {
-  auto f = [value](Tensor &t) mutable -> int { return t.divide_i(value); };
-  call_chain.push_back(f);
+  pushElementwise(
+    {ElementwiseOp::Type::DIVIDE_SCALAR, value, nullptr, nullptr});
   return *this;
 }
 
@@ -97,8 +120,39 @@ LazyTensor &LazyTensor::divide_i(float const &value) {
  * @retval    LazyTensor *this
  */
 LazyTensor &LazyTensor::divide_i(Tensor const &m) {
-  auto f = [&m](Tensor &t) mutable -> int { return t.divide_i(m); };
-  call_chain.push_back(f);
+  pushElementwise({ElementwiseOp::Type::DIVIDE, 0.0f, &m, nullptr});
+  return *this;
+}
+
+/**
+ * @brief     add the element-wise product of two tensors
+ * @param[in] m Tensor to be multiplied
+ * @param[in] n Tensor to be multiplied
+ * @param[in] alpha scale of the product
+ * @retval    LazyTensor *this
+ */
+LazyTensor &LazyTensor::add_product_i(Tensor const &m, Tensor const &n,
+                                      float const alpha) {
+  pushElementwise({ElementwiseOp::Type::ADD_PRODUCT, alpha, &m, &n});
+  return *this;
+}
+
+/**
+ * @brief     Wrapper method of pow_i. see tensor.h for more detail
+ * @param[in] exponent exponent
+ * @retval    LazyTensor *this
+ */
+LazyTensor &LazyTensor::pow_i(float exponent) {
+  pushElementwise({ElementwiseOp::Type::POW, exponent, nullptr, nullptr});
+  return *this;
+}
+
+/**
+ * @brief     element-wise square root
+ * @retval    LazyTensor *this
+ */
+LazyTensor &LazyTensor::sqrt_i() {
+  pushElementwise({ElementwiseOp::Type::SQRT, 0.0f, nullptr, nullptr});
   return *this;
 }
 
@@ -118,7 +172,7 @@ LazyTensor &LazyTensor::dot(Tensor const &m) {
     }
   };
 
-  call_chain.push_back(f);
+  call_chain.push_back({{}, f});
   return *this;
 }
 
@@ -138,7 +192,7 @@ LazyTensor &LazyTensor::transpose(std::string direction) {
     }
   };
 
-  call_chain.push_back(f);
+  call_chain.push_back({{}, f});
   return *this;
 }
 
@@ -158,7 +212,7 @@ LazyTensor &LazyTensor::sum_by_batch() {
     }
   };
 
-  call_chain.push_back(f);
+  call_chain.push_back({{}, f});
   return *this;
 }
 
@@ -178,7 +232,7 @@ LazyTensor &LazyTensor::sum(int axis) {
     }
   };
 
-  call_chain.push_back(f);
+  call_chain.push_back({{}, f});
   return *this;
 }
 
@@ -197,7 +251,7 @@ LazyTensor &LazyTensor::average(int axis) {
     }
   };
 
-  call_chain.push_back(f);
+  call_chain.push_back({{}, f});
   return *this;
 }
 
@@ -216,7 +270,7 @@ LazyTensor &LazyTensor::average() {
     }
   };
 
-  call_chain.push_back(f);
+  call_chain.push_back({{}, f});
   return *this;
 }
 
@@ -225,14 +279,325 @@ LazyTensor &LazyTensor::average() {
  * @retval calculated tensor
  */
 Tensor LazyTensor::run() {
-  int status;
-  for (auto item : call_chain) {
-    status = item(target);
-    if (status != ML_ERROR_NONE) {
+  Tensor output;
+  return run(output);
+}
+
+/**
+ * @brief execute the call_chain and store the result to the output
+ * @retval output
+ */
+Tensor &LazyTensor::run(Tensor &output) {
+  Tensor cur = source;
+  /** true if cur is created during the evaluation and can be modified */
+  bool owned = false;
+
+  for (unsigned int i = 0; i < call_chain.size(); ++i) {
+    Stage &stage = call_chain[i];
+    if (stage.ops.empty()) {
+      if (stage.fn(cur) != ML_ERROR_NONE) {
+        throw std::runtime_error("Error: evaluation failed");
+      }
+      owned = true;
+    } else if (i + 1 == call_chain.size()) {
+      runFused(stage.ops, cur, output);
+      return output;
+    } else if (owned) {
+      runFused(stage.ops, cur, cur);
+    } else {
+      Tensor result;
+      runFused(stage.ops, cur, result);
+      cur = result;
+      owned = true;
+    }
+  }
+
+  output.copy(cur);
+  return output;
+}
+
+namespace {
+
+/**
+ * @brief apply a single element-wise operation with the tensor api
+ * @param[in] type type of the operation
+ * @param[in] value scalar operand
+ * @param[in] m first tensor operand
+ * @param[in] n second tensor operand
+ * @param[in/out] t tensor to apply the operation in place
+ * @retval #ML_ERROR_NONE Successful
+ * @retval #ML_ERROR_INVALID_PARAMETER Invalid Parameter
+ */
+template <typename Type>
+int applyUnfused(Type type, float value, const Tensor *m, const Tensor *n,
+                 Tensor &t) {
+  try {
+    switch (type) {
+    case Type::ADD_SCALAR:
+      return t.add_i(value);
+    case Type::MULTIPLY_SCALAR:
+      return t.multiply_i(value);
+    case Type::DIVIDE_SCALAR:
+      return t.divide_i(value);
+    case Type::ADD:
+      return t.add_i(*m, value);
+    case Type::MULTIPLY:
+      return t.multiply_i(*m);
+    case Type::DIVIDE:
+      return t.divide_i(*m);
+    case Type::ADD_PRODUCT:
+      return t.add_i(m->multiply(*n), value);
+    case Type::POW:
+      return t.pow_i(value);
+    case Type::SQRT:
+      return t.apply_i(sqrtFloat);
+    }
+  } catch (std::exception &e) {
+    return ML_ERROR_INVALID_PARAMETER;
+  }
+
+  return ML_ERROR_INVALID_PARAMETER;
+}
+
+/**
+ * @brief apply a single element-wise operation to a block
+ * @param[in] type type of the operation
+ * @param[in] value scalar operand
+ * @param[in] src input block
+ * @param[out] dst output block, can be the same as @a src
+ * @param[in] len length of the block
+ * @param[in] m first tensor operand of the block
+ * @param[in] m_inc increment of @a m, 0 if broadcasted
+ * @param[in] n second tensor operand of the block
+ * @param[in] n_inc increment of @a n, 0 if broadcasted
+ */
+template <typename Type>
+void applyBlock(Type type, float value, const float *src, float *dst,
+                unsigned int len, const float *m, unsigned int m_inc,
+                const float *n, unsigned int n_inc) {
+  switch (type) {
+  case Type::ADD_SCALAR:
+    for (unsigned int i = 0; i < len; ++i)
+      dst[i] = src[i] + value;
+    break;
+  case Type::MULTIPLY_SCALAR:
+    for (unsigned int i = 0; i < len; ++i)
+      dst[i] = src[i] * value;
+    break;
+  case Type::DIVIDE_SCALAR:
+    for (unsigned int i = 0; i < len; ++i)
+      dst[i] = src[i] / value;
+    break;
+  case Type::ADD:
+    if (m_inc == 1) {
+      for (unsigned int i = 0; i < len; ++i)
+        dst[i] = src[i] + value * m[i];
+    } else {
+      float mv = value * m[0];
+      for (unsigned int i = 0; i < len; ++i)
+        dst[i] = src[i] + mv;
+    }
+    break;
+  case Type::MULTIPLY:
+    if (m_inc == 1) {
+      for (unsigned int i = 0; i < len; ++i)
+        dst[i] = src[i] * m[i];
+    } else {
+      float mv = m[0];
+      for (unsigned int i = 0; i < len; ++i)
+        dst[i] = src[i] * mv;
+    }
+    break;
+  case Type::DIVIDE:
+    if (m_inc == 1) {
+      for (unsigned int i = 0; i < len; ++i)
+        dst[i] = src[i] / m[i];
+    } else {
+      float mv = m[0];
+      for (unsigned int i = 0; i < len; ++i)
+        dst[i] = src[i] / mv;
+    }
+    break;
+  case Type::ADD_PRODUCT:
+    if (m_inc == 1 && n_inc == 1) {
+      for (unsigned int i = 0; i < len; ++i)
+        dst[i] = src[i] + value * m[i] * n[i];
+    } else {
+      for (unsigned int i = 0; i < len; ++i)
+        dst[i] = src[i] + value * m[i * m_inc] * n[i * n_inc];
+    }
+    break;
+  case Type::POW:
+    if (value == 2.0f) {
+      for (unsigned int i = 0; i < len; ++i)
+        dst[i] = src[i] * src[i];
+    } else if (value == 0.5f) {
+      for (unsigned int i = 0; i < len; ++i)
+        dst[i] = std::sqrt(src[i]);
+    } else if (value == -0.5f) {
+      for (unsigned int i = 0; i < len; ++i)
+        dst[i] = 1.0f / std::sqrt(src[i]);
+    } else if (value == -1.0f) {
+      for (unsigned int i = 0; i < len; ++i)
+        dst[i] = 1.0f / src[i];
+    } else {
+      for (unsigned int i = 0; i < len; ++i)
+        dst[i] = std::pow(src[i], value);
+    }
+    break;
+  case Type::SQRT:
+    for (unsigned int i = 0; i < len; ++i)
+      dst[i] = std::sqrt(src[i]);
+    break;
+  }
+}
+
+} // namespace
+
+void LazyTensor::runFused(const std::vector<ElementwiseOp> &ops,
+                          const Tensor &in, Tensor &out) {
+  using Type = ElementwiseOp::Type;
+  const TensorDim &dim = in.getDim();
+
+  if (out.empty()) {
+    out = Tensor(dim);
+  }
+
+  NNTR_THROW_IF(out.getDim() != dim, std::invalid_argument)
+    << "output dimension does not match, output: " << out.getDim()
+    << " input: " << dim;
+
+  /** collect tensor operands, op_idx holds the operand index of m and n */
+  std::vector<const Tensor *> operands;
+  std::vector<std::array<int, 2>> op_idx;
+  bool packed = isPacked(in) && isPacked(out);
+  for (auto &op : ops) {
+    if (op.type == Type::DIVIDE_SCALAR && op.value == 0.0f) {
       throw std::runtime_error("Error: evaluation failed");
     }
+
+    std::array<int, 2> idx = {-1, -1};
+    const Tensor *args[2] = {op.m, op.n};
+    for (unsigned int k = 0; k < 2; ++k) {
+      if (args[k] == nullptr) {
+        continue;
+      }
+
+      const TensorDim &m_dim = args[k]->getDim();
+      for (unsigned int axis = 0; axis < TensorDim::MAXDIM; ++axis) {
+        if (m_dim.getTensorDim(axis) != dim.getTensorDim(axis) &&
+            m_dim.getTensorDim(axis) != 1) {
+          throw std::runtime_error("Error: evaluation failed");
+        }
+      }
+
+      packed = packed && isPacked(*args[k]);
+      idx[k] = operands.size();
+      operands.push_back(args[k]);
+    }
+    op_idx.push_back(idx);
+  }
+
+  /** strided tensors are rare, evaluate them one operation at a time */
+  if (!packed) {
+    if (out.getData() != in.getData()) {
+      out.copyData(in);
+    }
+    for (auto &op : ops) {
+      if (applyUnfused(op.type, op.value, op.m, op.n, out) != ML_ERROR_NONE) {
+        throw std::runtime_error("Error: evaluation failed");
+      }
+    }
+    return;
+  }
+
+  /**
+   * find the longest run of inner axes where every operand is either
+   * contiguous with the output or a single broadcasted value
+   */
+  enum { ANY, MATCH, BROADCAST };
+  std::vector<int> kinds(operands.size(), ANY);
+  unsigned int inner_axis = TensorDim::MAXDIM;
+  size_t run_len = 1;
+  for (int axis = TensorDim::MAXDIM - 1; axis >= 0; --axis) {
+    unsigned int len = dim.getTensorDim(axis);
+    std::vector<int> next = kinds;
+    bool fits = true;
+
+    for (unsigned int i = 0; len != 1 && i < operands.size(); ++i) {
+      int kind = operands[i]->getDim().getTensorDim(axis) == len ? MATCH
+                                                                  : BROADCAST;
+      if (next[i] != ANY && next[i] != kind) {
+        fits = false;
+        break;
+      }
+      next[i] = kind;
+    }
+
+    if (!fits) {
+      break;
+    }
+
+    kinds.swap(next);
+    run_len *= len;
+    inner_axis = axis;
+  }
+
+  std::vector<std::array<unsigned int, TensorDim::MAXDIM>> m_strides;
+  for (auto &m : operands) {
+    std::array<unsigned int, TensorDim::MAXDIM> s = m->getStrides();
+    for (unsigned int axis = 0; axis < TensorDim::MAXDIM; ++axis) {
+      if (m->getDim().getTensorDim(axis) == 1) {
+        s[axis] = 0;
+      }
+    }
+    m_strides.push_back(s);
+  }
+
+  const float *in_data = in.getData();
+  float *out_data = out.getData();
+  std::vector<size_t> m_offset(operands.size());
+  size_t outer = dim.getDataLen() / run_len;
+
+  for (size_t o = 0; o < outer; ++o) {
+    std::array<unsigned int, TensorDim::MAXDIM> coord = {0, 0, 0, 0};
+    size_t rem = o;
+    for (int axis = inner_axis - 1; axis >= 0; --axis) {
+      coord[axis] = rem % dim.getTensorDim(axis);
+      rem /= dim.getTensorDim(axis);
+    }
+
+    for (unsigned int i = 0; i < operands.size(); ++i) {
+      m_offset[i] = 0;
+      for (unsigned int axis = 0; axis < inner_axis; ++axis) {
+        m_offset[i] += coord[axis] * m_strides[i][axis];
+      }
+    }
+
+    size_t base = o * run_len;
+    for (size_t s = 0; s < run_len; s += FUSED_BLOCK_SIZE) {
+      unsigned int len = std::min<size_t>(FUSED_BLOCK_SIZE, run_len - s);
+      const float *src = in_data + base + s;
+      float *dst = out_data + base + s;
+
+      for (unsigned int k = 0; k < ops.size(); ++k) {
+        const float *m_ptr[2] = {nullptr, nullptr};
+        unsigned int m_inc[2] = {0, 0};
+        for (unsigned int j = 0; j < 2; ++j) {
+          int i = op_idx[k][j];
+          if (i < 0) {
+            continue;
+          }
+          m_inc[j] = kinds[i] == BROADCAST ? 0 : 1;
+          m_ptr[j] = operands[i]->getData() + m_offset[i] + s * m_inc[j];
+        }
+
+        applyBlock(ops[k].type, ops[k].value, src, dst, len, m_ptr[0],
+                   m_inc[0], m_ptr[1], m_inc[1]);
+        src = dst;
+      }
+    }
   }
-  return target;
 }
 
 } /* namespace nntrainer */
@@ -24,14 +24,21 @@ namespace nntrainer {
  * @class   LazyTensor a wrapper class for lazy calculation of tensor
  * @brief   calculation is delayed until Tensor LazyTensor::run() is
  *          called, can be contructed by Tensor::chain() method
+ * @note    consecutive element-wise operations are fused. They are evaluated
+ *          block by block in a single sweep over the memory instead of one
+ *          sweep per operation.
+ * @note    the source tensor is not copied, the chain shares its memory. The
+ *          values read are the ones at run(), so the source must outlive the
+ *          chain and any change made to it before run() is seen by the
+ *          chain. Copy the source explicitly to snapshot it.
  */
 class LazyTensor {
 public:
   /**
-   * @brief Constructor of Lazy Tensor, Tensor is copied to gaurantee
-   * immutability
+   * @brief Constructor of Lazy Tensor, @a from is not modified. It is not
+   * copied either, but read when the chain is evaluated.
    */
-  LazyTensor(const Tensor &from) { target.copy(from); };
+  LazyTensor(const Tensor &from) : source(from) {}
 
   /**
    * @brief     Wrapper method of add_i. see tensor.h for more detail
@@ -89,6 +96,30 @@ public:
    */
   LazyTensor &divide_i(Tensor const &m);
 
+  /**
+   * @brief     add the element-wise product of two tensors,
+   *            this = this + alpha * m * n
+   * @param[in] m Tensor to be multiplied
+   * @param[in] n Tensor to be multiplied
+   * @param[in] alpha scale of the product
+   * @retval    LazyTensor *this
+   */
+  LazyTensor &add_product_i(Tensor const &m, Tensor const &n,
+                            float const alpha = 1);
+
+  /**
+   * @brief     Wrapper method of pow_i. see tensor.h for more detail
+   * @param[in] exponent exponent
+   * @retval    LazyTensor *this
+   */
+  LazyTensor &pow_i(float exponent);
+
+  /**
+   * @brief     element-wise square root
+   * @retval    LazyTensor *this
+   */
+  LazyTensor &sqrt_i();
+
   /**
    * @brief     Wrapper method of dot. see tensor.h for more detail (memcopy
    * happens)
@@ -141,10 +172,68 @@ public:
    */
   Tensor run();
 
+  /**
+   * @brief execute the call_chain and store the result to the output
+   * @param[out] output tensor to store the result, allocated if empty. Can be
+   * the source tensor to evaluate the chain in place.
+   * @retval output
+   * @note a tensor operand which is also the output observes the values
+   * computed so far by the chain
+   */
+  Tensor &run(Tensor &output);
+
 private:
-  /**< handle the data as a std::vector type */
-  std::vector<std::function<int(Tensor &)>> call_chain;
-  Tensor target;
+  /**
+   * @brief element-wise operation which can be fused with its neighbours
+   */
+  struct ElementwiseOp {
+    /**
+     * @brief type of the operation
+     */
+    enum class Type {
+      ADD_SCALAR,      /**< x + value */
+      MULTIPLY_SCALAR, /**< x * value */
+      DIVIDE_SCALAR,   /**< x / value */
+      ADD,             /**< x + value * m */
+      MULTIPLY,        /**< x * m */
+      DIVIDE,          /**< x / m */
+      ADD_PRODUCT,     /**< x + value * m * n */
+      POW,             /**< x ^ value */
+      SQRT,            /**< sqrt(x) */
+    };
+
+    Type type;
+    float value;       /**< scalar operand, alpha or exponent */
+    const Tensor *m;   /**< first tensor operand */
+    const Tensor *n;   /**< second tensor operand */
+  };
+
+  /**
+   * @brief stage of the evaluation, either a fused group of element-wise
+   * operations or a single operation which creates a new tensor
+   */
+  struct Stage {
+    std::vector<ElementwiseOp> ops;
+    std::function<int(Tensor &)> fn;
+  };
+
+  /**
+   * @brief append an element-wise operation to the chain
+   * @param[in] op operation to append
+   */
+  void pushElementwise(ElementwiseOp op);
+
+  /**
+   * @brief evaluate a fused group of element-wise operations
+   * @param[in] ops operations to apply in order
+   * @param[in] in input tensor
+   * @param[out] out output tensor, can be the same as @a in
+   */
+  static void runFused(const std::vector<ElementwiseOp> &ops, const Tensor &in,
+                       Tensor &out);
+
+  std::vector<Stage> call_chain; /**< stages to evaluate in order */
+  Tensor source;                 /**< shallow copy of the source tensor */
 };
 
 } /* namespace nntrainer */
@@ -13,130 +13,48 @@
  *
  */
 
-#ifdef __ANDROID__
-#include <android/sharedmem.h>
-#endif
-
-#ifdef DEBUG
-#include <cassert>
-#endif
-
-#include <fcntl.h>
+#include <cstdlib>
 #include <functional>
 #include <limits>
-#include <sys/mman.h>
-#include <sys/stat.h>
-#include <unistd.h>
 #include <vector>
 
 #include <activation_layer.h>
 #include <basic_planner.h>
+#include <best_fit_planner.h>
 #include <bn_layer.h>
 #include <layer_node.h>
 #include <manager.h>
 #include <multiout_layer.h>
+#include <nntrainer_error.h>
 #include <nntrainer_log.h>
 #include <optimized_v1_planner.h>
 #include <util_func.h>
 
 namespace nntrainer {
-MMapedMemory::MMapedMemory(size_t size, bool allocate_fd_) :
-  fd(-1),
-  buf(nullptr),
-  buf_size(0),
-  allocate_fd(allocate_fd_) {
-
-#ifndef __ANDROID__
-  if (allocate_fd) {
-    /// @todo create a file in tmpfs and bind to memfs
-    /// memfd_create is not available for number of platforms so this is
-    /// commented
-    // auto fd_ = memfd_create("", 0);
-    // if (fd_ < 0) {
-    //   throw std::runtime_error("[Manager] creating mem fd failed");
-    // }
-    // if (ftruncate(fd_, size) < 0) {
-    //   throw std::runtime_error("[Manager] truncating fd failed");
-    // }
-    ml_logi("[MMapedMemory] fd creation is not supported in this platform");
-    allocate_fd = false;
-  }
-#endif
-  int fd_ = -1;
-  void *buf_ = nullptr;
-
-  if (allocate_fd) {
-#ifdef __ANDROID__
-    /// unfortunately, memfd_create is not supported before android level 30
-    fd_ = ASharedMemory_create("", size);
-    if (fd_ < 0) {
-      throw std::runtime_error("[MMapedMemory] creating mem fd failed");
-    }
-
-    if (ASharedMemory_setProt(fd_, PROT_READ | PROT_WRITE) < 0) {
-      // unlink / close the given fd here
-      close(fd_);
-      throw std::runtime_error("[MMapedMemory] Setting prot failed");
-    }
-
-    buf_ = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
-#endif
-  } else {
-    buf_ = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
-                fd_, 0);
-  }
-
-  if (buf_ == MAP_FAILED) {
-#ifdef __ANDROID__
-    if (fd_ != -1) {
-      // unlink / close the given fd here
-      close(fd_);
-    }
-#endif
-
-    throw std::runtime_error("[MMapedMemory] mmap failed");
+void Manager::allocateWeights(unsigned int max_exec_order_) {
+  if (!weights_borrowed && !weight_pool.isAllocated()) {
+    finalizeTensorPool(weight_pool, 0, max_exec_order_);
+    weight_pool.allocate();
   }
-
-  fd = fd_;
-  buf = buf_;
-  buf_size = size;
-
-  ml_logd("[MMapedMemory] memory acquired size: %zu, fd: %d, addr: %p",
-          buf_size, fd, buf);
 }
 
-MMapedMemory::~MMapedMemory() noexcept {
-#ifdef DEBUG
-  assert(buf_size > 0 && fd > 0);
-#endif
-
-  if (fd != -1) {
-    if (close(fd) < 0) {
-      ml_logw("[MMapedMemory] closing fd failed on destruction please check");
-    }
-  }
-
-  if (buf != nullptr) {
-    if (munmap(buf, buf_size) < 0) {
-      ml_logw("[MMapedMemory] munmap failed on destruction please check");
-    }
-  }
-
-  /// keeping the invariant although this is not necessary as of now
-  fd = -1;
-  buf = nullptr;
-  buf_size = 0;
-  ml_logd("[MMapedMemory] buf released");
+void Manager::deallocateWeights() {
+  if (!weights_borrowed)
+    weight_pool.deallocate();
 }
 
-void Manager::allocateWeights(unsigned int max_exec_order_) {
-  if (!weight_pool.isAllocated()) {
-    finalizeTensorPool(weight_pool, 0, max_exec_order_);
-    weight_pool.allocate();
-  }
+void Manager::borrowWeights(Manager &lender) {
+  weight_pool.borrow(lender.weight_pool);
+  weights_borrowed = true;
 }
 
-void Manager::deallocateWeights() { weight_pool.deallocate(); }
+void Manager::mapWeights(
+  std::shared_ptr<MMapedMemory> file,
+  const std::unordered_map<std::string, size_t> &offsets) {
+  NNTR_THROW_IF(weights_borrowed, std::invalid_argument)
+    << "cannot map the weights borrowed from another model";
+  weight_pool.map(file, offsets);
+}
 
 /**
  * @brief Allocate memory for all the managed tensors
@@ -556,7 +474,8 @@ bool Manager::isLastAccess(const std::string &name, unsigned current_execution,
  */
 std::vector<Tensor *> Manager::requestWeightOptimizerVariables(
   const std::vector<TensorDim> &dims, const std::string &name,
-  const TensorLifespan &lifespan, Tensor::Initializer initializer) {
+  const TensorLifespan &lifespan, Tensor::Initializer initializer,
+  Tensor::DataType type) {
   auto const &exec_order = weight_pool.getExecutionOrder(name);
 
   std::vector<Tensor *> ret;
@@ -565,7 +484,7 @@ std::vector<Tensor *> Manager::requestWeightOptimizerVariables(
   for (unsigned int idx = 0; idx < dims.size(); idx++)
     ret.push_back(tensor_pool.request(name + ":opt" + std::to_string(idx),
                                       dims[idx], exec_order, lifespan,
-                                      initializer));
+                                      initializer, type));
 
   return ret;
 }
@@ -580,12 +499,22 @@ std::vector<Weight *> Manager::getWeights() {
   return all_weights;
 }
 
+void Manager::setMemoryPlanner(const std::string &type) {
+  NNTR_THROW_IF(type != OptimizedV1Planner::type &&
+                  type != BestFitPlanner::type,
+                std::invalid_argument)
+    << "unknown memory planner: " << type;
+  planner_type = type;
+}
+
 void Manager::finalizeTensorPool(TensorPool &pool, unsigned int start,
                                  unsigned int end) {
-  if (enable_optimizations)
-    pool.finalize(OptimizedV1Planner(), start, end);
-  else
+  if (!enable_optimizations)
     pool.finalize(BasicPlanner(), start, end);
+  else if (planner_type == BestFitPlanner::type)
+    pool.finalize(BestFitPlanner(), start, end);
+  else
+    pool.finalize(OptimizedV1Planner(), start, end);
 }
 
 } // namespace nntrainer
@@ -31,79 +31,14 @@
 
 #include <basic_planner.h>
 #include <graph_node.h>
+#include <mmaped_memory.h>
+#include <optimized_v1_planner.h>
 #include <tensor_pool.h>
 #include <var_grad.h>
 #include <weight.h>
 
 namespace nntrainer {
 
-/**
- * @class MMappedMemory
- * @brief Memory Handler, that has mmaped memory with a file descriptor
- */
-class MMapedMemory {
-public:
-  /**
-   * @brief Construct a new MMapedMemory object
-   *
-   * @param size bytesize of the memory chunk
-   * @param allocate_fd_ map a shared memory object to a file
-   */
-  MMapedMemory(size_t size, bool allocate_fd_ = false);
-
-  /**
-   * @brief Destroy the MMapedMemory object
-   *
-   */
-  ~MMapedMemory() noexcept;
-
-  /**
-   * @brief Construct a new MMapedMemory object (deleted)
-   *
-   */
-  MMapedMemory(const MMapedMemory &) = delete;
-
-  /**
-   * @brief Copy assignment operator (deleted)
-   *
-   */
-  MMapedMemory &operator=(const MMapedMemory &) = delete;
-
-  /**
-   * @brief Get the File descriptor.
-   * Will return -1 except for android
-   * @todo make this available for other platforms
-   *
-   * @return -1 if fd is not allocated (or unabled to allocate)
-   */
-  int getFd() noexcept { return fd; }
-
-  /**
-   * @brief get the size of managed memory
-   *
-   * @return size_t size
-   */
-  size_t size() noexcept { return buf_size; }
-
-  /**
-   * @brief get Typed buffer from the memory
-   *
-   * @tparam T Type to specify the buffer. return is reinterpreted to T*
-   * @return T* Typed buffer, return nullptr if empty
-   */
-  template <typename T> T *typedBuffer() noexcept {
-    return reinterpret_cast<T *>(buf);
-  }
-
-  void *data() noexcept { return typedBuffer<void>(); }
-
-private:
-  int fd;           /**< fd to access the shared_memory  */
-  void *buf;        /**< buffer object when use_shared_memory */
-  size_t buf_size;  /**< buffer size */
-  bool allocate_fd; /**< option to choose to allocate an fd */
-};
-
 /**
  * @class   Manager
  * @brief   manager of nntrainer
@@ -130,7 +65,10 @@ public:
   /**
    * @brief     Constructor of Manager
    */
-  Manager() : enable_optimizations(true) {}
+  Manager() :
+    enable_optimizations(true),
+    planner_type(OptimizedV1Planner::type),
+    weights_borrowed(false) {}
 
   /**
    * @brief Construct a new Manager object (deleted)
@@ -197,13 +135,15 @@ public:
    *
    * @param node Graph node to extract node identifiers/info
    * @param tensors_spec Specficiation for the tensors
+   * @param type data type to store the variables in
    *
    * @return created tensors list
    */
   std::vector<Tensor *> requestWeightOptimizerVariables(
     const std::vector<TensorDim> &dims, const std::string &name,
     const TensorLifespan &lifespan,
-    Tensor::Initializer initializer = Tensor::Initializer::NONE);
+    Tensor::Initializer initializer = Tensor::Initializer::NONE,
+    Tensor::DataType type = Tensor::DataType::FP32);
 
   /**
    * @brief     Create tensors with the given spec
@@ -286,6 +226,13 @@ public:
    */
   bool isAllocated() const { return tensor_pool.isAllocated(); }
 
+  /**
+   * @brief   Check if the manager has allocated weights
+   *
+   * @return true if weights allocated, else false
+   */
+  bool isWeightAllocated() const { return weight_pool.isAllocated(); }
+
   /**
    * @brief Set the batch size for the inputs/outputs of the layers
    */
@@ -346,9 +293,30 @@ public:
 
   /**
    * @brief Deallocate memory for all the weights
+   * @note borrowed weights are left as they are, they are owned by the lender
    */
   void deallocateWeights();
 
+  /**
+   * @brief Use the allocated weights of the given manager instead of
+   * allocating weights
+   *
+   * @param lender manager having the same weights allocated
+   * @note lender must keep the weights allocated while this manager is used
+   */
+  void borrowWeights(Manager &lender);
+
+  /**
+   * @brief Use the memory mapped file for the weights instead of allocating
+   * weights
+   *
+   * @param file mapped file holding the data of the weights
+   * @param offsets byte offset in the file of each weight by name
+   * @throws std::invalid_argument if a weight is missing in offsets
+   */
+  void mapWeights(std::shared_ptr<MMapedMemory> file,
+                  const std::unordered_map<std::string, size_t> &offsets);
+
   /**
    * @brief Set optimizations for manager
    *
@@ -356,6 +324,102 @@ public:
    */
   void setOptimizations(bool val) { enable_optimizations = val; }
 
+  /**
+   * @brief Set the memory planner used when the optimizations are enabled
+   *
+   * @param type type of the planner, optimized_v1_planner or best_fit_planner
+   * @throws std::invalid_argument if the type is not a known planner
+   */
+  void setMemoryPlanner(const std::string &type);
+
+  /**
+   * @brief Use the tensor while recomputing the forwarding in the backwarding
+   *
+   * @param name name of the tensor
+   * @param recompute_order execution order of the recomputation
+   * @param backward_start first execution order of the backwarding if the
+   * tensor is computed again while recomputing, 0 if it is only read
+   */
+  void recompute(const std::string &name, unsigned int recompute_order,
+                 unsigned int backward_start = 0) {
+    tensor_pool.recompute(name, recompute_order, backward_start);
+  }
+
+  /**
+   * @brief Keep the tensor valid up to the given execution order
+   *
+   * @param name name of the tensor
+   * @param order execution order to keep the tensor valid until
+   */
+  void extendTensor(const std::string &name, unsigned int order) {
+    tensor_pool.extend(name, tensor_pool.getTensor(name)->getDim(), {order},
+                       TensorLifespan::BACKWARD_FUNC_LIFESPAN);
+  }
+
+  /**
+   * @brief Switch the recomputed tensors to their memory for the
+   * recomputation in the backwarding, or back to the one for the forwarding
+   *
+   * @param val true to switch to the memory for the recomputation
+   */
+  void setRecomputing(bool val) { tensor_pool.setRecomputing(val); }
+
+  /**
+   * @brief Place the memory of a tensor at the given offset of another tensor,
+   * so that writing to the tensor writes to the region of the other
+   *
+   * @param name name of the tensor to be placed
+   * @param dest name of the tensor to hold the memory
+   * @param offset offset in the number of elements from @a dest
+   * @return true if the tensor is placed, false if it cannot be placed without
+   * changing the memory seen by the other tensors
+   */
+  bool placeTensor(const std::string &name, const std::string &dest,
+                   unsigned int offset) {
+    if (!tensor_pool.canReidentifySource(name, dest))
+      return false;
+
+    tensor_pool.reidentifySource(name, dest, offset);
+    return true;
+  }
+
+  /**
+   * @brief Set the tensors other than the weights to be swapped out to a file
+   * while they are idle
+   *
+   * @param path directory to create the swap file in, empty to disable
+   * @param lookahead number of the execution orders to start swapping in a
+   * tensor ahead of its use
+   */
+  void setMemorySwap(const std::string &path, unsigned int lookahead) {
+    tensor_pool.setSwap(path, lookahead);
+  }
+
+  /**
+   * @brief Swap the tensors for the execution of the given orders
+   *
+   * @param begin first execution order to run
+   * @param end last execution order to run
+   */
+  void swap(unsigned int begin, unsigned int end) {
+    tensor_pool.swap(begin, end);
+  }
+
+  /**
+   * @brief Bring the swapped tensors back to start the next iteration
+   */
+  void resetSwap() { tensor_pool.resetSwap(); }
+
+  /**
+   * @brief Get the memory planned for the tensors other than the weights
+   *
+   * @return std::pair<size_t, size_t> planned size of the pool in bytes and
+   * the theoretical minimum of it, both 0 if not planned yet
+   */
+  std::pair<size_t, size_t> getTensorMemoryPlan() {
+    return {tensor_pool.size(), tensor_pool.minMemoryRequirement()};
+  }
+
   /**
    * @brief Update externally dependent tensors
    *
@@ -421,6 +485,10 @@ private:
 
   bool enable_optimizations; /**< to enable memory optimizations */
 
+  std::string planner_type; /**< planner used with the optimizations */
+
+  bool weights_borrowed; /**< weights are borrowed from another manager */
+
   /**
    * @brief Finalize the given tensor pool
    *
@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   mmaped_memory.cpp
+ * @date   17 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  This is a memory chunk mapped with mmap, anonymous or backed by a
+ * file
+ *
+ */
+
+#ifdef __ANDROID__
+#include <android/sharedmem.h>
+#endif
+
+#ifdef DEBUG
+#include <cassert>
+#endif
+
+#include <cstdlib>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <mmaped_memory.h>
+#include <nntrainer_log.h>
+
+namespace nntrainer {
+
+MMapedMemory::MMapedMemory(size_t size, bool allocate_fd_) :
+  fd(-1),
+  buf(nullptr),
+  buf_size(0),
+  allocate_fd(allocate_fd_) {
+
+#ifndef __ANDROID__
+  if (allocate_fd) {
+    /// @todo create a file in tmpfs and bind to memfs
+    /// memfd_create is not available for number of platforms so this is
+    /// commented
+    // auto fd_ = memfd_create("", 0);
+    // if (fd_ < 0) {
+    //   throw std::runtime_error("[Manager] creating mem fd failed");
+    // }
+    // if (ftruncate(fd_, size) < 0) {
+    //   throw std::runtime_error("[Manager] truncating fd failed");
+    // }
+    ml_logi("[MMapedMemory] fd creation is not supported in this platform");
+    allocate_fd = false;
+  }
+#endif
+  int fd_ = -1;
+  void *buf_ = nullptr;
+
+  if (allocate_fd) {
+#ifdef __ANDROID__
+    /// unfortunately, memfd_create is not supported before android level 30
+    fd_ = ASharedMemory_create("", size);
+    if (fd_ < 0) {
+      throw std::runtime_error("[MMapedMemory] creating mem fd failed");
+    }
+
+    if (ASharedMemory_setProt(fd_, PROT_READ | PROT_WRITE) < 0) {
+      // unlink / close the given fd here
+      close(fd_);
+      throw std::runtime_error("[MMapedMemory] Setting prot failed");
+    }
+
+    buf_ = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+#endif
+  } else {
+    buf_ = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                fd_, 0);
+  }
+
+  if (buf_ == MAP_FAILED) {
+#ifdef __ANDROID__
+    if (fd_ != -1) {
+      // unlink / close the given fd here
+      close(fd_);
+    }
+#endif
+
+    throw std::runtime_error("[MMapedMemory] mmap failed");
+  }
+
+  fd = fd_;
+  buf = buf_;
+  buf_size = size;
+
+  ml_logd("[MMapedMemory] memory acquired size: %zu, fd: %d, addr: %p",
+          buf_size, fd, buf);
+}
+
+MMapedMemory::MMapedMemory(const std::string &dir, size_t size) :
+  fd(-1),
+  buf(nullptr),
+  buf_size(0),
+  allocate_fd(true) {
+  std::string path = dir + "/nntrainer_swap_XXXXXX";
+  int fd_ = mkstemp(&path[0]);
+  if (fd_ < 0) {
+    throw std::runtime_error("[MMapedMemory] creating file failed, path: " +
+                             path);
+  }
+
+  /// the file is deleted once the fd is closed
+  unlink(path.c_str());
+
+  if (ftruncate(fd_, size) < 0) {
+    close(fd_);
+    throw std::runtime_error("[MMapedMemory] truncating file failed");
+  }
+
+  void *buf_ = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (buf_ == MAP_FAILED) {
+    close(fd_);
+    throw std::runtime_error("[MMapedMemory] mmap failed");
+  }
+
+  fd = fd_;
+  buf = buf_;
+  buf_size = size;
+
+  ml_logd("[MMapedMemory] file acquired size: %zu, fd: %d, addr: %p",
+          buf_size, fd, buf);
+}
+
+MMapedMemory::MMapedMemory(const std::string &path) :
+  fd(-1),
+  buf(nullptr),
+  buf_size(0),
+  allocate_fd(true) {
+  int fd_ = open(path.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    throw std::runtime_error("[MMapedMemory] opening file failed, path: " +
+                             path);
+  }
+
+  struct stat st;
+  if (fstat(fd_, &st) < 0 || st.st_size == 0) {
+    close(fd_);
+    throw std::runtime_error("[MMapedMemory] file is empty, path: " + path);
+  }
+
+  size_t size = st.st_size;
+  void *buf_ = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd_, 0);
+  if (buf_ == MAP_FAILED) {
+    close(fd_);
+    throw std::runtime_error("[MMapedMemory] mmap failed, path: " + path);
+  }
+
+  fd = fd_;
+  buf = buf_;
+  buf_size = size;
+
+  ml_logd("[MMapedMemory] file mapped size: %zu, fd: %d, addr: %p", buf_size,
+          fd, buf);
+}
+
+MMapedMemory::~MMapedMemory() noexcept {
+#ifdef DEBUG
+  assert(buf_size > 0 && fd > 0);
+#endif
+
+  if (fd != -1) {
+    if (close(fd) < 0) {
+      ml_logw("[MMapedMemory] closing fd failed on destruction please check");
+    }
+  }
+
+  if (buf != nullptr) {
+    if (munmap(buf, buf_size) < 0) {
+      ml_logw("[MMapedMemory] munmap failed on destruction please check");
+    }
+  }
+
+  /// keeping the invariant although this is not necessary as of now
+  fd = -1;
+  buf = nullptr;
+  buf_size = 0;
+  ml_logd("[MMapedMemory] buf released");
+}
+
+} // namespace nntrainer
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   mmaped_memory.h
+ * @date   17 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  This is a memory chunk mapped with mmap, anonymous or backed by a
+ * file
+ *
+ */
+
+#ifndef __MMAPED_MEMORY_H__
+#define __MMAPED_MEMORY_H__
+#ifdef __cplusplus
+
+#include <cstddef>
+#include <string>
+
+namespace nntrainer {
+
+/**
+ * @class MMappedMemory
+ * @brief Memory Handler, that has mmaped memory with a file descriptor
+ */
+class MMapedMemory {
+public:
+  /**
+   * @brief Construct a new MMapedMemory object
+   *
+   * @param size bytesize of the memory chunk
+   * @param allocate_fd_ map a shared memory object to a file
+   */
+  MMapedMemory(size_t size, bool allocate_fd_ = false);
+
+  /**
+   * @brief Construct a new MMapedMemory object backed by a file
+   *
+   * @param dir directory to create the file in. The file is removed from the
+   * directory right away, and released with the memory.
+   * @param size bytesize of the memory chunk
+   * @throws std::runtime_error if the file cannot be created or mapped
+   */
+  MMapedMemory(const std::string &dir, size_t size);
+
+  /**
+   * @brief Construct a new MMapedMemory object mapping an existing file
+   *
+   * @param path path of the file to map as a whole
+   * @throws std::runtime_error if the file cannot be opened or mapped
+   * @note the mapping is private, writing to the memory does not change the
+   * file but copies the written pages on demand
+   */
+  explicit MMapedMemory(const std::string &path);
+
+  /**
+   * @brief Destroy the MMapedMemory object
+   *
+   */
+  ~MMapedMemory() noexcept;
+
+  /**
+   * @brief Construct a new MMapedMemory object (deleted)
+   *
+   */
+  MMapedMemory(const MMapedMemory &) = delete;
+
+  /**
+   * @brief Copy assignment operator (deleted)
+   *
+   */
+  MMapedMemory &operator=(const MMapedMemory &) = delete;
+
+  /**
+   * @brief Get the File descriptor.
+   * Will return -1 except for android
+   * @todo make this available for other platforms
+   *
+   * @return -1 if fd is not allocated (or unabled to allocate)
+   */
+  int getFd() noexcept { return fd; }
+
+  /**
+   * @brief get the size of managed memory
+   *
+   * @return size_t size
+   */
+  size_t size() noexcept { return buf_size; }
+
+  /**
+   * @brief get Typed buffer from the memory
+   *
+   * @tparam T Type to specify the buffer. return is reinterpreted to T*
+   * @return T* Typed buffer, return nullptr if empty
+   */
+  template <typename T> T *typedBuffer() noexcept {
+    return reinterpret_cast<T *>(buf);
+  }
+
+  void *data() noexcept { return typedBuffer<void>(); }
+
+private:
+  int fd;           /**< fd to access the shared_memory  */
+  void *buf;        /**< buffer object when use_shared_memory */
+  size_t buf_size;  /**< buffer size */
+  bool allocate_fd; /**< option to choose to allocate an fd */
+};
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __MMAPED_MEMORY_H__ */
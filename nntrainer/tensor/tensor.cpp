@@ -27,12 +27,14 @@
 #include <fstream>
 #include <iomanip>
 #include <iterator>
+#include <mutex>
 #include <random>
 #include <regex>
 #include <sstream>
 #include <stdio.h>
 
 #include <blas_interface.h>
+#include <half_precision.h>
 #include <lazy_tensor.h>
 #include <nntrainer_error.h>
 #include <nntrainer_log.h>
@@ -83,14 +85,18 @@ struct Tensor::BroadcastInfo {
 };
 
 static auto rng = [] {
-  std::mt19937 rng;
+  Tensor::RandomState rng;
   rng.seed(getSeed());
   return rng;
 }();
 
+/** guards rng, which is used by the layers running concurrently */
+static std::mutex rng_mutex;
+
 Tensor::Tensor(const TensorDim &d, bool alloc_now, Tensor::Initializer init,
-               std::string name_) :
+               std::string name_, DataType type) :
   Tensor(name_) {
+  data_type = type;
   if (d.getDataLen() != 0) {
     dim = d;
     strides = d.computeStrides();
@@ -150,13 +156,16 @@ void Tensor::allocate() {
 
   if (src_tensor) {
     /// allocate data based on the source tensor
-    data = std::shared_ptr<float>(src_tensor->tensor()->data,
-                                  src_tensor->tensor()->data.get() +
-                                    src_tensor->offset());
+    /// offset is given in elements, which can be smaller than a float
+    char *src_data = (char *)src_tensor->tensor()->data.get();
+    data = std::shared_ptr<float>(
+      src_tensor->tensor()->data,
+      (float *)(src_data + src_tensor->offset() * getDataTypeSize()));
     /** as this memory is shared, do NOT initialize */
   } else {
     /// allocate new memory for the tensor data
-    data = std::shared_ptr<float>(new float[dim.getDataLen()],
+    size_t len = (bytes() + sizeof(float) - 1) / sizeof(float);
+    data = std::shared_ptr<float>(new float[len],
                                   std::default_delete<float[]>());
     initialize();
   }
@@ -203,7 +212,7 @@ Tensor Tensor::Map(std::shared_ptr<float> buf, unsigned int size,
 }
 
 bool Tensor::operator==(const Tensor &rhs) const {
-  if (this->dim != rhs.dim)
+  if (this->dim != rhs.dim || data_type != rhs.data_type)
     return false;
 
   size_t len = size();
@@ -220,6 +229,9 @@ bool Tensor::operator==(const Tensor &rhs) const {
   if (strides != rhs.strides)
     return false;
 
+  if (data_type != DataType::FP32)
+    return std::memcmp(getData(), rhs.getData(), bytes()) == 0;
+
   for (size_t i = 0; i < len; ++i) {
     /** not checking sign change is intentional to avoid float calculation
      * errors around 0 */
@@ -231,17 +243,45 @@ bool Tensor::operator==(const Tensor &rhs) const {
   return true;
 }
 
+void Tensor::throwIfNotFP32(const char *op) const {
+  NNTR_THROW_IF(data_type != DataType::FP32, std::invalid_argument)
+    << getName() << " is not a fp32 tensor, cannot " << op
+    << ", convert it to fp32 with copyData() first";
+}
+
+float Tensor::getHalfValue(size_t idx) const noexcept {
+  uint16_t bits = getData<uint16_t>()[idx];
+  return data_type == DataType::FP16 ? fp16ToFp32(bits) : bf16ToFp32(bits);
+}
+
+void Tensor::setHalfValue(size_t idx, float value) noexcept {
+  getData<uint16_t>()[idx] =
+    data_type == DataType::FP16 ? fp32ToFp16(value) : fp32ToBf16(value);
+}
+
 template <typename T> void Tensor::setDist(T dist) {
+  throwIfNotFP32("set the distribution");
   NNTR_THROW_IF(!contiguous, std::invalid_argument)
     << getName() << " Tensor is not contiguous, cannot set distribution";
 
   float *data = getData();
   unsigned int len = size();
+  std::lock_guard<std::mutex> lock(rng_mutex);
   for (unsigned int i = 0; i < len; ++i) {
     data[i] = dist(rng);
   }
 }
 
+Tensor::RandomState Tensor::getRandomState() {
+  std::lock_guard<std::mutex> lock(rng_mutex);
+  return rng;
+}
+
+void Tensor::setRandomState(const RandomState &state) {
+  std::lock_guard<std::mutex> lock(rng_mutex);
+  rng = state;
+}
+
 void Tensor::setRandNormal(float mean, float std) {
   setDist<std::normal_distribution<float>>(
     std::normal_distribution<float>(mean, std));
@@ -256,6 +296,13 @@ void Tensor::initialize() {
   if (empty() || !isAllocated())
     return;
 
+  if (getDataType() != DataType::FP32) {
+    /// values are generated in fp32 and converted to the storage type
+    Tensor values(dim, true, initializer);
+    copyData(values);
+    return;
+  }
+
   unsigned int fan_in, fan_out;
 
   /// @fixme: when unit is equal to one, this does not work, we need to rely on
@@ -325,6 +372,7 @@ Tensor::Tensor(
                                 std::default_delete<float[]>());
   contiguous = true;
   initializer = Initializer::NONE;
+  data_type = DataType::FP32;
 
   for (unsigned int i = 0; i < dim.batch(); ++i)
     for (unsigned int j = 0; j < dim.channel(); ++j)
@@ -353,6 +401,9 @@ Tensor &Tensor::multiply_strided(Tensor const &m, Tensor &output,
                                  const float beta) const {
   /** TODO: throw than create new dimenions */
   CREATE_IF_EMPTY_DIMS(output, dim);
+  throwIfNotFP32("multiply");
+  m.throwIfNotFP32("multiply");
+  output.throwIfNotFP32("multiply");
 
   if (size() != m.size() || size() != output.size())
     throw std::invalid_argument(
@@ -408,6 +459,9 @@ Tensor &Tensor::add_strided(Tensor const &m, Tensor &output,
                             const float beta) const {
   /** TODO: throw than create new dimenions */
   CREATE_IF_EMPTY_DIMS(output, dim);
+  throwIfNotFP32("add");
+  m.throwIfNotFP32("add");
+  output.throwIfNotFP32("add");
 
   if (size() != m.size() || size() != output.size())
     throw std::invalid_argument(
@@ -446,6 +500,7 @@ Tensor &Tensor::add_strided(Tensor const &m, Tensor &output,
 int Tensor::multiply_i(float const &value) {
   NNTR_THROW_IF(!contiguous, std::invalid_argument)
     << getName() << " is not contiguous, cannot multiply";
+  throwIfNotFP32("multiply");
 
   /// @note this is not depending on multiply_i as there is an optimized
   /// version for multiply_i
@@ -768,6 +823,9 @@ void Tensor::apply_broadcast(
     v_func,
   Tensor &output) const {
   CREATE_IF_EMPTY_DIMS(output, dim);
+  throwIfNotFP32("run an element-wise operation");
+  m.throwIfNotFP32("run an element-wise operation");
+  output.throwIfNotFP32("run an element-wise operation");
 
   /// shortcut to cover when dimension matches
   /// note that buffer_size, the last stride is only used in v_func but it
@@ -816,6 +874,7 @@ void Tensor::apply_broadcast_util(
 Tensor Tensor::sum_by_batch() const {
   NNTR_THROW_IF(!contiguous, std::invalid_argument)
     << getName() << " is not contiguous, cannot sum";
+  throwIfNotFP32("sum");
 
   Tensor ret(dim.batch(), 1, 1, 1);
   unsigned int feat_len = dim.getFeatureLen();
@@ -841,10 +900,12 @@ Tensor Tensor::sum(unsigned int axis, float alpha) const {
 }
 Tensor &Tensor::sum(unsigned int axis, Tensor &ret, float alpha,
                     float beta) const {
-  const float *data = getData();
-
   NNTR_THROW_IF(!contiguous, std::invalid_argument)
     << getName() << " is not contiguous, cannot sum";
+  throwIfNotFP32("sum");
+  ret.throwIfNotFP32("sum");
+
+  const float *data = getData();
 
   if (axis >= 4)
     throw std::out_of_range("Error: axis is invalid");
@@ -972,6 +1033,9 @@ Tensor &Tensor::dot(Tensor const &m, Tensor &result, bool trans, bool trans_m,
                     float beta) const {
   NNTR_THROW_IF(!contiguous, std::invalid_argument)
     << getName() << " is not contiguous. Cannot dot product.";
+  throwIfNotFP32("dot product");
+  m.throwIfNotFP32("dot product");
+  result.throwIfNotFP32("dot product");
 
   if (m.dim.rank() > 2) {
     throw exception::not_supported("Error: support only for rank of dot "
@@ -1077,6 +1141,8 @@ Tensor &Tensor::dot(Tensor const &m, Tensor &result, bool trans, bool trans_m,
 Tensor &Tensor::transpose(const std::string &direction, Tensor &out) const {
   NNTR_THROW_IF(!contiguous, std::invalid_argument)
     << getName() << " is not contiguous. Cannot transpose.";
+  throwIfNotFP32("transpose");
+  out.throwIfNotFP32("transpose");
 
   if (out.getData() == getData()) {
     Tensor tmp = clone();
@@ -1137,6 +1203,7 @@ Tensor Tensor::dropout_mask(float dropout) const {
 }
 
 void Tensor::dropout_mask(float dropout) {
+  throwIfNotFP32("make a dropout mask");
   setRandUniform(0.0, 1.0);
   float scale = 1.0 / (1 - dropout);
   float *data_ = getData();
@@ -1163,6 +1230,8 @@ Tensor Tensor::apply(std::function<float(float)> f) const {
 
 Tensor &Tensor::apply(std::function<float(float)> f, Tensor &output) const {
   CREATE_IF_EMPTY_DIMS(output, dim);
+  throwIfNotFP32("apply a function");
+  output.throwIfNotFP32("apply a function");
 
   if (dim != output.dim) {
     /// @todo add unittest
@@ -1208,6 +1277,13 @@ Tensor &Tensor::apply(std::function<Tensor &(Tensor, Tensor &)> f,
 }
 
 void Tensor::print(std::ostream &out) const {
+  if (data_type != DataType::FP32) {
+    Tensor values(dim, true);
+    values.copyData(*this);
+    values.print(out);
+    return;
+  }
+
   printInstance(out, this);
   const float *data = getData();
 
@@ -1253,10 +1329,18 @@ void Tensor::copy(const float *buf) noexcept {
     return;
   }
 
+  if (getDataType() != DataType::FP32) {
+    convertData(buf, DataType::FP32, getData(), getDataType(),
+                size());
+    return;
+  }
+
   scopy(size(), buf, 1, getData(), 1);
 }
 
 void Tensor::copy_with_stride(const Tensor &from) {
+  throwIfNotFP32("copy with stride");
+  from.throwIfNotFP32("copy with stride");
   if (from.size() != 0 && size() == from.size()) {
     reshape(from.getDim());
     for (unsigned int b = 0; b < from.batch(); ++b) {
@@ -1304,9 +1388,11 @@ void Tensor::copy(const Tensor &from) {
 
   if (from.size() != 0 && size() == from.size()) {
     reshape(from.getDim());
-    copy(from.getData());
+    copyData(from);
   } else {
-    Tensor t = Tensor(from.getDim(), from.getData());
+    Tensor t =
+      Tensor(from.getDim(), true, Initializer::NONE, "", from.getDataType());
+    t.copyData(from);
     swap(t, *this);
   }
 }
@@ -1319,6 +1405,19 @@ void Tensor::copyData(const Tensor &from) {
 
   if (size() != from.size())
     throw std::invalid_argument("Size of tensor to copy must match");
+
+  if (getDataType() != from.getDataType()) {
+    convertData(from.getData(), from.getDataType(), getData(), getDataType(),
+                size());
+    return;
+  }
+
+  if (getDataType() != DataType::FP32) {
+    if (from.getData() != getData())
+      std::memcpy(getData(), from.getData(), bytes());
+    return;
+  }
+
   copy(from.getData());
 }
 
@@ -1452,12 +1551,25 @@ void Tensor::setValue(float val) {
   NNTR_THROW_IF(!contiguous, std::invalid_argument)
     << getName() << " is not contiguous, cannot set value.";
 
+  if (getDataType() != DataType::FP32) {
+    uint16_t bits = getDataType() == DataType::FP16
+                      ? fp32ToFp16(val)
+                      : fp32ToBf16(val);
+    std::fill(getData<uint16_t>(), getData<uint16_t>() + size(), bits);
+    return;
+  }
+
   float *data = getData();
   std::fill(data, data + size(), val);
 }
 
 void Tensor::setZero() {
-  if (contiguous)
+  if (getDataType() != DataType::FP32) {
+    NNTR_THROW_IF(!contiguous, std::invalid_argument)
+      << getName() << " is not contiguous, cannot set zero.";
+    /// zero is all zero bits in both of the half precisions
+    std::memset(getData(), 0, bytes());
+  } else if (contiguous)
     sscal(size(), 0, getData(), 1);
   else
     apply_i([](float val) -> float { return 0; });
@@ -1466,6 +1578,7 @@ void Tensor::setZero() {
 std::vector<unsigned int> Tensor::argmax() const {
   NNTR_THROW_IF(!contiguous, std::invalid_argument)
     << getName() << " is not contiguous, cannot get argmax.";
+  throwIfNotFP32("get argmax");
 
   const float *data = getData();
   std::vector<unsigned int> result;
@@ -1486,6 +1599,7 @@ std::vector<unsigned int> Tensor::argmax() const {
 float Tensor::l2norm() const {
   NNTR_THROW_IF(!contiguous, std::invalid_argument)
     << getName() << " is not contiguous, cannot get l2norm.";
+  throwIfNotFP32("get l2norm");
 
   unsigned int len = size();
   const float *data = getData();
@@ -1496,6 +1610,7 @@ float Tensor::l2norm() const {
 float Tensor::max_abs() const {
   NNTR_THROW_IF(!contiguous, std::invalid_argument)
     << getName() << " is not contiguous, cannot get max_abs.";
+  throwIfNotFP32("get max_abs");
 
   unsigned int len = size();
   const float *data = getData();
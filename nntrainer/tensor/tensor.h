@@ -27,10 +27,13 @@
 #ifdef __cplusplus
 
 #include <array>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <random>
 #include <vector>
 
+#include <half_precision.h>
 #include <tensor_dim.h>
 
 #ifdef DEBUG
@@ -70,6 +73,16 @@ public:
     NONE            /** No initialization */
   };
 
+  /**
+   * @brief     Data type of the elements
+   */
+  using DataType = TensorDataType;
+
+  /**
+   * @brief     State of the random generator used to set the random values
+   */
+  using RandomState = std::mt19937;
+
   /**
    * @brief     Basic Constructor of Tensor
    */
@@ -80,7 +93,8 @@ public:
     initializer(Initializer::NONE),
     name(name_),
     data(nullptr),
-    src_tensor() {}
+    src_tensor(),
+    data_type(DataType::FP32) {}
 
   /**
    * @brief     Constructor of Tensor with dimension, possibly lazily
@@ -88,9 +102,11 @@ public:
    * @param alloc_now If the memory of the tensor must be allocated
    * @param init Initializer for the tensor
    * @param name Name of the tensor
+   * @param type Data type of the elements
    */
   Tensor(const TensorDim &d, bool alloc_now,
-         Initializer init = Initializer::NONE, std::string name = "");
+         Initializer init = Initializer::NONE, std::string name = "",
+         DataType type = DataType::FP32);
 
   /**
    * @brief     Constructor of Tensor with dimension/buf
@@ -215,6 +231,7 @@ public:
     std::swap(lhs.initializer, rhs.initializer);
     std::swap(lhs.data, rhs.data);
     std::swap(lhs.name, rhs.name);
+    std::swap(lhs.data_type, rhs.data_type);
   }
 
   /**
@@ -254,14 +271,18 @@ public:
    */
   float getValue(unsigned int batch, unsigned int c, unsigned int h,
                  unsigned int w) const noexcept {
-    return getData()[getIndex(batch, c, h, w)];
+    return getValue(getIndex(batch, c, h, w));
   }
 
   /**
    * @brief     return value at specific location
    * @param[in] idx location
    */
-  float getValue(unsigned int idx) const noexcept { return getData()[idx]; }
+  float getValue(unsigned int idx) const noexcept {
+    if (data_type != DataType::FP32)
+      return getHalfValue(idx);
+    return getData()[idx];
+  }
 
   /**
    * @brief Get the Value thinking that it is padded
@@ -745,6 +766,8 @@ public:
   /**
    * @brief     Anchor a starting point to defer following evaluation
    * @retval    LazyTensor class that can be used with run();
+   * @note      the LazyTensor shares the memory of this tensor, which is read
+   * at run()
    */
   LazyTensor chain() const;
 
@@ -846,7 +869,24 @@ public:
    * @brief     Get size of the data in bytes
    * @retval    size_t Size in bytes
    */
-  size_t bytes() const { return size() * sizeof(float); }
+  size_t bytes() const { return size() * getDataTypeSize(); }
+
+  /**
+   * @brief     Get the data type of the elements
+   * @note      operations other than copying, initializing and saving support
+   * fp32 tensors only and throw otherwise, use copyData() to convert a 16 bit
+   * tensor to fp32
+   * @retval    DataType data type
+   */
+  DataType getDataType() const { return data_type; }
+
+  /**
+   * @brief     Get the size of an element in bytes
+   * @retval    unsigned int size of an element
+   */
+  unsigned int getDataTypeSize() const {
+    return data_type == DataType::FP32 ? sizeof(float) : sizeof(uint16_t);
+  }
 
   /**
    * @brief     Set the element value
@@ -858,6 +898,10 @@ public:
    */
   void setValue(unsigned int batch, unsigned int c, unsigned int h,
                 unsigned int w, float value) noexcept {
+    if (data_type != DataType::FP32) {
+      setHalfValue(getIndex(batch, c, h, w), value);
+      return;
+    }
     data.get()[getIndex(batch, c, h, w)] = value;
   }
 
@@ -873,6 +917,10 @@ public:
   void addValue(unsigned int batch, unsigned int c, unsigned int h,
                 unsigned int w, float value, float beta) noexcept {
     auto const &idx = getIndex(batch, c, h, w);
+    if (data_type != DataType::FP32) {
+      setHalfValue(idx, value + getHalfValue(idx) * beta);
+      return;
+    }
     data.get()[idx] = value + data.get()[idx] * beta;
   }
 
@@ -914,6 +962,19 @@ public:
    */
   void setRandUniform(float min = -0.05f, float max = 0.05f);
 
+  /**
+   * @brief     Get the state of the random generator shared by the tensors
+   * @retval    RandomState copy of the current state
+   */
+  static RandomState getRandomState();
+
+  /**
+   * @brief     Set the state of the random generator shared by the tensors,
+   * which replays the random values drawn since the state was taken
+   * @param[in] state state to restore
+   */
+  static void setRandomState(const RandomState &state);
+
   /**
    * @brief     Initialize the memory of the given tensor
    */
@@ -933,12 +994,15 @@ public:
    * @param[in] from Tensor to be copied
    *
    * @note copy can reshape the tensor to match the shape
+   * @note the data is converted if the data types are different, and the data
+   * type of a non-empty tensor is kept
    */
   void copy(const Tensor &from);
 
   /**
    * @brief     Copy the Tensor
    * @param[in] from Tensor to be copied
+   * @note the data is converted if the data types are different
    */
   void copyData(const Tensor &from);
 
@@ -1229,6 +1293,8 @@ private:
    */
   std::shared_ptr<SrcSharedTensor> src_tensor;
 
+  DataType data_type; /**< data type of the elements */
+
   struct BroadcastInfo;
 
   /**
@@ -1273,6 +1339,31 @@ private:
    */
   BroadcastInfo computeBroadcastInfo(const Tensor &m) const;
 
+  /**
+   * @brief throw if the elements are not fp32, as the math on the tensor
+   * reads and writes the data as floats
+   *
+   * @param op name of the operation for the error message
+   * @throw std::invalid_argument if the data type is not fp32
+   */
+  void throwIfNotFP32(const char *op) const;
+
+  /**
+   * @brief Get the element of the 16 bit tensor converted to fp32
+   *
+   * @param idx index of the element
+   * @return float converted value
+   */
+  float getHalfValue(size_t idx) const noexcept;
+
+  /**
+   * @brief Set the element of the 16 bit tensor from fp32
+   *
+   * @param idx index of the element
+   * @param value value to convert and store
+   */
+  void setHalfValue(size_t idx, float value) noexcept;
+
   /**
    * @brief Set the Dist object
    *
@@ -14,15 +14,22 @@
  * @todo   check before allocate that finalize is done
  */
 
+#include <cstring>
+
 #include <memory_pool.h>
+#include <mmaped_memory.h>
+#include <nntrainer_error.h>
 #include <nntrainer_log.h>
 #include <tensor.h>
 #include <tensor_pool.h>
 #include <tensor_wrap_specs.h>
+#include <thread_pool.h>
 #include <util_func.h>
 
 namespace nntrainer {
 
+TensorPool::~TensorPool() { resetSwap(); }
+
 /**
  * @brief     Request tensor with the given spec
  *
@@ -33,9 +40,10 @@ namespace nntrainer {
 Tensor *TensorPool::request(const std::string &name, const TensorDim &dim,
                             const std::vector<unsigned int> &exec_order,
                             TensorLifespan lifespan,
-                            const Tensor::Initializer &init) {
+                            const Tensor::Initializer &init,
+                            Tensor::DataType type) {
   return registerRequestSpec(
-    {std::make_unique<Tensor>(dim, false, init, name),
+    {std::make_unique<Tensor>(dim, false, init, name, type),
      TensorPool::SourceDetails{0, lifespan, exec_order, {}}});
 }
 
@@ -90,7 +98,8 @@ Tensor *TensorPool::view(const std::string &name, const std::string &reference,
    * view index, not view to view reference in order to flatten depth */
   auto parent_idx = name_map.at(spec.tensor->getName());
   return registerRequestSpec(
-    {std::make_unique<Tensor>(dim, false, Tensor::Initializer::NONE, name),
+    {std::make_unique<Tensor>(dim, false, Tensor::Initializer::NONE, name,
+                              spec.tensor->getDataType()),
      TensorPool::DependentDetails{parent_idx, adjusted_offset}});
 }
 
@@ -103,34 +112,31 @@ Tensor *TensorPool::view(const std::string &name, const std::string &reference,
 void TensorPool::finalize(const MemoryPlanner &planner,
                           unsigned int start_order, unsigned int end_order) {
   mem_pool.clear();
-  unsigned int bytes_requested = 0;
-  for (auto &spec : pool) {
-    auto details = std::get_if<SourceDetails>(&spec.details);
-    if (!details || details->lifespan == TensorLifespan::UNMANAGED ||
-        details->exec_order.empty()) {
-      continue;
-    }
-    details->token = 0;
-
-    /** 1. create the validity ranges for the all the requested tensors */
-    unsigned int validity_start =
-      *std::min_element(details->exec_order.begin(), details->exec_order.end());
-    unsigned int validity_end =
-      *std::max_element(details->exec_order.begin(), details->exec_order.end());
-
+  swaps.clear();
+  swap_size = 0;
+  size_t bytes_requested = 0;
+
+  /**
+   * request memory valid over the given orders (inclusive), returns 0 if out
+   * of range
+   */
+  auto request_memory = [&](const RequestSpec &spec,
+                            unsigned int validity_start,
+                            unsigned int validity_end,
+                            bool long_term) -> unsigned int {
     /**
      * use lifespan to update the validity.
      * if the validity is long term, the tensor must stay valid for the
      * complete duration.
      */
-    if (isTensorLongTerm(details->lifespan)) {
+    if (long_term) {
       validity_start = start_order;
       validity_end = end_order;
     }
 
     /** 2. for each tensor request if it is in the provided range */
     if (validity_end < start_order || validity_start > end_order)
-      continue;
+      return 0;
     validity_start = std::max(validity_start, start_order);
     validity_end = std::min(validity_end, end_order);
 
@@ -138,20 +144,98 @@ void TensorPool::finalize(const MemoryPlanner &planner,
      * 3. requestMemory for all the tensors and set their tokens
      * @note +1 is to make the validity_end exlusive in the interval range
      */
-    details->token = mem_pool.requestMemory(spec.tensor->bytes(),
-                                            validity_start, validity_end + 1);
+    unsigned int token = mem_pool.requestMemory(
+      spec.tensor->bytes(), validity_start, validity_end + 1);
 #ifdef DEBUG
-    if (details->token == 0)
+    if (token == 0)
       throw std::runtime_error("Received invalid token from memory pool");
 #endif
 
     bytes_requested += spec.tensor->bytes();
+    return token;
+  };
+
+  /** 1. create the validity ranges for the all the requested tensors */
+  auto request_orders = [&](const RequestSpec &spec,
+                            std::vector<unsigned int>::const_iterator begin,
+                            std::vector<unsigned int>::const_iterator end,
+                            bool long_term) {
+    return request_memory(spec, *std::min_element(begin, end),
+                          *std::max_element(begin, end), long_term);
+  };
+
+  for (unsigned int idx = 0; idx < pool.size(); ++idx) {
+    auto &spec = pool[idx];
+    auto details = std::get_if<SourceDetails>(&spec.details);
+    if (!details || details->lifespan == TensorLifespan::UNMANAGED ||
+        details->exec_order.empty()) {
+      continue;
+    }
+    details->token = 0;
+    details->recompute_token = 0;
+
+    bool long_term = isTensorLongTerm(details->lifespan);
+    auto &orders = details->exec_order;
+
+    /**
+     * a recomputed tensor is not kept between the forwarding and the
+     * recomputation, so the orders of each are given their own memory
+     */
+    auto recompute_begin = orders.end();
+    if (details->recompute_from != 0 && !long_term) {
+      std::sort(orders.begin(), orders.end());
+      recompute_begin =
+        std::lower_bound(orders.begin(), orders.end(), details->recompute_from);
+    }
+
+    if (recompute_begin != orders.begin() && recompute_begin != orders.end()) {
+      details->token =
+        request_orders(spec, orders.begin(), recompute_begin, long_term);
+      details->recompute_token =
+        request_orders(spec, recompute_begin, orders.end(), long_term);
+      continue;
+    }
+
+    if (!swap_path.empty() && !long_term && details->recompute_from == 0) {
+      std::sort(orders.begin(), orders.end());
+
+      /** find the longest idle interval worth swapping out */
+      auto idle = orders.end();
+      unsigned int idle_length = swap_lookahead + 2;
+      for (auto iter = orders.begin(); iter + 1 < orders.end(); ++iter) {
+        if (*(iter + 1) - *iter > idle_length) {
+          idle_length = *(iter + 1) - *iter;
+          idle = iter;
+        }
+      }
+
+      /**
+       * a step runs up to two orders. The memory before the interval is kept
+       * one more order while it is written out from the next step, and the
+       * memory after the interval is taken one order before it is read in.
+       */
+      if (idle != orders.end() && orders.front() >= start_order &&
+          orders.back() <= end_order) {
+        unsigned int prefetch_order = *(idle + 1) - swap_lookahead;
+        details->token = request_memory(spec, orders.front(), *idle + 1, false);
+        unsigned int token =
+          request_memory(spec, prefetch_order - 1, orders.back(), false);
+        swaps.push_back({idx, token, *idle, prefetch_order, *(idle + 1),
+                         swap_size, SwapState::IN_MEMORY, {}});
+        swap_size += spec.tensor->bytes();
+        continue;
+      }
+    }
+
+    details->token =
+      request_orders(spec, orders.begin(), orders.end(), long_term);
   }
 
   /** 4. finalizeLayout for the memory pool. */
   if (bytes_requested > 0) {
     double efficiency = mem_pool.planLayout(planner);
-    ml_logd("Memory layout efficiency = %lf", efficiency);
+    ml_logd("Memory layout efficiency of %s = %lf", planner.getType().c_str(),
+            efficiency);
   }
 }
 
@@ -180,13 +264,123 @@ void TensorPool::allocate() {
     spec.tensor->setData(mem_pool.getMemory(details->token), true);
     syncDependents(spec);
   }
+
+  if (!swaps.empty()) {
+    swap_file = std::make_shared<MMapedMemory>(swap_path, swap_size);
+    swap_worker = std::make_shared<ThreadPool>(2);
+    ml_logd("swapping %zu tensors to %zu bytes of file", swaps.size(),
+            swap_size);
+  }
+}
+
+void TensorPool::recompute(const std::string &name,
+                           unsigned int recompute_order,
+                           unsigned int backward_start) {
+  auto &spec = getSourceSpec(name);
+  auto &details = std::get<SourceDetails>(spec.details);
+  if (details.lifespan == TensorLifespan::UNMANAGED)
+    return;
+
+  details.exec_order.push_back(recompute_order);
+  if (backward_start != 0)
+    details.recompute_from = backward_start;
+}
+
+void TensorPool::setRecomputing(bool val) {
+  if (!isAllocated())
+    return;
+
+  for (auto &spec : pool) {
+    auto details = std::get_if<SourceDetails>(&spec.details);
+    if (!details || details->token == 0 || details->recompute_token == 0) {
+      continue;
+    }
+
+    auto token = val ? details->recompute_token : details->token;
+    spec.tensor->setData(mem_pool.getMemory(token), true);
+    syncDependents(spec);
+  }
+}
+
+void TensorPool::setSwap(const std::string &path, unsigned int lookahead) {
+  swap_path = path;
+  swap_lookahead = lookahead;
+}
+
+void TensorPool::swap(unsigned int begin, unsigned int end) {
+  if (!swap_file)
+    return;
+
+  /** the copy runs on the swap worker, ready once the copy is done */
+  auto copy = [this](void *to, const void *from, size_t bytes) {
+    auto done = std::make_shared<std::promise<void>>();
+    swap_worker->submit([done, to, from, bytes] {
+      std::memcpy(to, from, bytes);
+      done->set_value();
+    });
+    return done->get_future();
+  };
+
+  char *file = swap_file->typedBuffer<char>();
+  for (auto &s : swaps) {
+    auto &spec = pool[s.spec_idx];
+    size_t bytes = spec.tensor->bytes();
+
+    if (s.state == SwapState::IN_MEMORY && s.out_order < begin) {
+      s.copying = copy(file + s.offset, spec.tensor->getData(), bytes);
+      s.state = SwapState::SWAPPING_OUT;
+    }
+
+    /** the memory is only kept an order after its last use */
+    if (s.state == SwapState::SWAPPING_OUT &&
+        (end > s.out_order + 1 || s.prefetch_order <= end)) {
+      s.copying.wait();
+      s.state = SwapState::SWAPPED_OUT;
+    }
+
+    if (s.state == SwapState::SWAPPED_OUT && s.prefetch_order <= end) {
+      void *data = mem_pool.getMemory(s.token);
+      s.copying = copy(data, file + s.offset, bytes);
+      spec.tensor->setData(data);
+      syncDependents(spec);
+      s.state = SwapState::SWAPPING_IN;
+    }
+
+    if (s.state == SwapState::SWAPPING_IN && s.in_order <= end) {
+      s.copying.wait();
+      s.state = SwapState::SWAPPED_IN;
+    }
+  }
+}
+
+void TensorPool::resetSwap() {
+  for (auto &s : swaps) {
+    if (s.state == SwapState::IN_MEMORY)
+      continue;
+
+    if (s.state == SwapState::SWAPPING_OUT ||
+        s.state == SwapState::SWAPPING_IN)
+      s.copying.wait();
+
+    auto &spec = pool[s.spec_idx];
+    auto &details = std::get<SourceDetails>(spec.details);
+    if (isAllocated()) {
+      spec.tensor->setData(mem_pool.getMemory(details.token));
+      syncDependents(spec);
+    }
+    s.state = SwapState::IN_MEMORY;
+  }
 }
 
 /**
  * @brief Deallocate memory for all the managed tensors
  */
 void TensorPool::deallocate() {
+  resetSwap();
+  swap_worker.reset();
+  swap_file.reset();
   mem_pool.deallocate();
+  mapping.reset();
 
   /** nullify the data pointers for the tensors */
   for (auto &spec : pool) {
@@ -194,6 +388,71 @@ void TensorPool::deallocate() {
   }
 }
 
+/**
+ * @brief Map the tensors to the memory of the tensors in the given pool
+ */
+void TensorPool::borrow(TensorPool &src) {
+  NNTR_THROW_IF(!src.isAllocated(), std::invalid_argument)
+    << "cannot borrow the memory of a pool which is not allocated";
+
+  for (auto &spec : pool) {
+    auto details = std::get_if<SourceDetails>(&spec.details);
+    if (!details || details->lifespan == TensorLifespan::UNMANAGED) {
+      continue;
+    }
+
+    const auto &name = spec.tensor->getName();
+    NNTR_THROW_IF(!src.tensorExist(name), std::invalid_argument)
+      << "tensor to borrow does not exist, name: " << name;
+
+    Tensor *from = src.getTensor(name);
+    NNTR_THROW_IF(from->getDim() != spec.tensor->getDim() ||
+                    from->getData() == nullptr,
+                  std::invalid_argument)
+      << "tensor to borrow is not compatible, name: " << name;
+
+    spec.tensor->setData(from->getData());
+    syncDependents(spec);
+  }
+}
+
+/**
+ * @brief Map the tensors to the given memory mapping
+ */
+void TensorPool::map(std::shared_ptr<MMapedMemory> src,
+                     const std::unordered_map<std::string, size_t> &offsets) {
+  /** validate everything first not to leave the pool half mapped */
+  for (auto &spec : pool) {
+    auto details = std::get_if<SourceDetails>(&spec.details);
+    if (!details || details->lifespan == TensorLifespan::UNMANAGED) {
+      continue;
+    }
+
+    const auto &name = spec.tensor->getName();
+    auto offset = offsets.find(name);
+    NNTR_THROW_IF(offset == offsets.end(), std::invalid_argument)
+      << "tensor to map does not exist, name: " << name;
+    NNTR_THROW_IF(offset->second + spec.tensor->bytes() > src->size(),
+                  std::invalid_argument)
+      << "tensor to map is out of the mapping, name: " << name;
+  }
+
+  deallocate();
+
+  char *base = src->typedBuffer<char>();
+  for (auto &spec : pool) {
+    auto details = std::get_if<SourceDetails>(&spec.details);
+    if (!details || details->lifespan == TensorLifespan::UNMANAGED) {
+      continue;
+    }
+
+    spec.tensor->setData(base + offsets.at(spec.tensor->getName()));
+    syncDependents(spec);
+  }
+
+  mapping = src;
+}
+
 const std::vector<unsigned int> &
 TensorPool::getExecutionOrder(const std::string &name) {
   return std::get<SourceDetails>(getSourceSpec(name).details).exec_order;
@@ -237,7 +496,9 @@ void TensorPool::syncDependents(const RequestSpec &spec) {
   for (auto &dep : dependents) {
     auto &dep_spec = pool.at(dep);
     auto offset = std::get<DependentDetails>(dep_spec.details).offset;
-    dep_spec.tensor->setData(spec.tensor->getData() + offset);
+    /// offset is given in elements, which can be smaller than a float
+    dep_spec.tensor->setData(reinterpret_cast<float *>(
+      spec.tensor->getData<char>() + offset * spec.tensor->getDataTypeSize()));
   }
 }
 
@@ -321,20 +582,13 @@ Tensor *TensorPool::requestOrExtend(const std::string &name,
 void TensorPool::reidentifySource(const std::string &dest,
                                   const std::string &new_src,
                                   unsigned int offset) {
-  /// @todo add test
   /// source tensor of dest tensor becomes a view of new_src
   auto &old_spec = getSourceSpec(dest);
   auto &old_details = std::get<SourceDetails>(old_spec.details);
 
-  /// 1. extend new_src with old src
+  /// 1. calcaulate base offset from the source of new_src
   auto &new_spec = getSourceSpec(new_src);
-  expandLifespan(new_spec, old_details.exec_order, old_details.lifespan);
-  auto &new_dependents = std::get<SourceDetails>(new_spec.details).dependents;
-  new_dependents.insert(new_dependents.end(), old_details.dependents.begin(),
-                        old_details.dependents.end());
-
-  /// 2. calcaulate base offset from the new_src
-  auto new_parent_idx = name_map.at(new_src);
+  auto new_parent_idx = name_map.at(new_spec.tensor->getName());
   unsigned base_offset = std::visit(
     [](const auto &s) {
       using T = std::decay_t<decltype(s)>;
@@ -345,9 +599,27 @@ void TensorPool::reidentifySource(const std::string &dest,
       }
       return 0u;
     },
-    pool[new_parent_idx].details);
+    pool[name_map.at(new_src)].details);
   base_offset += offset;
 
+  NNTR_THROW_IF(&old_spec == &new_spec, std::invalid_argument)
+    << "cannot reidentify the source of " << dest << " to itself";
+  NNTR_THROW_IF(new_spec.tensor->getDim().getDataLen() <
+                  base_offset + old_spec.tensor->getDim().getDataLen(),
+                std::invalid_argument)
+    << "source tensor size + offset > new source tensor size, source tensor "
+       "size: "
+    << old_spec.tensor->getDim().getDataLen() << " offset: " << base_offset
+    << " new source tensor: " << new_spec.tensor->getDim().getDataLen()
+    << " name: " << new_spec.tensor->getName();
+
+  /// 2. extend new_src with old src
+  expandLifespan(new_spec, old_details.exec_order, old_details.lifespan);
+  auto &new_dependents = std::get<SourceDetails>(new_spec.details).dependents;
+  new_dependents.insert(new_dependents.end(), old_details.dependents.begin(),
+                        old_details.dependents.end());
+  new_dependents.push_back(name_map.at(old_spec.tensor->getName()));
+
   /// 3. transform parent idx/offset of old src's dependents base on the offset
   for (auto &dep : old_details.dependents) {
     auto &dep_spec = pool.at(dep);
@@ -360,6 +632,33 @@ void TensorPool::reidentifySource(const std::string &dest,
   old_spec.details = DependentDetails{new_parent_idx, base_offset};
 }
 
+bool TensorPool::canReidentifySource(const std::string &dest,
+                                     const std::string &new_src) {
+  if (!tensorExist(dest) || !tensorExist(new_src))
+    return false;
+
+  auto &old_spec = getSourceSpec(dest);
+  auto &new_spec = getSourceSpec(new_src);
+  if (&old_spec == &new_spec)
+    return false;
+
+  auto &old_details = std::get<SourceDetails>(old_spec.details);
+  auto &new_details = std::get<SourceDetails>(new_spec.details);
+  if (old_details.lifespan == TensorLifespan::UNMANAGED ||
+      new_details.lifespan == TensorLifespan::UNMANAGED ||
+      old_details.recompute_from != 0 || new_details.recompute_from != 0)
+    return false;
+
+  /** other views of the source may see the memory next to dest otherwise */
+  auto &dest_spec = pool.at(name_map.at(dest));
+  if (auto dep_details = std::get_if<DependentDetails>(&dest_spec.details);
+      dep_details && dep_details->offset != 0)
+    return false;
+
+  return dest_spec.tensor->getDim().getDataLen() ==
+         old_spec.tensor->getDim().getDataLen();
+}
+
 bool TensorPool::tensorExist(const std::string &name) {
   /// @todo consider use a helper function to check, eg) something like
   /// getTensor()
@@ -17,7 +17,9 @@
 #ifdef __cplusplus
 
 #include <functional>
+#include <future>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -28,6 +30,9 @@
 
 namespace nntrainer {
 
+class MMapedMemory;
+class ThreadPool;
+
 /**
  * @class   TensorPool
  * @brief   tensor pool of nntrainer
@@ -38,12 +43,12 @@ public:
   /**
    * @brief     Constructor of TensorPool
    */
-  TensorPool() : mem_pool() {}
+  TensorPool() : mem_pool(), swap_lookahead(0), swap_size(0) {}
 
   /**
    * @brief     Destructor of TensorPool
    */
-  ~TensorPool() = default;
+  ~TensorPool();
 
   /**
    * @brief finalize the requested tensors
@@ -98,7 +103,30 @@ public:
    *
    * @return true if the tensors are allocated, else false
    */
-  bool isAllocated() const { return mem_pool.isAllocated(); }
+  bool isAllocated() const { return mem_pool.isAllocated() || mapping; }
+
+  /**
+   * @brief Map the tensors to the memory of the tensors with the same name in
+   * the given pool instead of allocating memory for them
+   *
+   * @param src allocated pool to borrow the memory from
+   * @throws std::invalid_argument if src is not allocated or a tensor is
+   * missing in src
+   * @note src must stay allocated while this pool uses the memory
+   */
+  void borrow(TensorPool &src);
+
+  /**
+   * @brief Map the tensors to the given memory mapping instead of allocating
+   * memory for them, which deallocates the pool first
+   *
+   * @param src memory mapping to use, kept by the pool until deallocated
+   * @param offsets byte offset in src of the data of each tensor by name
+   * @throws std::invalid_argument if a tensor is missing in offsets or its
+   * data is out of src
+   */
+  void map(std::shared_ptr<MMapedMemory> src,
+           const std::unordered_map<std::string, size_t> &offsets);
 
   /**
    * @brief Get the tensor of the given name
@@ -140,6 +168,7 @@ public:
    * @param exec_order The execution orders for this tensor.
    * @param lifespan Lifespan of this tensor.
    * @param init Initializer of the tensor.
+   * @param type Data type of the elements of the tensor.
    *
    * @return ptr to the created tensor
    *
@@ -150,7 +179,8 @@ public:
   Tensor *request(const std::string &name, const TensorDim &dim,
                   const std::vector<unsigned int> &exec_order,
                   TensorLifespan lifespan,
-                  const Tensor::Initializer &init = Tensor::Initializer::NONE);
+                  const Tensor::Initializer &init = Tensor::Initializer::NONE,
+                  Tensor::DataType type = Tensor::DataType::FP32);
 
   /**
    * @brief     Request tensor which is a view of already requested with the
@@ -164,7 +194,7 @@ public:
    * @param offset offset from the reference
    *
    * @return ptr to a tensor which is sharing the same data with
-   * reference.
+   * reference, which has the data type of the reference
    *
    * @note returns a view tensor which will be filled when the source tensor is
    * allocated.
@@ -218,10 +248,11 @@ public:
    * @note if @a dest tensor is a view of another tensor, the old source tensor
    * of the view will become a view of @a new_src.
    *
+   * @note if @a new_src is a view, the offset is counted from the view.
+   *
    * @throws std::invalid_argument 1. if the data size required from the
-   * original source tensor is bigger than the new_src + offset. 2. if new_src
-   * is a view. Second restriction can be removed, if this is considered as a
-   * safe behavior.
+   * original source tensor is bigger than the new_src + offset. 2. if dest and
+   * new_src already share the same source.
    *
    * @param dest identifier for the dest tensor
    * @param new_src identifier for the new source tensor
@@ -230,6 +261,71 @@ public:
   void reidentifySource(const std::string &dest, const std::string &new_src,
                         unsigned int offset);
 
+  /**
+   * @brief check if the source of @a dest can be reidentified to @a new_src
+   * without changing the memory seen by any other tensor
+   * @details @a dest must cover its whole managed source tensor, and the
+   * source must not already be shared with @a new_src.
+   *
+   * @param dest identifier for the dest tensor
+   * @param new_src identifier for the new source tensor
+   * @return true if reidentifySource(dest, new_src, offset) is safe
+   */
+  bool canReidentifySource(const std::string &dest, const std::string &new_src);
+
+  /**
+   * @brief use the tensor while recomputing the forwarding in the backwarding
+   *
+   * @param name name of the tensor (or view)
+   * @param recompute_order execution order of the recomputation
+   * @param backward_start first execution order of the backwarding if the
+   * tensor is computed again while recomputing, 0 if it is only read
+   * @details a tensor computed again gets a separate memory for its execution
+   * orders from backward_start, so that it is not kept between the forwarding
+   * and the recomputation. setRecomputing() switches between the memories.
+   */
+  void recompute(const std::string &name, unsigned int recompute_order,
+                 unsigned int backward_start = 0);
+
+  /**
+   * @brief switch the recomputed tensors to the memory for the recomputation
+   * or back to the memory for the forwarding
+   *
+   * @param val true to switch to the memory for the recomputation
+   */
+  void setRecomputing(bool val);
+
+  /**
+   * @brief set the tensors idle for long between their execution orders to be
+   * swapped out to a file, applied from the next finalize
+   *
+   * @param path directory to create the swap file in, empty to disable
+   * @param lookahead number of the execution orders to start swapping in a
+   * tensor ahead of its use
+   * @details a tensor is swapped out after its last use before the longest
+   * idle interval of its execution orders, and swapped in before its first
+   * use after the interval. Both copies run on a single worker thread kept
+   * while the pool is allocated. Each side gets its own memory
+   * token, so the memory can be reused by the other tensors while it is idle.
+   */
+  void setSwap(const std::string &path, unsigned int lookahead);
+
+  /**
+   * @brief swap the tensors for the execution of the given orders
+   *
+   * @param begin first execution order to run (inclusive)
+   * @param end last execution order to run (inclusive), at most begin + 1
+   * @note this must be called before the execution of each step in the
+   * increasing order of the execution orders
+   */
+  void swap(unsigned int begin, unsigned int end);
+
+  /**
+   * @brief bring all the swapped tensors back to their memory for the
+   * execution orders before their idle interval, to start the next iteration
+   */
+  void resetSwap();
+
 private:
   /**
    * @brief Source tensor detailed specification
@@ -241,6 +337,9 @@ private:
     std::vector<unsigned int> exec_order; /**< exec order */
     std::vector<unsigned int>
       dependents; /**< list of dependents to the source */
+    unsigned int recompute_from = 0; /**< exec orders from this are served by
+                                        recompute_token, 0 if not recomputed */
+    unsigned int recompute_token = 0; /**< memory token while recomputing */
   };
 
   /**
@@ -252,6 +351,33 @@ private:
     unsigned int offset;     /**< elementwise offset */
   };
 
+  /**
+   * @brief State of a swapped tensor in an iteration
+   *
+   */
+  enum class SwapState {
+    IN_MEMORY,    /**< in the memory before the idle interval */
+    SWAPPING_OUT, /**< being written to the swap file */
+    SWAPPED_OUT,  /**< written to the swap file */
+    SWAPPING_IN,  /**< being read to the memory after the idle interval */
+    SWAPPED_IN,   /**< in the memory after the idle interval */
+  };
+
+  /**
+   * @brief Swap detailed specification of a source tensor
+   *
+   */
+  struct SwapDetails {
+    unsigned int spec_idx;       /**< index of the source tensor */
+    unsigned int token;          /**< memory token after the idle interval */
+    unsigned int out_order;      /**< last order before the idle interval */
+    unsigned int prefetch_order; /**< order to start swapping in */
+    unsigned int in_order;       /**< first order after the idle interval */
+    size_t offset;               /**< offset in the swap file */
+    SwapState state;             /**< state in the current iteration */
+    std::future<void> copying;   /**< pending copy to or from the file */
+  };
+
   /**
    * @brief Spec for storing each request of tensor from tensor pool
    * @todo move tensor initialization from tensor class to RequestSpec
@@ -327,6 +453,15 @@ private:
     name_map;          /**< indexing of requested tensors */
   MemoryPool mem_pool; /**< memory pool for the tensors */
 
+  std::string swap_path;          /**< directory of the swap file */
+  unsigned int swap_lookahead;    /**< orders to swap in ahead of the use */
+  std::vector<SwapDetails> swaps; /**< tensors to be swapped */
+  size_t swap_size;               /**< bytes of the swap file */
+  std::shared_ptr<MMapedMemory> swap_file; /**< swap file, while allocated */
+  std::shared_ptr<ThreadPool>
+    swap_worker; /**< thread copying the tensors to and from the swap file */
+  std::shared_ptr<MMapedMemory> mapping; /**< mapped memory of the tensors */
+
   /**
    * @brief     Check if the lifespan leads to long term valitidy
    *
@@ -11,6 +11,8 @@
  *
  */
 
+#include <algorithm>
+
 #include <util_func.h>
 #include <var_grad.h>
 
@@ -56,4 +58,51 @@ void Var_Grad::initializeGradient(const Tensor &preallocated) {
   /** intentionally not initialized tensor memory for shared tensors */
 }
 
+void Var_Grad::setSparseGradient(const std::vector<unsigned int> &rows,
+                                 const Tensor &values) {
+  unsigned int width = var->width();
+  unsigned int num_rows = var->size() / width;
+
+  NNTR_THROW_IF(!values.empty() && values.width() != width,
+                std::invalid_argument)
+    << "sparse gradient width " << values.width()
+    << " does not match the variable width " << width << " of " << getName();
+  NNTR_THROW_IF(values.size() != rows.size() * width, std::invalid_argument)
+    << "sparse gradient of " << getName() << " has " << rows.size()
+    << " rows but " << values.size() << " values";
+
+  for (auto row : rows) {
+    NNTR_THROW_IF(row >= num_rows, std::out_of_range)
+      << "sparse gradient row " << row << " is out of the range of "
+      << getName() << " which has " << num_rows << " rows";
+  }
+
+  sparse_grad = true;
+  sparse_grad_rows.assign(rows.begin(), rows.end());
+  sparse_grad_values = values;
+}
+
+void Var_Grad::densifyGradient() {
+  if (!sparse_grad)
+    return;
+
+  /** the values can be a view of the gradient which is cleared below */
+  Tensor values = sparse_grad_values.clone();
+  unsigned int width = var->width();
+  grad->setZero();
+  for (unsigned int i = 0; i < sparse_grad_rows.size(); ++i) {
+    const float *src = values.getAddress(i * width);
+    float *dst = grad->getAddress(sparse_grad_rows[i] * width);
+    std::copy(src, src + width, dst);
+  }
+
+  clearSparseGradient();
+}
+
+void Var_Grad::clearSparseGradient() {
+  sparse_grad = false;
+  sparse_grad_rows.clear();
+  sparse_grad_values = Tensor();
+}
+
 } // namespace nntrainer
@@ -15,6 +15,7 @@
 #define __VAR_GRAD_H__
 
 #include <tuple>
+#include <vector>
 
 #include <tensor.h>
 #include <tensor_wrap_specs.h>
@@ -291,6 +292,57 @@ public:
    */
   bool isGradientLastAccess() const { return is_last_access_gradient; }
 
+  /**
+   * @brief Set the gradient as a sparse gradient over the rows of the variable
+   * @details A row is the last dimension of the variable. Only the given rows
+   * have a gradient, and the rest is regarded as zero. The dense gradient
+   * tensor is not updated and must not be used while the sparse gradient is
+   * set.
+   *
+   * @param rows unique indices of the rows which have a gradient
+   * @param values gradient of the rows of [1, 1, rows.size(), width], which
+   * can be a view of the dense gradient tensor
+   */
+  void setSparseGradient(const std::vector<unsigned int> &rows,
+                         const Tensor &values);
+
+  /**
+   * @brief Check if the gradient is given as a sparse gradient
+   *
+   * @return true if the sparse gradient is set, else false
+   */
+  bool hasSparseGradient() const { return sparse_grad; }
+
+  /**
+   * @brief Get the rows of the sparse gradient
+   *
+   * @return const std::vector<unsigned int>& indices of the rows
+   */
+  const std::vector<unsigned int> &getSparseGradientRows() const {
+    return sparse_grad_rows;
+  }
+
+  /**
+   * @brief Get the values of the sparse gradient
+   *
+   * @return Tensor& gradient of the rows, row i of this is the gradient of
+   * the row getSparseGradientRows()[i] of the variable
+   */
+  Tensor &getSparseGradientValues() { return sparse_grad_values; }
+
+  /**
+   * @brief Write the sparse gradient to the dense gradient tensor, and clear
+   * the sparse gradient
+   * @note this is O(size of the variable), and meant for the users of the
+   * gradient which do not support the sparse gradient
+   */
+  void densifyGradient();
+
+  /**
+   * @brief Clear the sparse gradient, once it has been applied
+   */
+  void clearSparseGradient();
+
   inline static const std::string grad_suffix = ":grad";
 
 protected:
@@ -303,6 +355,10 @@ protected:
 
   std::shared_ptr<Tensor> var;  /**< variable to be updated and used */
   std::shared_ptr<Tensor> grad; /**< gradient for the variable */
+
+  bool sparse_grad = false; /**< if the gradient is given as sparse rows */
+  std::vector<unsigned int> sparse_grad_rows; /**< rows of sparse gradient */
+  Tensor sparse_grad_values; /**< values of the rows of sparse gradient */
 };
 
 } // namespace nntrainer
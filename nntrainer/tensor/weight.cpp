@@ -11,6 +11,7 @@
  *
  */
 
+#include <blas_interface.h>
 #include <util_func.h>
 #include <weight.h>
 
@@ -30,4 +31,34 @@ Weight::Weight(const TensorDim &dim, const Tensor::Initializer init,
     throw std::invalid_argument("Weight regularizer unknown");
 }
 
+void Weight::calcRegularizationGradient() {
+  if (!isWeightRegularizerL2Norm())
+    return;
+
+  if (!hasSparseGradient()) {
+    grad->add_i(*var.get(), regularizer_constant);
+    return;
+  }
+
+  unsigned int width = var->width();
+  for (unsigned int i = 0; i < sparse_grad_rows.size(); ++i) {
+    saxpy(width, regularizer_constant,
+          var->getAddress(sparse_grad_rows[i] * width), 1,
+          sparse_grad_values.getAddress(i * width), 1);
+  }
+}
+
+void Weight::applyGradient(double lr) {
+  if (!hasSparseGradient()) {
+    var->add_i(*grad.get(), -lr);
+    return;
+  }
+
+  unsigned int width = var->width();
+  for (unsigned int i = 0; i < sparse_grad_rows.size(); ++i) {
+    saxpy(width, -lr, sparse_grad_values.getAddress(i * width), 1,
+          var->getAddress(sparse_grad_rows[i] * width), 1);
+  }
+}
+
 } // namespace nntrainer
@@ -184,6 +184,12 @@ public:
     opt_vars = tensors;
   }
 
+  /**
+   * @brief Get the number of the optimizer variables
+   * @retval number of the optimizer variables
+   */
+  unsigned int getNumOptVariable() const { return opt_vars.size(); }
+
   /**
    * @brief Get optimizer variable reference
    * @param idx Index of the optimizer variable to get
@@ -211,16 +217,15 @@ public:
 
   /**
    * @brief     Calculate gradient from the regularizaiton of the weight
+   * @note      with the sparse gradient, only the rows having the gradient are
+   * regularized
    */
-  void calcRegularizationGradient() {
-    if (isWeightRegularizerL2Norm())
-      grad->add_i(*var.get(), regularizer_constant);
-  }
+  void calcRegularizationGradient();
 
   /**
    * @brief     Apply the gradient to the weight
    */
-  void applyGradient(double lr) { var->add_i(*grad.get(), -lr); }
+  void applyGradient(double lr);
 
 private:
   WeightRegularizer regularizer;  /**< regularizer for this variable */
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   thread_pool.cpp
+ * @date   17 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  This is a pool of threads running a set of tasks at a time
+ *
+ */
+
+#include <thread_pool.h>
+
+namespace nntrainer {
+
+ThreadPool::ThreadPool(unsigned int num_threads) :
+  num_pending(0),
+  stop(false) {
+  for (unsigned int i = 1; i < num_threads; ++i)
+    workers.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  task_cv.notify_all();
+
+  for (auto &worker : workers)
+    worker.join();
+}
+
+void ThreadPool::run(unsigned int num_tasks,
+                     const std::function<void(unsigned int)> &task) {
+  /** nothing to share, so it is run right away */
+  if (num_tasks == 1 || workers.empty()) {
+    for (unsigned int i = 0; i < num_tasks; ++i)
+      task(i);
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  for (unsigned int i = 0; i < num_tasks; ++i)
+    tasks.emplace_back([&task, i] { task(i); });
+  num_pending += num_tasks;
+  task_cv.notify_all();
+
+  runTasks(lock);
+  lock.unlock();
+  wait();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+  if (workers.empty()) {
+    task();
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    tasks.push_back(std::move(task));
+    num_pending++;
+  }
+  task_cv.notify_one();
+}
+
+void ThreadPool::wait() {
+  std::unique_lock<std::mutex> lock(mutex);
+  done_cv.wait(lock, [this] { return num_pending == 0; });
+
+  if (error) {
+    auto e = error;
+    error = nullptr;
+    std::rethrow_exception(e);
+  }
+}
+
+void ThreadPool::runTasks(std::unique_lock<std::mutex> &lock) {
+  while (!tasks.empty()) {
+    auto task = std::move(tasks.front());
+    tasks.pop_front();
+
+    lock.unlock();
+    std::exception_ptr e;
+    try {
+      task();
+    } catch (...) {
+      e = std::current_exception();
+    }
+    lock.lock();
+
+    if (e && !error)
+      error = e;
+    if (--num_pending == 0)
+      done_cv.notify_all();
+  }
+}
+
+void ThreadPool::work() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    task_cv.wait(lock, [this] { return stop || !tasks.empty(); });
+    /** stopped with nothing left to run */
+    if (tasks.empty())
+      return;
+    runTasks(lock);
+  }
+}
+
+} // namespace nntrainer
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: Apache-2.0
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file   thread_pool.h
+ * @date   17 October 2026
+ * @see    https://github.com/nnstreamer/nntrainer
+ * @bug    No known bugs except for NYI items
+ * @brief  This is a pool of threads running a set of tasks at a time
+ *
+ */
+
+#ifndef __THREAD_POOL_H__
+#define __THREAD_POOL_H__
+#ifdef __cplusplus
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nntrainer {
+
+/**
+ * @class   ThreadPool
+ * @brief   Pool of threads kept alive across the runs. A run hands the tasks
+ * over to the workers and to the calling thread, and returns once all the
+ * tasks are done. A task can also be submitted to run in background until
+ * the pool is waited for.
+ */
+class ThreadPool {
+public:
+  /**
+   * @brief Construct a new Thread Pool object
+   *
+   * @param num_threads number of threads running the tasks, including the
+   * calling thread
+   */
+  ThreadPool(unsigned int num_threads);
+
+  /**
+   * @brief Destroy the Thread Pool object, joining the workers
+   */
+  ~ThreadPool();
+
+  /**
+   * @brief Deleted copy constructor
+   */
+  ThreadPool(const ThreadPool &) = delete;
+
+  /**
+   * @brief Deleted copy assignment operator
+   */
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * @brief Run the tasks, returning when all of them and the tasks submitted
+   * before are done
+   *
+   * @param num_tasks number of the tasks
+   * @param task task to run, called with the index of the task
+   * @throw the first exception thrown by a task, after all the tasks are done
+   * @note this must not be called from the tasks or from multiple threads
+   */
+  void run(unsigned int num_tasks,
+           const std::function<void(unsigned int)> &task);
+
+  /**
+   * @brief Submit a task to run on a worker, it is run right away if there is
+   * no worker
+   *
+   * @param task task to run
+   * @note this can be called from multiple threads
+   */
+  void submit(std::function<void()> task);
+
+  /**
+   * @brief Wait for all the tasks submitted to be done
+   *
+   * @throw the first exception thrown by a task since the last wait
+   */
+  void wait();
+
+  /**
+   * @brief Get the number of threads running the tasks
+   *
+   * @return unsigned int number of threads including the calling thread
+   */
+  unsigned int getNumThreads() const { return workers.size() + 1; }
+
+private:
+  /**
+   * @brief Run the queued tasks until there is none left
+   *
+   * @param lock lock of the mutex, held on entry and on return
+   */
+  void runTasks(std::unique_lock<std::mutex> &lock);
+
+  /**
+   * @brief Loop of a worker waiting for the tasks
+   */
+  void work();
+
+  std::vector<std::thread> workers;   /**< threads other than the caller */
+  std::mutex mutex;                   /**< guards the members below */
+  std::condition_variable task_cv;    /**< notified on new tasks and stop */
+  std::condition_variable done_cv;    /**< notified when the tasks are done */
+  std::deque<std::function<void()>> tasks; /**< tasks waiting for a thread */
+  unsigned int num_pending;           /**< number of the tasks not done yet */
+  std::exception_ptr error;           /**< first error thrown by a task */
+  bool stop;                          /**< true when the pool is destroyed */
+};
+
+} // namespace nntrainer
+
+#endif /* __cplusplus */
+#endif /* __THREAD_POOL_H__ */
@@ -11,7 +11,14 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <thread>
 
 #include <dataset.h>
 #include <ini_wrapper.h>
@@ -20,6 +27,7 @@
 #include <model.h>
 #include <nntrainer_test_util.h>
 #include <optimizer.h>
+#include <tensor.h>
 
 static const std::string getTestResPath(const std::string &file) {
   return getResPath(file, {"test"});
@@ -428,6 +436,997 @@ TEST(nntrainer_ccapi, save_ini_p) {
   model->save(saved_ini_name, ml::train::ModelFormat::MODEL_FORMAT_INI);
 }
 
+/**
+ * @brief create a small model to run the inference
+ */
+static std::unique_ptr<ml::train::Model> createInferenceModel() {
+  auto model = ml::train::createModel(ml::train::ModelType::NEURAL_NET,
+                                      {"loss=mse", "batch_size=1"});
+  model->addLayer(ml::train::layer::Input({"name=in", "input_shape=1:1:4"}));
+  model->addLayer(ml::train::layer::FullyConnected(
+    {"name=fc", "unit=3", "activation=sigmoid", "input_layers=in"}));
+  model->setOptimizer(ml::train::optimizer::SGD({"learning_rate=0.1"}));
+  return model;
+}
+
+/**
+ * @brief Inference session keeps the output while the batch size is unchanged
+ */
+TEST(nntrainer_ccapi, inference_session_p) {
+  auto model = createInferenceModel();
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+  EXPECT_EQ(model->startInferenceSession(), ML_ERROR_NONE);
+
+  std::vector<float> data = {1, 2, 3, 4, 4, 3, 2, 1};
+  std::vector<float *> in = {data.data()}, label;
+
+  auto out = model->inference(1, in, label);
+  ASSERT_EQ(out.size(), 1u);
+  std::vector<float> expected(out[0], out[0] + 3);
+
+  /** same memory is reused for the same batch size */
+  auto out_again = model->inference(1, in, label);
+  EXPECT_EQ(out_again[0], out[0]);
+  for (unsigned int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(out_again[0][i], expected[i]);
+
+  /** memory is re-planned when the batch size changes */
+  auto out_batch = model->inference(2, in, label);
+  for (unsigned int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(out_batch[0][i], expected[i]);
+
+  out = model->inference(1, in, label);
+  for (unsigned int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(out[0][i], expected[i]);
+
+  EXPECT_EQ(model->stopInferenceSession(), ML_ERROR_NONE);
+}
+
+/**
+ * @brief Inference session can't be started before initialize
+ */
+TEST(nntrainer_ccapi, inference_session_n) {
+  auto model = createInferenceModel();
+  EXPECT_EQ(model->startInferenceSession(), ML_ERROR_INVALID_PARAMETER);
+}
+
+/**
+ * @brief Inference contexts run concurrently with the weights of the model
+ */
+TEST(nntrainer_ccapi, inference_context_concurrent_p) {
+  auto model = createInferenceModel();
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+
+  constexpr unsigned int num_contexts = 4;
+  std::vector<std::vector<float>> data(num_contexts);
+  std::vector<std::vector<float>> expected(num_contexts);
+  for (unsigned int i = 0; i < num_contexts; ++i) {
+    data[i] = {1.0f * i, 2, 3, -1.0f * i};
+    std::vector<float *> in = {data[i].data()}, label;
+    auto out = model->inference(1, in, label);
+    expected[i] = std::vector<float>(out[0], out[0] + 3);
+  }
+
+  std::vector<std::unique_ptr<ml::train::Model>> contexts;
+  for (unsigned int i = 0; i < num_contexts; ++i) {
+    contexts.push_back(model->createInferenceContext());
+  }
+
+  std::vector<std::vector<float>> result(num_contexts);
+  std::vector<std::thread> workers;
+  for (unsigned int i = 0; i < num_contexts; ++i) {
+    workers.emplace_back([&, i] {
+      std::vector<float *> in = {data[i].data()}, label;
+      for (unsigned int iter = 0; iter < 50; ++iter) {
+        auto out = contexts[i]->inference(1, in, label);
+        result[i] = std::vector<float>(out[0], out[0] + 3);
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  for (unsigned int i = 0; i < num_contexts; ++i) {
+    for (unsigned int j = 0; j < 3; ++j) {
+      EXPECT_FLOAT_EQ(result[i][j], expected[i][j]);
+    }
+  }
+}
+
+/**
+ * @brief Inference context can't be created before initialize
+ */
+TEST(nntrainer_ccapi, inference_context_n) {
+  auto model = createInferenceModel();
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_THROW(model->createInferenceContext(), std::invalid_argument);
+}
+
+/**
+ * @brief create a model of convolution and fully connected layers to quantize
+ */
+static std::unique_ptr<ml::train::Model> createQuantizableModel() {
+  auto model = ml::train::createModel(ml::train::ModelType::NEURAL_NET,
+                                      {"loss=mse", "batch_size=2"});
+  model->addLayer(ml::train::layer::Input({"name=in", "input_shape=2:6:6"}));
+  model->addLayer(ml::train::layer::Convolution2D(
+    {"name=conv", "filters=4", "kernel_size=3,3", "padding=same",
+     "activation=relu", "input_layers=in"}));
+  model->addLayer(ml::train::layer::Flatten({"name=flat"}));
+  model->addLayer(ml::train::layer::FullyConnected({"name=fc", "unit=3"}));
+  model->setOptimizer(ml::train::optimizer::SGD({"learning_rate=0.1"}));
+  return model;
+}
+
+/**
+ * @brief create a dataset of samples uniformly distributed in [-1, 1]
+ */
+static std::shared_ptr<ml::train::Dataset>
+createCalibrationSet(unsigned int num_samples) {
+  auto count = std::make_shared<unsigned int>(0);
+  auto rng = std::make_shared<std::mt19937>(0);
+  auto cb = [count, rng, num_samples](float **input, float **label, bool *last,
+                                      void *user_data) {
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    std::generate(input[0], input[0] + 2 * 6 * 6, [&] { return dist(*rng); });
+    std::fill(label[0], label[0] + 3, 0.0f);
+    *last = ++(*count) == num_samples;
+    if (*last)
+      *count = 0;
+    return ML_ERROR_NONE;
+  };
+  return ml::train::createDataset(ml::train::DatasetType::GENERATOR, cb);
+}
+
+/**
+ * @brief Quantized inference stays close to the fp32 inference
+ */
+TEST(nntrainer_ccapi, quantize_p) {
+  auto model = createQuantizableModel();
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> data(2 * 2 * 6 * 6);
+  std::generate(data.begin(), data.end(), [&] { return dist(rng); });
+  std::vector<float *> in = {data.data()}, label;
+
+  auto out = model->inference(2, in, label);
+  std::vector<float> expected(out[0], out[0] + 6);
+
+  EXPECT_EQ(model->quantize(createCalibrationSet(8)), ML_ERROR_NONE);
+
+  out = model->inference(2, in, label);
+  float range = 0.0f;
+  for (auto v : expected)
+    range = std::max(range, std::abs(v));
+  for (unsigned int i = 0; i < 6; ++i)
+    EXPECT_NEAR(out[0][i], expected[i], range * 0.05f);
+}
+
+/**
+ * @brief Quantized model is saved with the int8 weights and can not be trained
+ */
+TEST(nntrainer_ccapi, quantize_save_load_p) {
+  const std::string weights = "quantize_save_load_p.bin";
+  auto model = createQuantizableModel();
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+  EXPECT_EQ(model->quantize(createCalibrationSet(8)), ML_ERROR_NONE);
+
+  std::vector<float> data(2 * 2 * 6 * 6, 0.5f);
+  std::vector<float *> in = {data.data()}, label;
+  auto out = model->inference(2, in, label);
+  std::vector<float> expected(out[0], out[0] + 6);
+  EXPECT_NO_THROW(
+    model->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN));
+
+  auto loaded = createQuantizableModel();
+  std::shared_ptr<ml::train::Layer> layer;
+  for (auto name : {"conv", "fc"}) {
+    EXPECT_EQ(loaded->getLayer(name, &layer), ML_ERROR_NONE);
+    layer->setProperty({"quantized=true"});
+  }
+  EXPECT_EQ(loaded->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(loaded->initialize(), ML_ERROR_NONE);
+  EXPECT_NO_THROW(
+    loaded->load(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN));
+
+  out = loaded->inference(2, in, label);
+  for (unsigned int i = 0; i < 6; ++i)
+    EXPECT_FLOAT_EQ(out[0][i], expected[i]);
+  std::remove(weights.c_str());
+}
+
+/**
+ * @brief Quantized layer only runs the inference
+ */
+TEST(nntrainer_ccapi, quantize_train_n) {
+  auto model = createQuantizableModel();
+  EXPECT_NO_THROW(model->setProperty({"epochs=1"}));
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+  EXPECT_EQ(model->quantize(createCalibrationSet(8)), ML_ERROR_NONE);
+
+  EXPECT_EQ(model->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                              createCalibrationSet(4)),
+            ML_ERROR_NONE);
+  EXPECT_THROW(model->train(), std::invalid_argument);
+}
+
+/**
+ * @brief Quantization needs an initialized model and a calibration dataset
+ */
+TEST(nntrainer_ccapi, quantize_n) {
+  auto model = createQuantizableModel();
+  EXPECT_EQ(model->quantize(createCalibrationSet(2)),
+            ML_ERROR_INVALID_PARAMETER);
+
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+  EXPECT_EQ(model->quantize(nullptr), ML_ERROR_INVALID_PARAMETER);
+}
+
+/**
+ * @brief Model summary reports the efficiency of the selected memory planner
+ */
+TEST(nntrainer_ccapi, memory_planner_p) {
+  auto model = createQuantizableModel();
+  EXPECT_NO_THROW(model->setProperty({"memory_planner=best_fit_planner"}));
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+
+  std::vector<float> data(2 * 2 * 6 * 6, 0.5f);
+  std::vector<float *> in = {data.data()}, label;
+  EXPECT_NO_THROW(model->inference(2, in, label));
+
+  std::stringstream ss;
+  EXPECT_NO_THROW(model->summarize(ss, ML_TRAIN_SUMMARY_MODEL));
+  EXPECT_NE(ss.str().find("memory planner: best_fit_planner"),
+            std::string::npos);
+  EXPECT_NE(ss.str().find("efficiency"), std::string::npos);
+}
+
+/**
+ * @brief Unknown memory planner is not allowed
+ */
+TEST(nntrainer_ccapi, memory_planner_n) {
+  auto model = createQuantizableModel();
+  EXPECT_THROW(model->setProperty({"memory_planner=first_fit"}),
+               std::invalid_argument);
+}
+
+/**
+ * @brief create a model of a fully connected layer with the given loss scale
+ */
+static std::unique_ptr<ml::train::Model>
+createLossScaledModel(const std::string &loss_scale) {
+  auto model = ml::train::createModel(
+    ml::train::ModelType::NEURAL_NET,
+    {"loss=mse", "batch_size=2", "epochs=2", "loss_scale=" + loss_scale});
+  model->addLayer(ml::train::layer::Input({"name=in", "input_shape=2:6:6"}));
+  model->addLayer(ml::train::layer::Flatten({"name=flat"}));
+  model->addLayer(ml::train::layer::FullyConnected(
+    {"name=fc", "unit=3", "weight_initializer=ones"}));
+  model->setOptimizer(ml::train::optimizer::SGD({"learning_rate=0.001"}));
+  return model;
+}
+
+/**
+ * @brief Scaling the loss does not change the training
+ */
+TEST(nntrainer_ccapi, loss_scale_p) {
+  std::vector<float> losses;
+  for (auto scale : {"1", "1024"}) {
+    auto model = createLossScaledModel(scale);
+    EXPECT_EQ(model->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                                createCalibrationSet(8)),
+              ML_ERROR_NONE);
+    EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+    EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+    EXPECT_NO_THROW(model->train());
+    losses.push_back(model->getTrainingLoss());
+  }
+
+  EXPECT_NEAR(losses[0], losses[1], tolerance);
+}
+
+/**
+ * @brief Loss scale below 1 is not allowed
+ */
+TEST(nntrainer_ccapi, loss_scale_n) {
+  EXPECT_THROW(createLossScaledModel("0.5"), std::invalid_argument);
+}
+
+/**
+ * @brief Storing the optimizer variables in 16 bit keeps the training close
+ */
+TEST(nntrainer_ccapi, optimizer_state_type_p) {
+  std::vector<float> losses;
+  for (auto type : {"fp32", "fp16", "bf16"}) {
+    auto model = createLossScaledModel("1");
+    model->setProperty({std::string("optimizer_state_type=") + type});
+    model->setOptimizer(ml::train::optimizer::Adam({"learning_rate=0.001"}));
+    EXPECT_EQ(model->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                                createCalibrationSet(8)),
+              ML_ERROR_NONE);
+    EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+    EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+    EXPECT_NO_THROW(model->train());
+    losses.push_back(model->getTrainingLoss());
+  }
+
+  EXPECT_NEAR(losses[0], losses[1], losses[0] * 0.01f);
+  EXPECT_NEAR(losses[0], losses[2], losses[0] * 0.01f);
+}
+
+/**
+ * @brief Unknown optimizer state type is not allowed
+ */
+TEST(nntrainer_ccapi, optimizer_state_type_n) {
+  auto model = createLossScaledModel("1");
+  EXPECT_THROW(model->setProperty({"optimizer_state_type=int8"}),
+               std::invalid_argument);
+}
+
+/**
+ * @brief create a model of fully connected layers with the given checkpoints
+ */
+static std::unique_ptr<ml::train::Model>
+createCheckpointModel(const std::vector<std::string> &checkpoints) {
+  auto model = ml::train::createModel(ml::train::ModelType::NEURAL_NET,
+                                      {"loss=mse", "batch_size=2", "epochs=2"});
+  model->addLayer(ml::train::layer::Input({"name=in", "input_shape=2:6:6"}));
+  model->addLayer(ml::train::layer::Flatten({"name=flat"}));
+  for (std::string name : {"fc1", "fc2", "fc3", "fc4", "fc5", "fc6"}) {
+    bool checkpoint = std::find(checkpoints.begin(), checkpoints.end(),
+                                name) != checkpoints.end();
+    model->addLayer(ml::train::layer::FullyConnected(
+      {"name=" + name, "unit=64", "activation=sigmoid",
+       checkpoint ? "checkpoint=true" : "checkpoint=false"}));
+  }
+  model->addLayer(ml::train::layer::FullyConnected({"name=fc", "unit=3"}));
+  model->setOptimizer(ml::train::optimizer::SGD({"learning_rate=0.1"}));
+  return model;
+}
+
+/**
+ * @brief get the bytes planned for the tensors from the model summary
+ */
+static size_t getPlannedBytes(ml::train::Model &model) {
+  std::stringstream ss;
+  model.summarize(ss, ML_TRAIN_SUMMARY_MODEL);
+  auto pos = ss.str().find("planned ");
+  if (pos == std::string::npos)
+    return 0;
+  return std::stoul(ss.str().substr(pos + 8));
+}
+
+/**
+ * @brief Recomputing from the checkpoints trains the same with less memory
+ */
+TEST(nntrainer_ccapi, checkpoint_p) {
+  const std::string weights = "checkpoint_p.bin";
+  std::vector<float> losses;
+  std::vector<size_t> planned;
+  for (auto &checkpoints : std::vector<std::vector<std::string>>{
+         {}, {"fc3", "fc6"}}) {
+    auto model = createCheckpointModel(checkpoints);
+    EXPECT_EQ(model->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                                createCalibrationSet(8)),
+              ML_ERROR_NONE);
+    EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+    EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+    if (losses.empty())
+      model->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+    else
+      model->load(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+
+    EXPECT_NO_THROW(model->train());
+    losses.push_back(model->getTrainingLoss());
+    planned.push_back(getPlannedBytes(*model));
+  }
+  std::remove(weights.c_str());
+
+  EXPECT_NEAR(losses[0], losses[1], tolerance);
+  EXPECT_LT(planned[1], planned[0]);
+}
+
+/**
+ * @brief Recomputation draws the dropout mask of the forwarding and leaves
+ * the moving statistics of batch normalization as the forwarding set them
+ */
+TEST(nntrainer_ccapi, checkpoint_dropout_batch_normalization_p) {
+  auto state = nntrainer::Tensor::getRandomState();
+  std::vector<float> data(2 * 2 * 6 * 6, 0.5f);
+  std::vector<float *> in = {data.data()}, label;
+  std::vector<std::vector<float>> outs;
+  for (bool checkpoint : {false, true}) {
+    auto model = ml::train::createModel(
+      ml::train::ModelType::NEURAL_NET,
+      {"loss=mse", "batch_size=2", "epochs=2"});
+    model->addLayer(ml::train::layer::Input({"name=in", "input_shape=2:6:6"}));
+    model->addLayer(ml::train::layer::Flatten({"name=flat"}));
+    model->addLayer(
+      ml::train::layer::FullyConnected({"name=fc1", "unit=16"}));
+    model->addLayer(ml::train::layer::BatchNormalization({"name=bn"}));
+    model->addLayer(
+      ml::train::createLayer("dropout", {"name=drop", "dropout_rate=0.5"}));
+    model->addLayer(ml::train::layer::FullyConnected(
+      {"name=fc2", "unit=16",
+       checkpoint ? "checkpoint=true" : "checkpoint=false"}));
+    model->addLayer(ml::train::layer::FullyConnected({"name=fc", "unit=3"}));
+    model->setOptimizer(ml::train::optimizer::SGD({"learning_rate=0.01"}));
+    EXPECT_EQ(model->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                                createCalibrationSet(8)),
+              ML_ERROR_NONE);
+
+    nntrainer::Tensor::setRandomState(state);
+    EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+    EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+    EXPECT_NO_THROW(model->train());
+
+    auto out = model->inference(2, in, label);
+    outs.emplace_back(out[0], out[0] + 6);
+  }
+
+  for (unsigned int i = 0; i < 6; ++i)
+    EXPECT_NEAR(outs[0][i], outs[1][i], tolerance);
+}
+
+/**
+ * @brief Output of a recomputed layer must not be used across the checkpoint
+ */
+TEST(nntrainer_ccapi, checkpoint_n) {
+  auto model = ml::train::createModel(ml::train::ModelType::NEURAL_NET,
+                                      {"loss=mse", "batch_size=2"});
+  model->addLayer(ml::train::layer::Input({"name=in", "input_shape=1:1:8"}));
+  model->addLayer(ml::train::layer::FullyConnected({"name=fc1", "unit=8"}));
+  model->addLayer(ml::train::layer::FullyConnected(
+    {"name=fc2", "unit=8", "checkpoint=true"}));
+  model->addLayer(ml::train::layer::Addition(
+    {"name=add", "input_layers=fc1,fc2"}));
+  model->addLayer(ml::train::layer::FullyConnected(
+    {"name=fc3", "unit=8", "checkpoint=true"}));
+  model->setOptimizer(ml::train::optimizer::SGD({"learning_rate=0.1"}));
+  EXPECT_NE(model->compile(), ML_ERROR_NONE);
+}
+
+/**
+ * @brief Swapping the idle tensors to a file trains the same with less memory
+ */
+TEST(nntrainer_ccapi, memory_swap_p) {
+  const std::string weights = "memory_swap_p.bin";
+  std::vector<float> losses;
+  std::vector<size_t> planned;
+  for (auto swap : {"false", "true"}) {
+    auto model = createCheckpointModel({});
+    EXPECT_NO_THROW(model->setProperty({std::string("memory_swap=") + swap,
+                                        "memory_swap_path=.",
+                                        "memory_swap_lookahead=2"}));
+    EXPECT_EQ(model->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                                createCalibrationSet(8)),
+              ML_ERROR_NONE);
+    EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+    EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+    if (losses.empty())
+      model->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+    else
+      model->load(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+
+    EXPECT_NO_THROW(model->train());
+    losses.push_back(model->getTrainingLoss());
+    planned.push_back(getPlannedBytes(*model));
+  }
+  std::remove(weights.c_str());
+
+  EXPECT_NEAR(losses[0], losses[1], tolerance);
+  EXPECT_LT(planned[1], planned[0]);
+}
+
+/**
+ * @brief Swap file must be created in an existing directory
+ */
+TEST(nntrainer_ccapi, memory_swap_n) {
+  auto model = createCheckpointModel({});
+  EXPECT_NO_THROW(model->setProperty(
+    {"memory_swap=true", "memory_swap_path=./not_existing_directory"}));
+  EXPECT_EQ(model->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                              createCalibrationSet(8)),
+            ML_ERROR_NONE);
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+  EXPECT_THROW(model->train(), std::runtime_error);
+}
+
+/**
+ * @brief Weights mapped from the file give the same result as the saved model
+ */
+TEST(nntrainer_ccapi, mmap_weights_p) {
+  const std::string weights = "mmap_weights_p.bin";
+  auto model = createQuantizableModel();
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> data(2 * 2 * 6 * 6);
+  std::generate(data.begin(), data.end(), [&] { return dist(rng); });
+  std::vector<float *> in = {data.data()}, label;
+
+  auto out = model->inference(2, in, label);
+  std::vector<float> expected(out[0], out[0] + 6);
+  EXPECT_NO_THROW(
+    model->save(weights, ml::train::ModelFormat::MODEL_FORMAT_MMAP));
+
+  auto mapped = createQuantizableModel();
+  EXPECT_EQ(mapped->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(mapped->initialize(), ML_ERROR_NONE);
+  EXPECT_NO_THROW(
+    mapped->load(weights, ml::train::ModelFormat::MODEL_FORMAT_MMAP));
+
+  out = mapped->inference(2, in, label);
+  for (unsigned int i = 0; i < 6; ++i)
+    EXPECT_FLOAT_EQ(out[0][i], expected[i]);
+  std::remove(weights.c_str());
+}
+
+/**
+ * @brief Only the file saved with MODEL_FORMAT_MMAP can be mapped
+ */
+TEST(nntrainer_ccapi, mmap_weights_n) {
+  const std::string weights = "mmap_weights_n.bin";
+  auto model = createQuantizableModel();
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+  model->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+
+  EXPECT_THROW(model->load(weights, ml::train::ModelFormat::MODEL_FORMAT_MMAP),
+               std::runtime_error);
+  std::remove(weights.c_str());
+}
+
+/**
+ * @brief Checkpoint written in background is the same as the one written
+ * synchronously
+ */
+TEST(nntrainer_ccapi, async_save_p) {
+  const std::string weights = "async_save_p.bin";
+  std::vector<std::string> saved;
+  for (auto async : {"false", "true"}) {
+    std::string save_path = std::string("async_save_p_") + async + ".bin";
+    auto model = createCheckpointModel({});
+    EXPECT_NO_THROW(model->setProperty(
+      {std::string("async_save=") + async, "save_path=" + save_path}));
+    EXPECT_EQ(model->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                                createCalibrationSet(8)),
+              ML_ERROR_NONE);
+    EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+    EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+    if (saved.empty())
+      model->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+    else
+      model->load(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+
+    EXPECT_NO_THROW(model->train());
+
+    std::ifstream file(save_path, std::ios::in | std::ios::binary);
+    saved.emplace_back(std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>());
+    std::remove(save_path.c_str());
+  }
+  std::remove(weights.c_str());
+
+  EXPECT_FALSE(saved[0].empty());
+  EXPECT_EQ(saved[0], saved[1]);
+}
+
+/**
+ * @brief Training resumed from a checkpoint goes on with the optimizer
+ * variables saved in it
+ */
+TEST(nntrainer_ccapi, save_optimizer_variables_p) {
+  const std::string weights = "save_optimizer_variables_p.bin";
+  const std::string checkpoint = "save_optimizer_variables_p_ckpt.bin";
+
+  /** same samples every epoch */
+  auto create_dataset = [] {
+    auto count = std::make_shared<unsigned int>(0);
+    auto cb = [count](float **input, float **label, bool *last,
+                      void *user_data) {
+      for (unsigned int i = 0; i < 2 * 6 * 6; ++i)
+        input[0][i] = std::sin(static_cast<float>(*count * 72 + i));
+      std::fill(label[0], label[0] + 3, 0.5f);
+      *last = ++(*count) == 4;
+      if (*last)
+        *count = 0;
+      return ML_ERROR_NONE;
+    };
+    return ml::train::createDataset(ml::train::DatasetType::GENERATOR, cb);
+  };
+
+  std::vector<float> data(2 * 2 * 6 * 6, 0.5f);
+  std::vector<float *> in = {data.data()}, label;
+  std::vector<std::vector<float>> outs;
+  for (auto const &run : std::vector<std::vector<std::string>>{
+         {"epochs=2"},
+         {"epochs=1", "save_path=" + checkpoint},
+         {"epochs=2", "continue_train=true"}}) {
+    auto model = createCheckpointModel({});
+    model->setOptimizer(ml::train::optimizer::Adam({"learning_rate=0.01"}));
+    EXPECT_NO_THROW(model->setProperty(run));
+    EXPECT_EQ(model->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                                create_dataset()),
+              ML_ERROR_NONE);
+    EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+    EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+    if (outs.empty())
+      model->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+    else if (outs.size() == 1)
+      model->load(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+    else
+      model->load(checkpoint, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+
+    EXPECT_NO_THROW(model->train());
+    auto out = model->inference(2, in, label);
+    outs.emplace_back(out[0], out[0] + 3);
+  }
+
+  /** weights, epoch and iteration, then the two variables of adam */
+  std::ifstream file(checkpoint, std::ios::in | std::ios::binary);
+  file.seekg(0, std::ios::end);
+  size_t bytes = file.tellg();
+  file.close();
+  std::ifstream initial(weights, std::ios::in | std::ios::binary);
+  initial.seekg(0, std::ios::end);
+  size_t weight_bytes = static_cast<size_t>(initial.tellg()) - 8;
+  initial.close();
+  EXPECT_EQ(bytes, weight_bytes * 3 + 8);
+  std::remove(weights.c_str());
+  std::remove(checkpoint.c_str());
+
+  for (unsigned int i = 0; i < 3; ++i)
+    EXPECT_NEAR(outs[0][i], outs[2][i], tolerance);
+}
+
+/**
+ * @brief Failure of the checkpoint written in background is thrown by train
+ */
+TEST(nntrainer_ccapi, async_save_n) {
+  auto model = createCheckpointModel({});
+  EXPECT_NO_THROW(model->setProperty(
+    {"async_save=true", "save_path=./not_existing_directory/model.bin"}));
+  EXPECT_EQ(model->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                              createCalibrationSet(8)),
+            ML_ERROR_NONE);
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+  EXPECT_ANY_THROW(model->train());
+}
+
+/**
+ * @brief create a model of which batch normalization and activation can be
+ * fused to the conv2d and fully connected layers
+ */
+static std::unique_ptr<ml::train::Model>
+createFusableModel(const std::vector<std::string> &properties) {
+  std::vector<std::string> model_props = {"loss=mse", "batch_size=2",
+                                          "epochs=2"};
+  model_props.insert(model_props.end(), properties.begin(), properties.end());
+  auto model =
+    ml::train::createModel(ml::train::ModelType::NEURAL_NET, model_props);
+  model->addLayer(ml::train::layer::Input({"name=in", "input_shape=2:6:6"}));
+  model->addLayer(ml::train::layer::Convolution2D(
+    {"name=conv", "filters=4", "kernel_size=3,3", "padding=same"}));
+  model->addLayer(ml::train::layer::BatchNormalization({"name=conv_bn"}));
+  model->addLayer(ml::train::layer::ReLU({"name=conv_act"}));
+  model->addLayer(ml::train::layer::Flatten({"name=flat"}));
+  model->addLayer(ml::train::layer::FullyConnected({"name=fc0", "unit=5"}));
+  model->addLayer(ml::train::layer::BatchNormalization(
+    {"name=fc0_bn", "activation=tanh"}));
+  model->addLayer(ml::train::layer::FullyConnected(
+    {"name=fc1", "unit=3", "activation=sigmoid"}));
+  model->setOptimizer(ml::train::optimizer::SGD({"learning_rate=0.1"}));
+  return model;
+}
+
+/**
+ * @brief Model fused for the inference gives the same result with the weights
+ * trained without the fusion
+ */
+TEST(nntrainer_ccapi, inference_fusion_p) {
+  const std::string weights = "inference_fusion_p.bin";
+  auto model = createFusableModel({});
+  EXPECT_EQ(model->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                              createCalibrationSet(8)),
+            ML_ERROR_NONE);
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+  /// training moves the statistics of the batch normalization
+  EXPECT_EQ(model->train(), ML_ERROR_NONE);
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> data(2 * 2 * 6 * 6);
+  std::generate(data.begin(), data.end(), [&] { return dist(rng); });
+  std::vector<float *> in = {data.data()}, label;
+
+  auto out = model->inference(2, in, label);
+  std::vector<float> expected(out[0], out[0] + 6);
+  model->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+
+  auto fused = createFusableModel({"inference_fusion=true"});
+  EXPECT_EQ(fused->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(fused->initialize(), ML_ERROR_NONE);
+  EXPECT_NO_THROW(fused->load(weights));
+
+  /// batch normalization and activation layers are gone
+  std::shared_ptr<ml::train::Layer> layer;
+  EXPECT_EQ(fused->getLayer("conv", &layer), ML_ERROR_NONE);
+  EXPECT_ANY_THROW(fused->getLayer("conv_bn", &layer));
+  EXPECT_ANY_THROW(fused->getLayer("conv_act", &layer));
+  EXPECT_ANY_THROW(fused->getLayer("fc0_bn", &layer));
+
+  /// folding twice does not change the result
+  for (unsigned int run = 0; run < 2; ++run) {
+    out = fused->inference(2, in, label);
+    for (unsigned int i = 0; i < 6; ++i)
+      EXPECT_NEAR(out[0][i], expected[i], 1e-5);
+  }
+  std::remove(weights.c_str());
+}
+
+/**
+ * @brief Model fused for the inference can not be trained
+ */
+TEST(nntrainer_ccapi, inference_fusion_n) {
+  auto model = createFusableModel({"inference_fusion=true"});
+  EXPECT_EQ(model->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                              createCalibrationSet(8)),
+            ML_ERROR_NONE);
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+  EXPECT_EQ(model->train(), ML_ERROR_NOT_SUPPORTED);
+}
+
+/**
+ * @brief create a model branching with split and merging with concat
+ */
+static std::unique_ptr<ml::train::Model>
+createBranchModel(const std::vector<std::string> &properties) {
+  std::vector<std::string> model_props = {"loss=mse", "batch_size=1",
+                                          "epochs=1"};
+  model_props.insert(model_props.end(), properties.begin(), properties.end());
+  auto model =
+    ml::train::createModel(ml::train::ModelType::NEURAL_NET, model_props);
+  model->addLayer(ml::train::layer::Input({"name=in", "input_shape=2:6:6"}));
+  model->addLayer(ml::train::layer::Convolution2D(
+    {"name=conv", "filters=2", "kernel_size=3,3", "padding=same"}));
+  model->addLayer(ml::train::createLayer(
+    "split", {"name=split", "axis=1", "input_layers=conv"}));
+  model->addLayer(ml::train::layer::FullyConnected(
+    {"name=fc_a", "unit=4", "input_layers=split(0)"}));
+  model->addLayer(ml::train::layer::FullyConnected(
+    {"name=fc_b", "unit=4", "activation=sigmoid", "input_layers=split(1)"}));
+  model->addLayer(ml::train::layer::Concat(
+    {"name=concat", "axis=1", "input_layers=fc_a,fc_b"}));
+  model->addLayer(ml::train::layer::ReLU({"name=concat_act"}));
+  model->addLayer(ml::train::layer::Flatten({"name=flat"}));
+  model->addLayer(ml::train::layer::FullyConnected({"name=fc", "unit=3"}));
+  model->setOptimizer(ml::train::optimizer::SGD({"learning_rate=0.1"}));
+  return model;
+}
+
+/**
+ * @brief Model placing the concat and split tensors without copy gives the
+ * same result as the one copying them
+ */
+TEST(nntrainer_ccapi, zero_copy_concat_split_p) {
+  const std::string weights = "zero_copy_concat_split_p.bin";
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> data(2 * 6 * 6);
+  std::generate(data.begin(), data.end(), [&] { return dist(rng); });
+  std::vector<float *> in = {data.data()}, label;
+
+  auto copied = createBranchModel({"memory_optimization=false"});
+  EXPECT_EQ(copied->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                               createCalibrationSet(8)),
+            ML_ERROR_NONE);
+  EXPECT_EQ(copied->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(copied->initialize(), ML_ERROR_NONE);
+  copied->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  EXPECT_EQ(copied->train(), ML_ERROR_NONE);
+  auto out = copied->inference(1, in, label);
+  std::vector<float> expected(out[0], out[0] + 3);
+
+  auto placed = createBranchModel({});
+  EXPECT_EQ(placed->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                               createCalibrationSet(8)),
+            ML_ERROR_NONE);
+  EXPECT_EQ(placed->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(placed->initialize(), ML_ERROR_NONE);
+  EXPECT_NO_THROW(placed->load(weights));
+  EXPECT_EQ(placed->train(), ML_ERROR_NONE);
+  out = placed->inference(1, in, label);
+  for (unsigned int i = 0; i < 3; ++i)
+    EXPECT_NEAR(out[0][i], expected[i], 1e-5);
+
+  std::remove(weights.c_str());
+}
+
+/**
+ * @brief Batch size of the model placing the concat and split tensors without
+ * copy cannot be changed
+ */
+TEST(nntrainer_ccapi, zero_copy_concat_split_n) {
+  auto model = createBranchModel({});
+  EXPECT_EQ(model->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(model->initialize(), ML_ERROR_NONE);
+
+  std::vector<float> data(2 * 2 * 6 * 6, 0.5f);
+  std::vector<float *> in = {data.data()}, label;
+  EXPECT_THROW(model->inference(2, in, label), std::invalid_argument);
+}
+
+/**
+ * @brief create a model with a residual connection
+ */
+static std::unique_ptr<ml::train::Model>
+createResidualModel(const std::vector<std::string> &properties) {
+  std::vector<std::string> model_props = {"loss=mse", "batch_size=2",
+                                          "epochs=1"};
+  model_props.insert(model_props.end(), properties.begin(), properties.end());
+  auto model =
+    ml::train::createModel(ml::train::ModelType::NEURAL_NET, model_props);
+  model->addLayer(ml::train::layer::Input({"name=in", "input_shape=2:6:6"}));
+  model->addLayer(ml::train::layer::Convolution2D(
+    {"name=conv", "filters=2", "kernel_size=3,3", "padding=same"}));
+  model->addLayer(ml::train::layer::Convolution2D(
+    {"name=conv_a", "filters=2", "kernel_size=3,3", "padding=same"}));
+  model->addLayer(ml::train::layer::BatchNormalization({"name=conv_a_bn"}));
+  model->addLayer(
+    ml::train::layer::Addition({"name=add", "input_layers=conv_a_bn,conv"}));
+  model->addLayer(ml::train::layer::ReLU({"name=add_act"}));
+  model->addLayer(ml::train::layer::Flatten({"name=flat"}));
+  model->addLayer(ml::train::layer::FullyConnected({"name=fc", "unit=3"}));
+  model->setOptimizer(ml::train::optimizer::SGD({"learning_rate=0.1"}));
+  return model;
+}
+
+/**
+ * @brief Model running the addition in-place and aliasing its derivatives
+ * gives the same result as the one copying them
+ */
+TEST(nntrainer_ccapi, inplace_addition_p) {
+  const std::string weights = "inplace_addition_p.bin";
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> data(2 * 2 * 6 * 6);
+  std::generate(data.begin(), data.end(), [&] { return dist(rng); });
+  std::vector<float *> in = {data.data()}, label;
+
+  auto copied = createResidualModel({"memory_optimization=false"});
+  EXPECT_EQ(copied->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                               createCalibrationSet(8)),
+            ML_ERROR_NONE);
+  EXPECT_EQ(copied->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(copied->initialize(), ML_ERROR_NONE);
+  copied->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  EXPECT_EQ(copied->train(), ML_ERROR_NONE);
+  auto out = copied->inference(2, in, label);
+  std::vector<float> expected(out[0], out[0] + 6);
+
+  auto inplace = createResidualModel({});
+  EXPECT_EQ(inplace->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                                createCalibrationSet(8)),
+            ML_ERROR_NONE);
+  EXPECT_EQ(inplace->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(inplace->initialize(), ML_ERROR_NONE);
+  EXPECT_NO_THROW(inplace->load(weights));
+  EXPECT_EQ(inplace->train(), ML_ERROR_NONE);
+  out = inplace->inference(2, in, label);
+  for (unsigned int i = 0; i < 6; ++i)
+    EXPECT_NEAR(out[0][i], expected[i], 1e-5);
+
+  std::remove(weights.c_str());
+}
+
+/**
+ * @brief Model running the independent layers concurrently gives the same
+ * result as the one running them one by one
+ */
+TEST(nntrainer_ccapi, parallel_layers_p) {
+  const std::string weights = "parallel_layers_p.bin";
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> data(2 * 6 * 6);
+  std::generate(data.begin(), data.end(), [&] { return dist(rng); });
+  std::vector<float *> in = {data.data()}, label;
+
+  auto sequential = createBranchModel({});
+  EXPECT_EQ(sequential->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                                   createCalibrationSet(8)),
+            ML_ERROR_NONE);
+  EXPECT_EQ(sequential->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(sequential->initialize(), ML_ERROR_NONE);
+  sequential->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  EXPECT_EQ(sequential->train(), ML_ERROR_NONE);
+  auto out = sequential->inference(1, in, label);
+  std::vector<float> expected(out[0], out[0] + 3);
+
+  auto parallel = createBranchModel({"parallel_layers=2"});
+  EXPECT_EQ(parallel->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                                 createCalibrationSet(8)),
+            ML_ERROR_NONE);
+  EXPECT_EQ(parallel->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(parallel->initialize(), ML_ERROR_NONE);
+  EXPECT_NO_THROW(parallel->load(weights));
+  EXPECT_EQ(parallel->train(), ML_ERROR_NONE);
+  out = parallel->inference(1, in, label);
+  for (unsigned int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(out[0][i], expected[i]);
+
+  std::remove(weights.c_str());
+}
+
+/**
+ * @brief Number of threads running the layers must be positive
+ */
+TEST(nntrainer_ccapi, parallel_layers_n) {
+  EXPECT_ANY_THROW(createBranchModel({"parallel_layers=0"}));
+}
+
+/**
+ * @brief Model applying the gradients in background gives the same result as
+ * the one applying them right away
+ */
+TEST(nntrainer_ccapi, async_update_p) {
+  const std::string weights = "async_update_p.bin";
+
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> data(2 * 2 * 6 * 6);
+  std::generate(data.begin(), data.end(), [&] { return dist(rng); });
+  std::vector<float *> in = {data.data()}, label;
+
+  auto inline_update = createResidualModel({"epochs=2"});
+  inline_update->setOptimizer(
+    ml::train::optimizer::Adam({"learning_rate=0.01"}));
+  EXPECT_EQ(inline_update->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                                      createCalibrationSet(8)),
+            ML_ERROR_NONE);
+  EXPECT_EQ(inline_update->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(inline_update->initialize(), ML_ERROR_NONE);
+  inline_update->save(weights, ml::train::ModelFormat::MODEL_FORMAT_BIN);
+  EXPECT_EQ(inline_update->train(), ML_ERROR_NONE);
+  auto out = inline_update->inference(2, in, label);
+  std::vector<float> expected(out[0], out[0] + 6);
+
+  auto async_update = createResidualModel({"epochs=2", "async_update=true"});
+  async_update->setOptimizer(
+    ml::train::optimizer::Adam({"learning_rate=0.01"}));
+  EXPECT_EQ(async_update->setDataset(ml::train::DatasetModeType::MODE_TRAIN,
+                                     createCalibrationSet(8)),
+            ML_ERROR_NONE);
+  EXPECT_EQ(async_update->compile(), ML_ERROR_NONE);
+  EXPECT_EQ(async_update->initialize(), ML_ERROR_NONE);
+  EXPECT_NO_THROW(async_update->load(weights));
+  EXPECT_EQ(async_update->train(), ML_ERROR_NONE);
+  out = async_update->inference(2, in, label);
+  for (unsigned int i = 0; i < 6; ++i)
+    EXPECT_FLOAT_EQ(out[0][i], expected[i]);
+
+  std::remove(weights.c_str());
+}
+
 /**
  * @brief Main gtest
  */
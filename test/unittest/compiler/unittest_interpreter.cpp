@@ -191,6 +191,66 @@ TEST(nntrainerInterpreterTflite, simple_fc) {
               << "failed, reason: " << strerror(errno);
   }
 }
+
+TEST(nntrainerInterpreterTflite, deserialize_simple_fc_p) {
+
+  nntrainer::TfliteInterpreter interpreter;
+
+  auto fc0 = LayerRepresentation(
+    "fully_connected", {"name=fc0", "unit=2", "input_shape=1:1:1",
+                        "bias_initializer=ones", "weight_initializer=ones"});
+
+  auto fc1 = LayerRepresentation(
+    "fully_connected", {"name=fc1", "unit=2", "bias_initializer=ones",
+                        "weight_initializer=ones", "input_layers=fc0"});
+
+  auto g = makeGraph({fc0, fc1});
+
+  nntrainer::NetworkGraph ng;
+  for (auto &node : g) {
+    ng.addLayer(node);
+  }
+  EXPECT_EQ(ng.compile(""), ML_ERROR_NONE);
+  EXPECT_EQ(ng.initialize(), ML_ERROR_NONE);
+
+  ng.allocateTensors(nntrainer::ExecutionMode::INFERENCE);
+  interpreter.serialize(g, "test_deserialize.tflite");
+  ng.deallocateTensors();
+
+  auto imported = interpreter.deserialize("test_deserialize.tflite");
+  ASSERT_EQ(imported.size(), 3u);
+  EXPECT_EQ(imported[0]->getType(), "input");
+  EXPECT_EQ(imported[1]->getType(), "fully_connected");
+  EXPECT_EQ(imported[2]->getType(), "fully_connected");
+
+  nntrainer::NetworkGraph imported_ng;
+  for (auto &node : imported) {
+    imported_ng.addLayer(node);
+  }
+  EXPECT_EQ(imported_ng.compile(""), ML_ERROR_NONE);
+  EXPECT_EQ(imported_ng.initialize(), ML_ERROR_NONE);
+
+  imported_ng.allocateTensors(nntrainer::ExecutionMode::INFERENCE);
+  EXPECT_NO_THROW(interpreter.loadWeights(imported_ng));
+
+  auto &weight = imported[2]->getWeight(0);
+  nntrainer::Tensor ans(weight.getDim());
+  ans.setValue(1.0f);
+  EXPECT_EQ(weight, ans);
+  imported_ng.deallocateTensors();
+
+  if (remove("test_deserialize.tflite")) {
+    std::cerr << "remove ini "
+              << "test_deserialize.tflite"
+              << "failed, reason: " << strerror(errno);
+  }
+}
+
+TEST(nntrainerInterpreterTflite, deserialize_not_exist_n) {
+  nntrainer::TfliteInterpreter interpreter;
+
+  EXPECT_ANY_THROW(interpreter.deserialize("not_existing_file.tflite"));
+}
 #endif
 /**
  * @brief make ini test case from given parameter
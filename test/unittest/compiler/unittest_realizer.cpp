@@ -16,6 +16,7 @@
 #include <vector>
 
 #include <flatten_realizer.h>
+#include <fusion_realizer.h>
 #include <input_realizer.h>
 #include <multiout_realizer.h>
 #include <previous_input_realizer.h>
@@ -415,4 +416,54 @@ TEST(ActivationRealizer, activation_unknown_n) {
   };
 
   EXPECT_ANY_THROW(realizeAndEqual(ar, before, {}));
-}
\ No newline at end of file
+}
+
+TEST(FusionRealizer, fusion_p) {
+  FusionRealizer fr;
+
+  std::vector<LayerRepresentation> before = {
+    {"conv2d", {"name=a", "filters=2", "kernel_size=1,1"}},
+    {"batch_normalization", {"name=b", "input_layers=a", "epsilon=0.01"}},
+    {"activation", {"name=c", "activation=relu", "input_layers=b"}},
+    {"fully_connected", {"name=d", "input_layers=c", "activation=sigmoid"}},
+    {"fully_connected",
+     {"name=e", "input_layers=d", "activation=softmax"}}, /// not fused
+  };
+
+  std::vector<LayerRepresentation> after = {
+    {"conv2d",
+     {"name=a", "filters=2", "kernel_size=1,1", "fused_batch_norm=true",
+      "epsilon=0.01", "activation=none", "fused_activation=relu"}},
+    {"fully_connected",
+     {"name=d", "input_layers=a", "activation=none",
+      "fused_activation=sigmoid"}},
+    {"fully_connected", {"name=e", "input_layers=d", "activation=softmax"}},
+  };
+
+  realizeAndEqual(fr, before, after);
+}
+
+TEST(FusionRealizer, fusion_not_foldable_p) {
+  FusionRealizer fr;
+
+  /// batch normalization after an activation, or sharing the input with
+  /// another layer is not folded
+  std::vector<LayerRepresentation> before = {
+    {"fully_connected", {"name=a", "activation=relu"}},
+    {"batch_normalization", {"name=b", "input_layers=a"}},
+    {"fully_connected", {"name=c", "input_layers=b"}},
+    {"batch_normalization", {"name=d", "input_layers=c"}},
+    {"batch_normalization", {"name=e", "input_layers=c"}},
+  };
+
+  std::vector<LayerRepresentation> after = {
+    {"fully_connected",
+     {"name=a", "activation=none", "fused_activation=relu"}},
+    {"batch_normalization", {"name=b", "input_layers=a"}},
+    {"fully_connected", {"name=c", "input_layers=b"}},
+    {"batch_normalization", {"name=d", "input_layers=c"}},
+    {"batch_normalization", {"name=e", "input_layers=c"}},
+  };
+
+  realizeAndEqual(fr, before, after);
+}
@@ -12,7 +12,9 @@
 #include <gtest/gtest.h>
 
 #include <databuffer.h>
+#include <nntrainer_test_util.h>
 #include <random_data_producers.h>
+#include <raw_file_data_producer.h>
 
 #include <memory>
 
@@ -84,3 +86,51 @@ TEST(DataBuffer, fetchAfterBqIsDeleted_n) {
   future_bq.get();
   EXPECT_THROW(db.fetch(), std::runtime_error);
 }
+
+/**
+ * @brief fetch every sample of an epoch with given number of workers
+ */
+static std::vector<nntrainer::Tensor> fetchEpoch(unsigned int num_workers) {
+  std::unique_ptr<nntrainer::DataProducer> prod =
+    std::make_unique<nntrainer::RawFileDataProducer>();
+
+  nntrainer::DataBuffer db(std::move(prod));
+  db.setProperty({"buffer_size=2",
+                  "path=" + getResPath("trainingSet.dat", {"test"}),
+                  "num_workers=" + std::to_string(num_workers)});
+
+  std::vector<nntrainer::Tensor> fetched;
+  auto future_iq =
+    db.startFetchWorker({{16, 3, 32, 32}}, {{16, 1, 1, 10}}, false);
+  while (true) {
+    auto iteration_view = db.fetch();
+    if (iteration_view.isEmpty()) {
+      break;
+    }
+    auto &iter = iteration_view.get();
+    fetched.push_back(iter.getInputsRef()[0].clone());
+    fetched.push_back(iter.getLabelsRef()[0].clone());
+  }
+  future_iq.get();
+
+  return fetched;
+}
+
+TEST(DataBuffer, fetchIterationMultiWorkers_p) {
+  auto expected = fetchEpoch(1);
+  auto fetched = fetchEpoch(4);
+
+  ASSERT_FALSE(expected.empty());
+  ASSERT_EQ(fetched.size(), expected.size());
+  for (unsigned int i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(fetched[i], expected[i]);
+  }
+}
+
+TEST(DataBuffer, setNumWorkers_n) {
+  std::unique_ptr<nntrainer::DataProducer> prod =
+    std::make_unique<nntrainer::RandomDataOneHotProducer>();
+
+  nntrainer::DataBuffer db(std::move(prod));
+  EXPECT_THROW(db.setProperty({"num_workers=0"}), std::invalid_argument);
+}
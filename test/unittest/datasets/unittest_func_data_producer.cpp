@@ -85,6 +85,14 @@ createConstantSampleProducer(const std::vector<std::string> &properties = {}) {
   return ptr;
 }
 
+std::unique_ptr<nntrainer::DataProducer>
+createSizedSampleProducer(const std::vector<std::string> &properties = {}) {
+  std::unique_ptr<nntrainer::DataProducer> ptr =
+    std::make_unique<nntrainer::FuncDataProducer>(getSample, &user_data);
+  ptr->setProperty(properties);
+  return ptr;
+}
+
 std::unique_ptr<nntrainer::DataProducer>
 createErrorSampleProducer(const std::vector<std::string> &properties = {}) {
   std::unique_ptr<nntrainer::DataProducer> ptr =
@@ -103,6 +111,10 @@ auto func_success = DataProducerSemanticsParamType(
   createConstantSampleProducer, {}, input_shapes, label_shapes, validate,
   DataProducerSemanticsExpectedResult::SUCCESS);
 
+auto func_sized = DataProducerSemanticsParamType(
+  createSizedSampleProducer, {"num_samples=5"}, input_shapes, label_shapes,
+  validate, DataProducerSemanticsExpectedResult::SUCCESS);
+
 auto func_error = DataProducerSemanticsParamType(
   createErrorSampleProducer, {}, input_shapes, label_shapes, nullptr,
   DataProducerSemanticsExpectedResult::FAIL_AT_GENERATOR_CALL);
@@ -112,5 +124,21 @@ auto func_nullptr = DataProducerSemanticsParamType(
   DataProducerSemanticsExpectedResult::FAIL_AT_FINALIZE);
 
 INSTANTIATE_TEST_CASE_P(Func, DataProducerSemantics,
-                        ::testing::Values(func_success, func_error,
-                                          func_nullptr));
+                        ::testing::Values(func_success, func_sized,
+                                          func_error, func_nullptr));
+
+TEST(FuncDataProducer, numSamples_p) {
+  nntrainer::FuncDataProducer producer(getSample, &user_data);
+  EXPECT_FALSE(producer.isMultiThreadSafe());
+  EXPECT_EQ(producer.size(input_shapes, label_shapes),
+            nntrainer::DataProducer::SIZE_UNDEFINED);
+
+  producer.setProperty({"num_samples=5"});
+  EXPECT_TRUE(producer.isMultiThreadSafe());
+  EXPECT_EQ(producer.size(input_shapes, label_shapes), 5u);
+}
+
+TEST(FuncDataProducer, numSamples_n) {
+  nntrainer::FuncDataProducer producer(getSample, &user_data);
+  EXPECT_THROW(producer.setProperty({"num_samples=0"}), std::invalid_argument);
+}
@@ -10,9 +10,11 @@
  * @bug No known bugs except for NYI items
  */
 #include <tuple>
+#include <vector>
 
 #include <gtest/gtest.h>
 
+#include <conv2d_kernels.h>
 #include <conv2d_layer.h>
 #include <layers_common_tests.h>
 
@@ -20,8 +22,14 @@ auto semantic_conv2d = LayerSemanticsParamType(
   nntrainer::createLayer<nntrainer::Conv2DLayer>, nntrainer::Conv2DLayer::type,
   {"filters=1", "kernel_size=1,1", "padding=1,1"}, 0, false, 1);
 
+auto semantic_conv2d_dilation = LayerSemanticsParamType(
+  nntrainer::createLayer<nntrainer::Conv2DLayer>, nntrainer::Conv2DLayer::type,
+  {"filters=1", "kernel_size=1,1", "padding=same", "dilation=2,2"}, 0, false,
+  1);
+
 INSTANTIATE_TEST_CASE_P(Convolution2D, LayerSemantics,
-                        ::testing::Values(semantic_conv2d));
+                        ::testing::Values(semantic_conv2d,
+                                          semantic_conv2d_dilation));
 
 auto conv2d_sb_minimum = LayerGoldenTestParamType(
   nntrainer::createLayer<nntrainer::Conv2DLayer>,
@@ -139,6 +147,35 @@ auto conv2d_mb_1x1_kernel =
                            "3:2:5:5", "conv2d_mb_1x1_kernel.nnlayergolden",
                            LayerGoldenTestParamOptions::DEFAULT);
 
+auto conv2d_mb_minimum_im2col_batch = LayerGoldenTestParamType(
+  nntrainer::createLayer<nntrainer::Conv2DLayer>,
+  {"filters=3", "kernel_size=2,2", "im2col_batch=3"}, "3:1:4:4",
+  "conv2d_mb_minimum.nnlayergolden", LayerGoldenTestParamOptions::DEFAULT);
+
+auto conv2d_mb_same_uneven_remain_im2col_batch = LayerGoldenTestParamType(
+  nntrainer::createLayer<nntrainer::Conv2DLayer>,
+  {
+    "filters=2",
+    "kernel_size=3,3",
+    "stride=2,2",
+    "padding=same",
+    "im2col_batch=2",
+  },
+  "3:3:4:4", "conv2d_mb_same_uneven_remain.nnlayergolden",
+  LayerGoldenTestParamOptions::DEFAULT);
+
+auto conv2d_mb_valid_drop_last_im2col_batch = LayerGoldenTestParamType(
+  nntrainer::createLayer<nntrainer::Conv2DLayer>,
+  {
+    "filters=2",
+    "kernel_size=3,3",
+    "stride=2,2",
+    "padding=valid",
+    "im2col_batch=4",
+  },
+  "3:3:7:7", "conv2d_mb_valid_drop_last.nnlayergolden",
+  LayerGoldenTestParamOptions::DEFAULT);
+
 INSTANTIATE_TEST_CASE_P(
   Convolution2D, LayerGoldenTest,
   ::testing::Values(conv2d_sb_minimum, conv2d_mb_minimum, conv2d_sb_same_remain,
@@ -148,4 +185,127 @@ INSTANTIATE_TEST_CASE_P(
                     conv2d_mb_same_uneven_remain_2, conv2d_sb_valid_drop_last,
                     conv2d_mb_valid_drop_last, conv2d_sb_no_overlap,
                     conv2d_mb_no_overlap, conv2d_sb_1x1_kernel,
-                    conv2d_mb_1x1_kernel));
+                    conv2d_mb_1x1_kernel, conv2d_mb_minimum_im2col_batch,
+                    conv2d_mb_same_uneven_remain_im2col_batch,
+                    conv2d_mb_valid_drop_last_im2col_batch));
+
+/**
+ * @brief reference convolution of a single sample to verify the kernels
+ */
+static std::vector<float> refConv2D(const std::vector<float> &in,
+                                    unsigned int channels, unsigned int height,
+                                    unsigned int width,
+                                    const std::vector<float> &filter,
+                                    unsigned int filters,
+                                    const std::array<unsigned int, 4> &padding,
+                                    const std::array<unsigned int, 2> &stride,
+                                    unsigned int out_height,
+                                    unsigned int out_width,
+                                    const std::array<unsigned int, 2>
+                                      &dilation = {1, 1}) {
+  std::vector<float> out(filters * out_height * out_width, 0.0f);
+  for (unsigned int k = 0; k < filters; ++k)
+    for (unsigned int oh = 0; oh < out_height; ++oh)
+      for (unsigned int ow = 0; ow < out_width; ++ow) {
+        float sum = 0.0f;
+        for (unsigned int c = 0; c < channels; ++c)
+          for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) {
+              int h = oh * stride[0] + i * dilation[0] - padding[0];
+              int w = ow * stride[1] + j * dilation[1] - padding[2];
+              if (h < 0 || h >= (int)height || w < 0 || w >= (int)width)
+                continue;
+              sum += in[(c * height + h) * width + w] *
+                     filter[((k * channels + c) * 3 + i) * 3 + j];
+            }
+        out[(k * out_height + oh) * out_width + ow] = sum;
+      }
+  return out;
+}
+
+/**
+ * @brief Conv2D kernels, algorithm selection
+ */
+TEST(Conv2DKernels, selectAlgorithm_p) {
+  using nntrainer::ConvAlgorithm;
+  EXPECT_EQ(nntrainer::selectConvAlgorithm({3, 3}, {1, 1}, {1, 1}),
+            ConvAlgorithm::WINOGRAD);
+  EXPECT_EQ(nntrainer::selectConvAlgorithm({3, 3}, {2, 2}, {1, 1}),
+            ConvAlgorithm::DIRECT);
+  EXPECT_EQ(nntrainer::selectConvAlgorithm({3, 3}, {1, 1}, {2, 2}),
+            ConvAlgorithm::DIRECT);
+  EXPECT_EQ(nntrainer::selectConvAlgorithm({1, 1}, {1, 1}, {1, 1}),
+            ConvAlgorithm::IM2COL);
+}
+
+/**
+ * @brief Conv2D kernels, winograd against the reference
+ */
+TEST(Conv2DKernels, winograd_p) {
+  const unsigned int C = 3, H = 9, W = 7, K = 5;
+  const std::array<unsigned int, 4> padding = {1, 0, 1, 1};
+  const unsigned int OH = H + padding[0] + padding[1] - 2;
+  const unsigned int OW = W + padding[2] + padding[3] - 2;
+  const unsigned int TH = (OH + 1) / 2, TW = (OW + 1) / 2;
+
+  std::vector<float> in(C * H * W), filter(K * C * 9);
+  for (unsigned int i = 0; i < in.size(); ++i)
+    in[i] = (i % 13) * 0.1f - 0.6f;
+  for (unsigned int i = 0; i < filter.size(); ++i)
+    filter[i] = (i % 7) * 0.2f - 0.5f;
+
+  std::vector<float> u(16 * K * C), v(16 * C * TH * TW), m(16 * K * TH * TW);
+  std::vector<float> out(K * OH * OW);
+  nntrainer::winogradTransformFilter(filter.data(), K, C, u.data());
+  nntrainer::winogradTransformInput(in.data(), C, H, W, padding[0], padding[2],
+                                    TH, TW, v.data());
+  for (unsigned int e = 0; e < 16; ++e)
+    for (unsigned int k = 0; k < K; ++k)
+      for (unsigned int p = 0; p < TH * TW; ++p) {
+        float sum = 0.0f;
+        for (unsigned int c = 0; c < C; ++c)
+          sum += u[(e * K + k) * C + c] * v[(e * C + c) * TH * TW + p];
+        m[(e * K + k) * TH * TW + p] = sum;
+      }
+  nntrainer::winogradTransformOutput(m.data(), K, TH, TW, OH, OW, out.data());
+
+  auto ref = refConv2D(in, C, H, W, filter, K, padding, {1, 1}, OH, OW);
+  for (unsigned int i = 0; i < ref.size(); ++i)
+    EXPECT_NEAR(out[i], ref[i], 1e-4);
+}
+
+/**
+ * @brief Conv2D kernels, direct convolution against the reference
+ */
+TEST(Conv2DKernels, direct_p) {
+  const unsigned int C = 2, H = 8, W = 9, K = 6;
+  const std::array<unsigned int, 4> padding = {1, 1, 0, 1};
+
+  std::vector<float> in(C * H * W), filter(K * C * 9);
+  for (unsigned int i = 0; i < in.size(); ++i)
+    in[i] = (i % 11) * 0.1f - 0.5f;
+  for (unsigned int i = 0; i < filter.size(); ++i)
+    filter[i] = (i % 5) * 0.3f - 0.6f;
+
+  using Array2 = std::array<unsigned int, 2>;
+  for (auto [stride, dilation] : {std::make_pair(Array2{2, 3}, Array2{1, 1}),
+                                  std::make_pair(Array2{1, 1}, Array2{2, 3}),
+                                  std::make_pair(Array2{2, 2}, Array2{2, 1})}) {
+    const unsigned int OH =
+      (H + padding[0] + padding[1] - 2 * dilation[0] - 1) / stride[0] + 1;
+    const unsigned int OW =
+      (W + padding[2] + padding[3] - 2 * dilation[1] - 1) / stride[1] + 1;
+
+    std::vector<float> out(K * OH * OW);
+    std::vector<float> scratch(
+      nntrainer::directConv2DScratchSize(C, H, W, padding, stride));
+    nntrainer::directConv2D(in.data(), C, H, W, filter.data(), K, 3, 3, padding,
+                            stride, dilation, OH, OW, scratch.data(),
+                            out.data());
+
+    auto ref =
+      refConv2D(in, C, H, W, filter, K, padding, stride, OH, OW, dilation);
+    for (unsigned int i = 0; i < ref.size(); ++i)
+      EXPECT_NEAR(out[i], ref[i], 1e-5);
+  }
+}
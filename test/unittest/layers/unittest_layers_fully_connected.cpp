@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 
 #include <fc_layer.h>
+#include <int8_kernels.h>
 #include <layers_common_tests.h>
 
 auto semantic_fc = LayerSemanticsParamType(
@@ -35,3 +36,119 @@ auto fc_basic_single_batch = LayerGoldenTestParamType(
 INSTANTIATE_TEST_CASE_P(FullyConnected, LayerGoldenTest,
                         ::testing::Values(fc_basic_plain,
                                           fc_basic_single_batch));
+
+/**
+ * @brief Int8 kernels, each channel is quantized with its own scale
+ */
+TEST(Int8Kernels, quantizePerChannel_p) {
+  std::vector<float> w = {0.5f, -1.0f, 0.25f, 0.0f, 0.0f, 0.0f,
+                          2.0f, 1.0f,  -0.5f};
+  std::vector<int8_t> q(w.size());
+  std::vector<float> scales(3);
+  nntrainer::quantizePerChannel(w.data(), 3, 3, q.data(), scales.data());
+
+  EXPECT_FLOAT_EQ(scales[0], 1.0f / 127.0f);
+  EXPECT_FLOAT_EQ(scales[1], 0.0f);
+  EXPECT_FLOAT_EQ(scales[2], 2.0f / 127.0f);
+  EXPECT_EQ(q[1], -127);
+  EXPECT_EQ(q[3], 0);
+  EXPECT_EQ(q[6], 127);
+  for (unsigned int i = 0; i < w.size(); ++i)
+    EXPECT_NEAR(q[i] * scales[i / 3], w[i], scales[i / 3] / 2 + 1e-7);
+}
+
+/**
+ * @brief Int8 kernels, values out of the range are saturated
+ */
+TEST(Int8Kernels, quantizeSymmetricSaturate_p) {
+  std::vector<float> x = {-3.0f, -1.0f, 0.0f, 0.5f, 3.0f};
+  std::vector<int8_t> q(x.size());
+  nntrainer::quantizeSymmetric(x.data(), x.size(), 1.0f / 127.0f, q.data());
+
+  std::vector<int8_t> expected = {-127, -127, 0, 64, 127};
+  EXPECT_EQ(q, expected);
+}
+
+/**
+ * @brief Int8 kernels, the micro kernel accumulates exactly in int32
+ */
+TEST(Int8Kernels, int8GemmNTExact_p) {
+  const unsigned int M = 2, N = 7, K = 37;
+  std::vector<int8_t> a(M * K), b(N * K);
+  for (unsigned int i = 0; i < a.size(); ++i)
+    a[i] = static_cast<int8_t>(127 - (i * 7) % 255);
+  for (unsigned int i = 0; i < b.size(); ++i)
+    b[i] = static_cast<int8_t>((i * 11) % 255 - 127);
+
+  std::vector<float> c(M * N);
+  nntrainer::int8GemmNT(M, N, K, a.data(), b.data(), 1.0f, nullptr, nullptr,
+                        c.data(), N);
+
+  for (unsigned int m = 0; m < M; ++m)
+    for (unsigned int n = 0; n < N; ++n) {
+      int32_t ref = 0;
+      for (unsigned int k = 0; k < K; ++k)
+        ref += a[m * K + k] * b[n * K + k];
+      EXPECT_EQ(c[m * N + n], static_cast<float>(ref));
+    }
+}
+
+/**
+ * @brief Int8 kernels, weight is packed in the buffer of its fp32 weight
+ */
+TEST(Int8Kernels, packInt8PerChannel_p) {
+  /// weight of [cols, rows], each channel is a column
+  const unsigned int rows = 2, cols = 3;
+  std::vector<float> w = {1.0f, -2.0f, 0.5f, 1.0f, -1.0f, 2.0f};
+  ASSERT_TRUE(nntrainer::canPackInt8(rows, cols));
+  nntrainer::packInt8PerChannel(w.data(), rows, cols, true, 0.25f);
+
+  auto packed = nntrainer::getInt8PackedWeight(w.data(), rows, cols);
+  EXPECT_FLOAT_EQ(*packed.input_scale, 0.25f);
+  EXPECT_FLOAT_EQ(packed.scales[0], 1.0f / 127.0f);
+  EXPECT_FLOAT_EQ(packed.scales[1], 2.0f / 127.0f);
+
+  std::vector<int8_t> data(packed.data, packed.data + rows * cols);
+  std::vector<int8_t> expected = {127, 64, -127, -127, 64, 127};
+  EXPECT_EQ(data, expected);
+}
+
+/**
+ * @brief Int8 kernels, weight of a single column does not fit
+ */
+TEST(Int8Kernels, packInt8PerChannel_n) {
+  std::vector<float> w(4, 1.0f);
+  EXPECT_FALSE(nntrainer::canPackInt8(4, 1));
+  EXPECT_THROW(nntrainer::packInt8PerChannel(w.data(), 4, 1, false, 1.0f),
+               std::invalid_argument);
+}
+
+/**
+ * @brief Int8 kernels, GEMM against the fp32 reference
+ */
+TEST(Int8Kernels, int8GemmNT_p) {
+  const unsigned int M = 3, N = 70, K = 33;
+  std::vector<float> a(M * K), b(N * K);
+  for (unsigned int i = 0; i < a.size(); ++i)
+    a[i] = (i % 17) * 0.1f - 0.8f;
+  for (unsigned int i = 0; i < b.size(); ++i)
+    b[i] = (i % 13) * 0.05f - 0.3f;
+
+  std::vector<int8_t> qa(a.size()), qb(b.size());
+  float a_scale = nntrainer::getInt8Scale(0.8f);
+  nntrainer::quantizeSymmetric(a.data(), a.size(), a_scale, qa.data());
+  std::vector<float> b_scales(N);
+  nntrainer::quantizePerChannel(b.data(), N, K, qb.data(), b_scales.data());
+
+  std::vector<float> c(M * N);
+  nntrainer::int8GemmNT(M, N, K, qa.data(), qb.data(), a_scale, nullptr,
+                        b_scales.data(), c.data(), N, 2);
+
+  for (unsigned int m = 0; m < M; ++m)
+    for (unsigned int n = 0; n < N; ++n) {
+      float ref = 0.0f;
+      for (unsigned int k = 0; k < K; ++k)
+        ref += a[m * K + k] * b[n * K + k];
+      EXPECT_NEAR(c[m * N + n], ref, 0.05f);
+    }
+}
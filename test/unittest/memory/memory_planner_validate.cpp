@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 
 #include <basic_planner.h>
+#include <best_fit_planner.h>
 #include <memory_planner_validate.h>
 #include <optimized_v1_planner.h>
 
@@ -31,6 +32,8 @@ void MemoryPlannerValidate::SetUp() {
     planner = std::make_unique<nntrainer::BasicPlanner>();
   else if (plan_type == nntrainer::OptimizedV1Planner::type)
     planner = std::make_unique<nntrainer::OptimizedV1Planner>();
+  else if (plan_type == nntrainer::BestFitPlanner::type)
+    planner = std::make_unique<nntrainer::BestFitPlanner>();
   else
     throw std::invalid_argument("Invalid planner type");
 }
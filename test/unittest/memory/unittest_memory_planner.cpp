@@ -15,6 +15,8 @@
 #include <memory_planner_validate.h>
 
 #include <basic_planner.h>
+#include <best_fit_planner.h>
+#include <memory_pool.h>
 #include <optimized_v1_planner.h>
 
 INSTANTIATE_TEST_CASE_P(BasicPlanner, MemoryPlannerValidate,
@@ -22,3 +24,22 @@ INSTANTIATE_TEST_CASE_P(BasicPlanner, MemoryPlannerValidate,
 
 INSTANTIATE_TEST_CASE_P(OptimizedV1Planner, MemoryPlannerValidate,
                         ::testing::Values(nntrainer::OptimizedV1Planner::type));
+
+INSTANTIATE_TEST_CASE_P(BestFitPlanner, MemoryPlannerValidate,
+                        ::testing::Values(nntrainer::BestFitPlanner::type));
+
+/**
+ * @brief Best fit planner reuses a freed memory larger than the request
+ */
+TEST(BestFitPlanner, reuse_larger_memory_p) {
+  nntrainer::MemoryPool pool;
+  pool.requestMemory(10, 0, 1);
+  pool.requestMemory(20, 0, 3);
+  pool.requestMemory(6, 1, 2);
+
+  EXPECT_LT(pool.planLayout(nntrainer::OptimizedV1Planner()), 1.0);
+  EXPECT_EQ(pool.size(), 36u);
+
+  EXPECT_DOUBLE_EQ(pool.planLayout(nntrainer::BestFitPlanner()), 1.0);
+  EXPECT_EQ(pool.size(), 30u);
+}
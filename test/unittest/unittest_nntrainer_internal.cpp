@@ -24,9 +24,13 @@
 
 #include <fstream>
 
+#include <adam.h>
 #include <neuralnet.h>
 #include <nntrainer_error.h>
 #include <optimizer.h>
+#include <optimizer_context.h>
+#include <sgd.h>
+#include <weight.h>
 #include <util_func.h>
 
 #include <nntrainer_test_util.h>
@@ -59,6 +63,176 @@ TEST(nntrainer_Optimizer, setType_03_n) {
     op = ac.createObject<ml::train::Optimizer>("non-existing type", {}));
 }
 
+/**
+ * @brief run a single adam update over a weight of the given dimension
+ */
+static nntrainer::Tensor runAdam(const nntrainer::TensorDim &dim,
+                                 unsigned int num_threads,
+                                 const std::vector<std::string> &props = {}) {
+  nntrainer::Adam adam;
+  adam.setProperty(props);
+
+  nntrainer::Tensor var = ranged(dim.batch(), dim.channel(), dim.height(),
+                                 dim.width())
+                            .multiply(0.01f);
+  nntrainer::Tensor grad = var.apply([](float x) { return std::sin(x); });
+  nntrainer::Tensor m = grad.multiply(0.5f);
+  nntrainer::Tensor v = grad.multiply(grad);
+
+  nntrainer::Weight w(var, grad, "w");
+  w.setOptimizerVariables({&m, &v});
+
+  nntrainer::RunOptimizerContext context(&w, 3, num_threads);
+  adam.applyGradient(context);
+
+  return var;
+}
+
+/**
+ * @brief Adam gives the same update over multiple threads
+ */
+TEST(nntrainer_Optimizer, adam_threads_p) {
+  nntrainer::TensorDim dim(1, 1, 300, 1000);
+  EXPECT_EQ(runAdam(dim, 1), runAdam(dim, 4));
+}
+
+/**
+ * @brief Adam decays the weights when weight_decay is set
+ */
+TEST(nntrainer_Optimizer, adam_weight_decay_p) {
+  nntrainer::TensorDim dim(1, 1, 10, 10);
+  nntrainer::Tensor decayed = runAdam(dim, 1, {"weight_decay=0.5"});
+  nntrainer::Tensor expected = runAdam(dim, 1).subtract(
+    ranged(1, 1, 10, 10).multiply(0.01f * 0.001f * 0.5f));
+  EXPECT_EQ(decayed, expected);
+}
+
+/**
+ * @brief make a weight of [1, 1, 6, 4] with a sparse gradient on rows 1 and 4
+ * along with the equivalent dense gradient
+ */
+static nntrainer::Weight makeSparseWeight(nntrainer::Tensor &var,
+                                          nntrainer::Tensor &grad) {
+  var = ranged(1, 1, 6, 4).multiply(0.1f);
+  grad = nntrainer::Tensor(1, 1, 6, 4);
+  grad.setZero();
+
+  nntrainer::Tensor values = ranged(1, 1, 2, 4).multiply(0.5f);
+  std::copy(values.getData(), values.getData() + 4, grad.getAddress(4));
+  std::copy(values.getData() + 4, values.getData() + 8, grad.getAddress(16));
+
+  nntrainer::Weight w(var, nntrainer::Tensor(1, 1, 6, 4), "w");
+  w.setSparseGradient({1, 4}, values);
+  return w;
+}
+
+/**
+ * @brief SGD applies the sparse gradient the same as the dense gradient
+ */
+TEST(nntrainer_Optimizer, sgd_sparse_gradient_p) {
+  nntrainer::Tensor var, grad;
+  nntrainer::Weight sparse = makeSparseWeight(var, grad);
+  nntrainer::Tensor dense_var = var.clone();
+  nntrainer::Weight dense(dense_var, grad, "dense");
+
+  nntrainer::SGD sgd;
+  sgd.setProperty({"learning_rate=0.1"});
+  nntrainer::RunOptimizerContext sparse_context(&sparse, 0);
+  nntrainer::RunOptimizerContext dense_context(&dense, 0);
+  sgd.applyGradient(sparse_context);
+  sgd.applyGradient(dense_context);
+
+  EXPECT_EQ(var, dense_var);
+}
+
+/**
+ * @brief Adam updates only the rows of the sparse gradient
+ */
+TEST(nntrainer_Optimizer, adam_sparse_gradient_p) {
+  nntrainer::Tensor var, grad;
+  nntrainer::Weight sparse = makeSparseWeight(var, grad);
+  nntrainer::Tensor dense_var = var.clone();
+  nntrainer::Weight dense(dense_var, grad, "dense");
+
+  /** zero moments keep the rows without the gradient intact with dense adam */
+  nntrainer::Tensor m(1, 1, 6, 4), v(1, 1, 6, 4);
+  nntrainer::Tensor dense_m(1, 1, 6, 4), dense_v(1, 1, 6, 4);
+  m.setZero();
+  v.setZero();
+  dense_m.setZero();
+  dense_v.setZero();
+  sparse.setOptimizerVariables({&m, &v});
+  dense.setOptimizerVariables({&dense_m, &dense_v});
+
+  nntrainer::Adam adam;
+  nntrainer::RunOptimizerContext sparse_context(&sparse, 0);
+  nntrainer::RunOptimizerContext dense_context(&dense, 0);
+  adam.applyGradient(sparse_context);
+  adam.applyGradient(dense_context);
+
+  EXPECT_EQ(var, dense_var);
+  EXPECT_EQ(m, dense_m);
+  EXPECT_EQ(v, dense_v);
+}
+
+/**
+ * @brief sparse gradient is written to the dense gradient
+ */
+TEST(nntrainer_Optimizer, densify_sparse_gradient_p) {
+  nntrainer::Tensor var, grad;
+  nntrainer::Weight w = makeSparseWeight(var, grad);
+
+  w.densifyGradient();
+  EXPECT_FALSE(w.hasSparseGradient());
+  EXPECT_EQ(w.getGradientRef(), grad);
+}
+
+/**
+ * @brief sparse gradient kept at the front of the dense gradient is written
+ * to its rows
+ */
+TEST(nntrainer_Optimizer, densify_sparse_gradient_in_place_p) {
+  nntrainer::Tensor var = ranged(1, 1, 6, 4);
+  nntrainer::Tensor grad(1, 1, 6, 4);
+  grad.setZero();
+  nntrainer::Tensor values = ranged(1, 1, 2, 4);
+  std::copy(values.getData(), values.getData() + 8, grad.getData());
+
+  nntrainer::Weight w(var, grad, "w");
+  w.setSparseGradient(
+    {3, 0}, grad.getSharedDataTensor(nntrainer::TensorDim(1, 1, 2, 4), 0));
+  w.densifyGradient();
+
+  nntrainer::Tensor expected(1, 1, 6, 4);
+  expected.setZero();
+  std::copy(values.getData(), values.getData() + 4, expected.getAddress(12));
+  std::copy(values.getData() + 4, values.getData() + 8, expected.getData());
+  EXPECT_EQ(grad, expected);
+}
+
+/**
+ * @brief sparse gradient is cleared once applied
+ */
+TEST(nntrainer_Optimizer, clear_sparse_gradient_p) {
+  nntrainer::Tensor var, grad;
+  nntrainer::Weight w = makeSparseWeight(var, grad);
+
+  w.clearSparseGradient();
+  EXPECT_FALSE(w.hasSparseGradient());
+  EXPECT_TRUE(w.getSparseGradientRows().empty());
+}
+
+/**
+ * @brief sparse gradient out of the rows of the variable
+ */
+TEST(nntrainer_Optimizer, sparse_gradient_out_of_range_n) {
+  nntrainer::Tensor var, grad;
+  nntrainer::Weight w = makeSparseWeight(var, grad);
+
+  EXPECT_THROW(w.setSparseGradient({1, 6}, ranged(1, 1, 2, 4)),
+               std::out_of_range);
+}
+
 TEST(nntrainer_throw_if, throw_invalid_arg_p) {
   try {
     NNTR_THROW_IF(1 == 1, std::invalid_argument) << "error msg";
@@ -157,6 +157,73 @@ TEST_F(nntrainer_LazyTensorOpsTest, LazyTensorOps_08_p) {
   EXPECT_TRUE(target.chain().sum(3).run() == expected);
 }
 
+// add_product_i(), pow_i(), sqrt_i()
+TEST_F(nntrainer_LazyTensorOpsTest, LazyTensorOps_09_p) {
+  expected = original.add(original.multiply(original), 0.5);
+  EXPECT_TRUE(target.chain().add_product_i(original, original, 0.5).run() ==
+              expected);
+
+  expected = original.pow(2.0f).add(1.0f);
+  EXPECT_TRUE(target.chain().pow_i(2.0f).add_i(1.0f).run() == expected);
+
+  expected = original.apply(nntrainer::sqrtFloat).divide(2.0f);
+  EXPECT_TRUE(target.chain().sqrt_i().divide_i(2.0f).run() == expected);
+}
+
+// fused ops with broadcasting
+TEST_F(nntrainer_LazyTensorOpsTest, LazyTensorOps_10_p) {
+  nntrainer::Tensor height_wise = ranged(1, 1, 2, 1);
+  nntrainer::Tensor batch_wise = ranged(3, 1, 1, 1);
+  nntrainer::Tensor full = ranged(3, 1, 2, 10);
+
+  expected = original.multiply(height_wise).add(batch_wise).subtract(full);
+  EXPECT_TRUE(target.chain()
+                .multiply_i(height_wise)
+                .add_i(batch_wise)
+                .subtract_i(full)
+                .run() == expected);
+}
+
+// element-wise ops before and after an op creating a new tensor
+TEST_F(nntrainer_LazyTensorOpsTest, LazyTensorOps_11_p) {
+  expected = original.add(1.0f).sum(3).multiply(2.0f);
+  EXPECT_TRUE(
+    target.chain().add_i(1.0f).sum(3).multiply_i(2.0f).run() == expected);
+}
+
+// run() to a given output and in place
+TEST_F(nntrainer_LazyTensorOpsTest, LazyTensorOps_12_p) {
+  nntrainer::Tensor output(target.getDim());
+  expected = original.multiply(3.0f).add(original);
+
+  target.chain().multiply_i(3.0f).add_i(original).run(output);
+  EXPECT_EQ(output, expected);
+  EXPECT_EQ(target, original);
+
+  target.chain().multiply_i(3.0f).add_i(original).run(target);
+  EXPECT_EQ(target, expected);
+}
+
+// run() to an output of a different dimension
+TEST_F(nntrainer_LazyTensorOpsTest, LazyTensorOps_12_n) {
+  nntrainer::Tensor output(1, 1, 1, 1);
+  EXPECT_THROW(target.chain().add_i(1.0f).run(output), std::invalid_argument);
+}
+
+// the source is read at run(), not when the chain is made
+TEST_F(nntrainer_LazyTensorOpsTest, LazyTensorOps_13_p) {
+  nntrainer::LazyTensor chain = target.chain().add_i(1.0f);
+  target.add_i(2.0f);
+
+  expected = original.add(3.0f);
+  EXPECT_EQ(chain.run(), expected);
+}
+
+// divide by zero
+TEST_F(nntrainer_LazyTensorOpsTest, LazyTensorOps_13_n) {
+  EXPECT_THROW(target.chain().divide_i(0.0f).run(), std::runtime_error);
+}
+
 /**
  * @brief Main gtest
  */
@@ -463,6 +463,15 @@ INI preprocess_translate(
 
 INI mnist_conv_cross_one_input = INI("mnist_conv_cross_one_input") + mnist_conv_cross + "model/batch_size=1";
 
+INI conv_basic__threads =
+  INI("conv_basic__threads") + conv_basic + "model/num_threads=2";
+
+INI mnist_conv_cross__threads =
+  INI("mnist_conv_cross__threads") + mnist_conv_cross + "model/num_threads=3";
+
+INI conv_basic__im2col_batch =
+  INI("conv_basic__im2col_batch") + conv_basic + "conv2d_c1/im2col_batch=2";
+
 INI fc_softmax_mse_distribute(
   "fc_softmax_mse_distribute",
   {
@@ -856,6 +865,8 @@ INSTANTIATE_TEST_CASE_P(
       mkModelIniTc(conv_bn, "3:1:1:10", 10, ModelTestOption::ALL),
       mkModelIniTc(conv_same_padding_multi_stride, "3:1:1:10", 10, ModelTestOption::ALL),
       mkModelIniTc(conv_no_loss, "3:1:1:10", 1, ModelTestOption::NO_THROW_RUN),
+      mkModelIniTc(conv_basic__threads, "3:1:1:10", 10, ModelTestOption::ALL),
+      mkModelIniTc(conv_basic__im2col_batch, "3:1:1:10", 10, ModelTestOption::ALL),
 
       /**< single pooling layer test */
       mkModelIniTc(pooling_max_same_padding, "3:1:1:10", 10, ModelTestOption::ALL),
@@ -870,6 +881,7 @@ INSTANTIATE_TEST_CASE_P(
       /**< conv pool combined tests */
       mkModelIniTc(mnist_conv_cross, "3:1:1:10", 10, ModelTestOption::ALL),
       mkModelIniTc(mnist_conv_cross_one_input, "1:1:1:10", 10, ModelTestOption::ALL),
+      mkModelIniTc(mnist_conv_cross__threads, "3:1:1:10", 10, ModelTestOption::ALL),
 
       /**< augmentation layer */
   #if defined(ENABLE_DATA_AUGMENTATION_OPENCV)
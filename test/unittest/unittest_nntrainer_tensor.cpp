@@ -13,7 +13,9 @@
 
 #include "nntrainer_test_util.h"
 #include "util_func.h"
+#include <cmath>
 #include <fstream>
+#include <half_precision.h>
 #include <nntrainer_error.h>
 #include <tensor.h>
 #include <tensor_dim.h>
@@ -2454,6 +2456,59 @@ TEST(nntrainer_Tensor, dot_shortcuts_p) {
   }
 }
 
+TEST(nntrainer_Tensor, dot_large_p) {
+  /// shapes cross the blocking and the register tiles of the blas kernels
+  const unsigned int M = 37, K = 300, N = 53;
+
+  for (bool trans : {false, true}) {
+    for (bool trans_m : {false, true}) {
+      nntrainer::Tensor a(1, 1, trans ? K : M, trans ? M : K);
+      nntrainer::Tensor b(1, 1, trans_m ? N : K, trans_m ? K : N);
+      a.setRandUniform(-1.0f, 1.0f);
+      b.setRandUniform(-1.0f, 1.0f);
+
+      nntrainer::Tensor ret(1, 1, M, N);
+      ret.setValue(1.0f);
+      a.dot(b, ret, trans, trans_m, 0.5f);
+
+      for (unsigned int m = 0; m < M; ++m) {
+        for (unsigned int n = 0; n < N; ++n) {
+          double expected = 0.5;
+          for (unsigned int k = 0; k < K; ++k) {
+            float a_val =
+              trans ? a.getValue(0, 0, k, m) : a.getValue(0, 0, m, k);
+            float b_val =
+              trans_m ? b.getValue(0, 0, n, k) : b.getValue(0, 0, k, n);
+            expected += a_val * b_val;
+          }
+          EXPECT_NEAR(ret.getValue(0, 0, m, n), expected, 1e-3);
+        }
+      }
+    }
+  }
+}
+
+TEST(nntrainer_Tensor, dot_large_vector_p) {
+  const unsigned int M = 67, K = 301;
+
+  for (bool trans : {false, true}) {
+    nntrainer::Tensor a(1, 1, trans ? K : M, trans ? M : K);
+    nntrainer::Tensor x(1, 1, K, 1);
+    a.setRandUniform(-1.0f, 1.0f);
+    x.setRandUniform(-1.0f, 1.0f);
+
+    nntrainer::Tensor ret = a.dot(x, trans, false);
+
+    for (unsigned int m = 0; m < M; ++m) {
+      double expected = 0.0;
+      for (unsigned int k = 0; k < K; ++k)
+        expected += (trans ? a.getValue(0, 0, k, m) : a.getValue(0, 0, m, k)) *
+                    x.getValue(0, 0, k, 0);
+      EXPECT_NEAR(ret.getValue(0, 0, m, 0), expected, 1e-3);
+    }
+  }
+}
+
 TEST(nntrainer_Tensor, transpose_p) {
   nntrainer::TensorDim ref_dim(3, 2, 4, 5);
 
@@ -3054,6 +3109,108 @@ TEST(nntrainer_Tensor, initialize_08_p) {
   EXPECT_EQ(golden, t);
 }
 
+TEST(nntrainer_Tensor, fp16_conversion_01_p) {
+  EXPECT_EQ(nntrainer::fp32ToFp16(1.0f), 0x3c00);
+  EXPECT_EQ(nntrainer::fp32ToFp16(-2.0f), 0xc000);
+  EXPECT_EQ(nntrainer::fp32ToFp16(65504.0f), 0x7bff);
+  EXPECT_EQ(nntrainer::fp32ToFp16(0.0f), 0x0000);
+
+  /// 1 + 2^-11 is a tie, rounded to the even mantissa
+  EXPECT_EQ(nntrainer::fp32ToFp16(1.00048828125f), 0x3c00);
+  /// 1 + 3 * 2^-11 is a tie, rounded up to the even mantissa
+  EXPECT_EQ(nntrainer::fp32ToFp16(1.00146484375f), 0x3c02);
+
+  /// smallest subnormal
+  EXPECT_EQ(nntrainer::fp32ToFp16(5.9604644775390625e-08f), 0x0001);
+  EXPECT_FLOAT_EQ(nntrainer::fp16ToFp32(0x0001), 5.9604644775390625e-08f);
+
+  for (float val : {0.5f, -3.25f, 1024.0f, 0.0009765625f})
+    EXPECT_EQ(nntrainer::fp16ToFp32(nntrainer::fp32ToFp16(val)), val);
+}
+
+TEST(nntrainer_Tensor, fp16_conversion_02_n) {
+  EXPECT_EQ(nntrainer::fp32ToFp16(65520.0f), 0x7c00);
+  EXPECT_EQ(nntrainer::fp32ToFp16(-1e10f), 0xfc00);
+  EXPECT_TRUE(std::isinf(nntrainer::fp16ToFp32(0x7c00)));
+  EXPECT_TRUE(std::isnan(nntrainer::fp16ToFp32(nntrainer::fp32ToFp16(NAN))));
+}
+
+TEST(nntrainer_Tensor, bf16_conversion_01_p) {
+  EXPECT_EQ(nntrainer::fp32ToBf16(1.0f), 0x3f80);
+  EXPECT_EQ(nntrainer::bf16ToFp32(0x3f80), 1.0f);
+
+  /// 1 + 2^-8 is a tie, rounded to the even mantissa
+  EXPECT_EQ(nntrainer::fp32ToBf16(1.00390625f), 0x3f80);
+  /// 1 + 3 * 2^-8 is a tie, rounded up to the even mantissa
+  EXPECT_EQ(nntrainer::fp32ToBf16(1.01171875f), 0x3f82);
+
+  EXPECT_TRUE(std::isnan(nntrainer::bf16ToFp32(nntrainer::fp32ToBf16(NAN))));
+  EXPECT_TRUE(
+    std::isinf(nntrainer::bf16ToFp32(nntrainer::fp32ToBf16(INFINITY))));
+}
+
+TEST(nntrainer_Tensor, half_precision_01_p) {
+  for (auto type : {nntrainer::Tensor::DataType::FP16,
+                    nntrainer::Tensor::DataType::BF16}) {
+    nntrainer::Tensor half(nntrainer::TensorDim(1, 2, 3, 5), true,
+                           nntrainer::Tensor::Initializer::NONE, "", type);
+    EXPECT_EQ(half.getDataType(), type);
+    EXPECT_EQ(half.bytes(), half.size() * sizeof(uint16_t));
+
+    nntrainer::Tensor golden(1, 2, 3, 5);
+    for (unsigned int i = 0; i < golden.size(); ++i)
+      golden.getData()[i] = static_cast<float>(i) - 7.5f;
+
+    half.copyData(golden);
+    nntrainer::Tensor result(1, 2, 3, 5);
+    result.copyData(half);
+    EXPECT_EQ(golden, result);
+    EXPECT_FLOAT_EQ(half.getValue(0, 1, 2, 4), golden.getValue(0, 1, 2, 4));
+
+    half.setZero();
+    result.copyData(half);
+    EXPECT_EQ(result.l2norm(), 0.0f);
+
+    half.setValue(2.0f);
+    result.copyData(half);
+    golden.setValue(2.0f);
+    EXPECT_EQ(golden, result);
+
+    half.setValue(0, 0, 1, 1, -3.0f);
+    EXPECT_FLOAT_EQ(half.getValue(0, 0, 1, 1), -3.0f);
+  }
+}
+
+TEST(nntrainer_Tensor, half_precision_02_p) {
+  nntrainer::Tensor half(nntrainer::TensorDim(1, 1, 4, 4), true,
+                         nntrainer::Tensor::Initializer::ONES, "",
+                         nntrainer::Tensor::DataType::FP16);
+  nntrainer::Tensor result(1, 1, 4, 4);
+  result.copyData(half);
+
+  nntrainer::Tensor golden(1, 1, 4, 4);
+  golden.setValue(1.0f);
+  EXPECT_EQ(golden, result);
+
+  /// reshaping and copying keep the data type
+  half.reshape({1, 1, 2, 8});
+  EXPECT_EQ(half.getDataType(), nntrainer::Tensor::DataType::FP16);
+  EXPECT_EQ(half.clone().getDataType(), nntrainer::Tensor::DataType::FP16);
+}
+
+TEST(nntrainer_Tensor, half_precision_03_n) {
+  nntrainer::Tensor half(nntrainer::TensorDim(1, 1, 2, 2), true,
+                         nntrainer::Tensor::Initializer::ONES, "",
+                         nntrainer::Tensor::DataType::BF16);
+  nntrainer::Tensor fp32(1, 1, 2, 2);
+
+  EXPECT_EQ(half.add_i(fp32), ML_ERROR_INVALID_PARAMETER);
+  EXPECT_EQ(fp32.multiply_i(half), ML_ERROR_INVALID_PARAMETER);
+  EXPECT_THROW(half.dot(fp32), std::invalid_argument);
+  EXPECT_THROW(half.sum(0), std::invalid_argument);
+  EXPECT_THROW(half.apply([](float x) { return x; }), std::invalid_argument);
+}
+
 int main(int argc, char **argv) {
   int result = -1;
 
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 
 #include <basic_planner.h>
+#include <optimized_v1_planner.h>
 #include <tensor_pool.h>
 
 constexpr unsigned int MEM_BYTES = 128;
@@ -483,6 +484,23 @@ TEST(TensorPool, view_is_subset_p) {
   pool.deallocate();
 }
 
+TEST(TensorPool, view_of_half_precision_p) {
+  nntrainer::TensorPool pool;
+  // |-------- t1 (fp16) -------|
+  //       |-t2-|
+  auto t1 = pool.request("t1", {10}, {0}, max_ls,
+                         nntrainer::Tensor::Initializer::NONE,
+                         nntrainer::Tensor::DataType::FP16);
+  auto t2 = pool.view("t2", "t1", {3}, {1}, max_ls, 3);
+  pool.finalize(nntrainer::BasicPlanner(), 0, 2);
+  pool.allocate();
+
+  EXPECT_EQ(t1->bytes(), 10 * sizeof(uint16_t));
+  EXPECT_EQ(t2->getDataType(), nntrainer::Tensor::DataType::FP16);
+  EXPECT_EQ(t2->getData<uint16_t>(), t1->getData<uint16_t>() + 3);
+  pool.deallocate();
+}
+
 TEST(TensorPool, view_is_view_of_view_and_subset_p) {
   // |-------- t1-------|
   // |-t2-|(offset)
@@ -669,6 +687,155 @@ TEST(TensorPool, createOrExtend_unmanaged_n) {
     pool.requestOrExtend("t", {10}, {0}, nntrainer::TensorLifespan::UNMANAGED));
 }
 
+TEST(TensorPool, borrow_p) {
+  nntrainer::TensorPool lender, pool;
+  auto src = lender.request("t", {10}, {0}, max_ls);
+  lender.finalize(nntrainer::BasicPlanner(), 0, 1);
+  lender.allocate();
+
+  auto t = pool.request("t", {10}, {0}, max_ls);
+  auto v = pool.view("v", "t", {5}, {0}, max_ls, 5);
+  EXPECT_NO_THROW(pool.borrow(lender));
+
+  EXPECT_EQ(t->getData(), src->getData());
+  EXPECT_EQ(v->getData(), src->getData() + 5);
+  EXPECT_FALSE(pool.isAllocated());
+}
+
+TEST(TensorPool, borrow_not_allocated_n) {
+  nntrainer::TensorPool lender, pool;
+  lender.request("t", {10}, {0}, max_ls);
+  pool.request("t", {10}, {0}, max_ls);
+  EXPECT_THROW(pool.borrow(lender), std::invalid_argument);
+}
+
+TEST(TensorPool, borrow_different_dim_n) {
+  nntrainer::TensorPool lender, pool;
+  lender.request("t", {10}, {0}, max_ls);
+  lender.finalize(nntrainer::BasicPlanner(), 0, 1);
+  lender.allocate();
+
+  pool.request("t", {5}, {0}, max_ls);
+  EXPECT_THROW(pool.borrow(lender), std::invalid_argument);
+}
+
+/**
+ * @brief source of a tensor and its views are placed in another tensor
+ */
+TEST(TensorPool, reidentify_source_p) {
+  nntrainer::TensorPool pool;
+  // |-------- t1 -------|
+  //    |-- t2 --|
+  //       |t3|
+  auto t1 = pool.request("t1", {10}, {0}, max_ls);
+  auto t2 = pool.request("t2", {4}, {1}, max_ls);
+  auto t3 = pool.view("t3", "t2", {2}, {2}, max_ls, 2);
+
+  EXPECT_FALSE(pool.canReidentifySource("t3", "t1"));
+  EXPECT_TRUE(pool.canReidentifySource("t2", "t1"));
+  EXPECT_NO_THROW(pool.reidentifySource("t2", "t1", 3));
+  EXPECT_FALSE(pool.canReidentifySource("t2", "t1"));
+
+  pool.finalize(nntrainer::BasicPlanner(), 0, 2);
+  EXPECT_EQ(pool.size(), t1->bytes());
+  pool.allocate();
+
+  EXPECT_EQ(t2->getData(), t1->getData() + 3);
+  EXPECT_EQ(t3->getData(), t1->getData() + 5);
+  pool.deallocate();
+}
+
+/**
+ * @brief source cannot be placed out of the range of the new source
+ */
+TEST(TensorPool, reidentify_source_out_of_range_n) {
+  nntrainer::TensorPool pool;
+  pool.request("t1", {10}, {0}, max_ls);
+  pool.request("t2", {4}, {1}, max_ls);
+  pool.placeholder("t3", {4});
+
+  EXPECT_FALSE(pool.canReidentifySource("t3", "t1"));
+  EXPECT_THROW(pool.reidentifySource("t2", "t1", 7), std::invalid_argument);
+}
+
+/**
+ * @brief a tensor idle for long is swapped out and its memory is reused
+ */
+TEST(TensorPool, swap_p) {
+  nntrainer::TensorPool pool;
+  auto t0 = pool.request("t0", {10}, {0, 20},
+                         nntrainer::TensorLifespan::FORWARD_FUNC_LIFESPAN);
+  auto t1 = pool.request("t1", {10}, {5, 6},
+                         nntrainer::TensorLifespan::FORWARD_FUNC_LIFESPAN);
+  pool.setSwap(".", 2);
+  pool.finalize(nntrainer::BasicPlanner(), 0, 20);
+  EXPECT_EQ(pool.size(), t0->bytes() * 3);
+
+  pool.finalize(nntrainer::OptimizedV1Planner(), 0, 20);
+  EXPECT_EQ(pool.size(), t0->bytes());
+  pool.allocate();
+
+  for (unsigned int iteration = 0; iteration < 2; ++iteration) {
+    pool.resetSwap();
+    pool.swap(0, 0);
+    t0->setValue(iteration + 1.0f);
+    pool.swap(5, 6);
+    t1->setValue(-1.0f);
+    pool.swap(17, 18);
+    pool.swap(19, 20);
+
+    nntrainer::Tensor expected(10);
+    expected.setValue(iteration + 1.0f);
+    EXPECT_EQ(*t0, expected);
+  }
+  pool.deallocate();
+}
+
+/**
+ * @brief a tensor being written out in background is not overwritten by the
+ * tensor reusing its memory in the next steps
+ */
+TEST(TensorPool, swap_overlapped_p) {
+  nntrainer::TensorPool pool;
+  auto t0 = pool.request("t0", {1024}, {0, 20},
+                         nntrainer::TensorLifespan::FORWARD_FUNC_LIFESPAN);
+  auto t1 = pool.request("t1", {1024}, {2, 3},
+                         nntrainer::TensorLifespan::FORWARD_FUNC_LIFESPAN);
+  pool.setSwap(".", 2);
+  pool.finalize(nntrainer::OptimizedV1Planner(), 0, 20);
+  EXPECT_EQ(pool.size(), t0->bytes());
+  pool.allocate();
+
+  pool.resetSwap();
+  pool.swap(0, 0);
+  t0->setValue(1.0f);
+  for (unsigned int order = 1; order <= 20; ++order) {
+    pool.swap(order, order);
+    if (order == 2)
+      t1->setValue(-1.0f);
+  }
+
+  nntrainer::Tensor expected(1024);
+  expected.setValue(1.0f);
+  EXPECT_EQ(*t0, expected);
+  pool.deallocate();
+}
+
+/**
+ * @brief a tensor is not swapped without an idle interval longer than the
+ * lookahead
+ */
+TEST(TensorPool, swap_short_interval_n) {
+  nntrainer::TensorPool pool;
+  pool.request("t0", {10}, {0, 5},
+               nntrainer::TensorLifespan::FORWARD_FUNC_LIFESPAN);
+  pool.request("t1", {10}, {2, 3},
+               nntrainer::TensorLifespan::FORWARD_FUNC_LIFESPAN);
+  pool.setSwap(".", 4);
+  pool.finalize(nntrainer::OptimizedV1Planner(), 0, 5);
+  EXPECT_EQ(pool.size(), 2 * 10 * sizeof(float));
+}
+
 /**
  * @brief Main gtest
  */